@@ -0,0 +1,24 @@
+# Runs COMMAND (a ;-list) and prints its wall clock time with LABEL.
+#
+#   cmake -DLABEL=... -DCOMMAND=... -P TimeCommand.cmake
+
+if (CMAKE_VERSION VERSION_LESS 3.23)
+    set(TIMESTAMP_FORMAT "%s")
+else()
+    set(TIMESTAMP_FORMAT "%s%f")
+endif()
+
+string(TIMESTAMP start "${TIMESTAMP_FORMAT}" UTC)
+execute_process(COMMAND ${COMMAND} RESULT_VARIABLE result)
+string(TIMESTAMP end "${TIMESTAMP_FORMAT}" UTC)
+
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "${LABEL}: command failed (${result})")
+endif()
+
+if (CMAKE_VERSION VERSION_LESS 3.23)
+    math(EXPR elapsed_ms "(${end} - ${start}) * 1000")
+else()
+    math(EXPR elapsed_ms "(${end} - ${start}) / 1000")
+endif()
+message("${LABEL}: ${elapsed_ms} ms")
@@ -0,0 +1,133 @@
+# Generates src/CppUtils/preproc/VariadicMacros.h
+#
+#   cmake [-DCPPUTILS_MAX_ARGS=1024] -P cmake/GenerateVariadicMacros.cmake
+#
+# The MAP families peel arguments off in chunks of CPPUTILS_CHUNK_SIZE, so the
+# header grows linearly with CPPUTILS_MAX_ARGS and a map over n arguments only
+# rescans its argument list n / CPPUTILS_CHUNK_SIZE times.
+
+if (NOT DEFINED CPPUTILS_MAX_ARGS)
+    set(CPPUTILS_MAX_ARGS 1024)
+endif()
+set(CPPUTILS_CHUNK_SIZE 16)
+
+get_filename_component(CPPUTILS_ROOT "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+set(OUTPUT_FILE "${CPPUTILS_ROOT}/src/CppUtils/preproc/VariadicMacros.h")
+
+# Joins _1, ..., _n with commas, wrapping every 10 items.
+function(cpputils_param_list N OUT)
+    set(result "")
+    foreach(i RANGE 1 ${N})
+        if (i GREATER 1)
+            string(APPEND result ",")
+            math(EXPR wrap "(${i} - 1) % 10")
+            if (wrap EQUAL 0)
+                string(APPEND result " \\\n       ")
+            endif()
+            string(APPEND result " ")
+        endif()
+        string(APPEND result "_${i}")
+    endforeach()
+    set(${OUT} "${result}" PARENT_SCOPE)
+endfunction()
+
+# m(_1) SEP_##sep ... m(_n), with an optional leading fixed argument.
+function(cpputils_apply_list N PREFIX OUT)
+    set(result "")
+    foreach(i RANGE 1 ${N})
+        if (i GREATER 1)
+            string(APPEND result " SEP_##sep")
+        endif()
+        string(APPEND result " m(${PREFIX}_${i})")
+    endforeach()
+    set(${OUT} "${result}" PARENT_SCOPE)
+endfunction()
+
+math(EXPR max_quotient "(${CPPUTILS_MAX_ARGS} - 1) / ${CPPUTILS_CHUNK_SIZE}")
+
+set(out "#pragma once\n\n")
+string(APPEND out "// Generated by cmake/GenerateVariadicMacros.cmake, do not edit by hand.\n")
+string(APPEND out "//\n")
+string(APPEND out "// Maps accept between 1 and CPPUTILS_MAX_ARGS arguments.\n\n")
+string(APPEND out "#define CPPUTILS_MAX_ARGS ${CPPUTILS_MAX_ARGS}\n\n")
+string(APPEND out "#define SEP_COMMA ,\n#define SEP_SEMICOLON ;\n\n")
+string(APPEND out "#define CPPUTILS_PREPEND_NAMESPACE(e, x) e::x\n\n")
+
+# ----- CPPUTILS_NARGS
+cpputils_param_list(${CPPUTILS_MAX_ARGS} params)
+set(rseq "")
+foreach(i RANGE ${CPPUTILS_MAX_ARGS} 1 -1)
+    if (NOT i EQUAL CPPUTILS_MAX_ARGS)
+        string(APPEND rseq ",")
+        math(EXPR wrap "(${CPPUTILS_MAX_ARGS} - ${i}) % 10")
+        if (wrap EQUAL 0)
+            string(APPEND rseq " \\\n       ")
+        endif()
+        string(APPEND rseq " ")
+    endif()
+    string(APPEND rseq "${i}")
+endforeach()
+
+string(APPEND out "// CPPUTILS_NARGS need to be defered 1 level\n")
+string(APPEND out "#define CPPUTILS_NARGS(...) CPPUTILS_NARGS_(__VA_ARGS__, CPPUTILS_RSEQ_N())\n")
+string(APPEND out "#define CPPUTILS_NARGS_(...) CPPUTILS_ARGN(__VA_ARGS__)\n")
+string(APPEND out "#define CPPUTILS_ARGN( \\\n        ${params}, N, ...) N\n")
+string(APPEND out "#define CPPUTILS_RSEQ_N() \\\n        ${rseq}\n\n")
+
+# ----- n -> (n - 1) / chunk, n - chunk * ((n - 1) / chunk)
+string(APPEND out "// Splits n into a chunk count q and a remainder r in [1, ${CPPUTILS_CHUNK_SIZE}]\n")
+foreach(i RANGE 1 ${CPPUTILS_MAX_ARGS})
+    math(EXPR q "(${i} - 1) / ${CPPUTILS_CHUNK_SIZE}")
+    math(EXPR r "${i} - ${CPPUTILS_CHUNK_SIZE} * ${q}")
+    string(APPEND out "#define CPPUTILS_DIVMOD_${i} ${q}, ${r}\n")
+endforeach()
+string(APPEND out "\n")
+
+cpputils_param_list(${CPPUTILS_CHUNK_SIZE} chunk_params)
+string(APPEND out "#define CPPUTILS_DROP_CHUNK(${chunk_params}, ...) __VA_ARGS__\n\n")
+
+# ----- CPPUTILS_0_MAP / CPPUTILS_1_MAP
+foreach(family 0 1)
+    if (family EQUAL 0)
+        set(fixed "")
+        set(fixed_arg "")
+    else()
+        set(fixed " a,")
+        set(fixed_arg "a, ")
+    endif()
+    set(P "CPPUTILS_${family}_MAP")
+
+    foreach(i RANGE 1 ${CPPUTILS_CHUNK_SIZE})
+        cpputils_param_list(${i} ps)
+        cpputils_apply_list(${i} "${fixed_arg}" body)
+        string(APPEND out "#define ${P}${i}(sep, m,${fixed} ${ps}) \\\n       ${body}\n")
+    endforeach()
+    string(APPEND out "\n")
+
+    string(APPEND out "#define ${P}_CHUNK(sep, m,${fixed} ${chunk_params}, ...) \\\n       ")
+    cpputils_apply_list(${CPPUTILS_CHUNK_SIZE} "${fixed_arg}" body)
+    string(APPEND out "${body}\n\n")
+
+    string(APPEND out "#define ${P}Q0(r, sep, m,${fixed} ...) ${P}_R(r, sep, m,${fixed} __VA_ARGS__)\n")
+    foreach(q RANGE 1 ${max_quotient})
+        math(EXPR prev "${q} - 1")
+        string(APPEND out "#define ${P}Q${q}(r, sep, m,${fixed} ...) ${P}_CHUNK(sep, m,${fixed} __VA_ARGS__) SEP_##sep ${P}Q${prev}(r, sep, m,${fixed} CPPUTILS_DROP_CHUNK(__VA_ARGS__))\n")
+    endforeach()
+    string(APPEND out "#define ${P}_R(r, sep, m,${fixed} ...) ${P}##r(sep, m,${fixed} __VA_ARGS__)\n\n")
+
+    string(APPEND out "#define ${P}(n, sep, m,${fixed} ...) ${P}_QR(CPPUTILS_DIVMOD_##n, sep, m,${fixed} __VA_ARGS__)\n")
+    string(APPEND out "#define ${P}_QR(qr, ...) ${P}_QR_(qr, __VA_ARGS__)\n")
+    string(APPEND out "#define ${P}_QR_(q, r, sep, m,${fixed} ...) ${P}Q##q(r, sep, m,${fixed} __VA_ARGS__)\n\n")
+endforeach()
+
+string(APPEND out [=[
+// Need to defer the map call one level to let CPPUTILS_NARGS evaluate
+#define CPPUTILS_DECORATED_0_MAP(sep, decorator,    ...) CPPUTILS_DECORATED_0_MAP_DEFER(CPPUTILS_NARGS(__VA_ARGS__), sep, decorator,    __VA_ARGS__)
+#define CPPUTILS_DECORATED_1_MAP(sep, decorator, a, ...) CPPUTILS_DECORATED_1_MAP_DEFER(CPPUTILS_NARGS(__VA_ARGS__), sep, decorator, a, __VA_ARGS__)
+
+#define CPPUTILS_DECORATED_0_MAP_DEFER(n, sep, decorator,    ...) CPPUTILS_0_MAP(n, sep, decorator,    __VA_ARGS__)
+#define CPPUTILS_DECORATED_1_MAP_DEFER(n, sep, decorator, a, ...) CPPUTILS_1_MAP(n, sep, decorator, a, __VA_ARGS__)
+]=])
+
+file(WRITE "${OUTPUT_FILE}" "${out}")
+message(STATUS "Wrote ${OUTPUT_FILE} (CPPUTILS_MAX_ARGS = ${CPPUTILS_MAX_ARGS})")
@@ -0,0 +1,103 @@
+#include "AsyncIO.h"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+bool would_block(int error) {
+    return error == EAGAIN || error == EWOULDBLOCK;
+}
+
+std::runtime_error io_error(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+}
+
+void set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || (!(flags & O_NONBLOCK) && fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0))
+        throw io_error("Couldn't make descriptor " + std::to_string(fd) + " non-blocking");
+}
+
+Task<size_t> async_var_read(Reactor& reactor, int fd, uint8_t* buffer, size_t N) {
+    while (true) {
+        ssize_t result = ::read(fd, buffer, N);
+        if (result >= 0)
+            co_return static_cast<size_t>(result);
+        if (errno == EINTR)
+            continue;
+        if (!would_block(errno))
+            throw io_error("Error while reading data");
+        co_await reactor.readable(fd);
+    }
+}
+
+Task<void> async_read(Reactor& reactor, int fd, uint8_t* buffer, size_t N) {
+    size_t total = 0;
+    while (total < N) {
+        ssize_t result = ::read(fd, buffer + total, N - total);
+        if (result > 0) {
+            total += static_cast<size_t>(result);
+        } else if (result == 0) {
+            throw std::runtime_error("End of stream while transferring data (incomplete)");
+        } else if (would_block(errno)) {
+            co_await reactor.readable(fd);
+        } else if (errno != EINTR) {
+            throw io_error("Error while reading data");
+        }
+    }
+}
+
+Task<void> async_write(Reactor& reactor, int fd, const uint8_t* buffer, size_t N) {
+    // send keeps a closed peer from raising SIGPIPE; it fails with ENOTSOCK
+    // on pipes and files, which then go through write
+    bool socket = true;
+    size_t total = 0;
+    while (total < N) {
+        ssize_t result = socket
+            ? ::send(fd, buffer + total, N - total, MSG_NOSIGNAL)
+            : ::write(fd, buffer + total, N - total);
+        if (result >= 0) {
+            total += static_cast<size_t>(result);
+        } else if (socket && errno == ENOTSOCK) {
+            socket = false;
+        } else if (would_block(errno)) {
+            co_await reactor.writable(fd);
+        } else if (errno != EINTR) {
+            throw io_error("Error while writing data");
+        }
+    }
+}
+
+Task<void> async_accept(Reactor& reactor, const SocketHandle& server, SocketHandle& client) {
+    const int flags = fcntl(server.fd(), F_GETFL);
+    if (flags < 0 || !(flags & O_NONBLOCK))
+        throw std::runtime_error("async_accept needs a non-blocking server, see set_nonblocking");
+
+    while (true) {
+        int fd = ::accept4(server.fd(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd >= 0) {
+            client.adopt(fd);
+            co_return;
+        }
+        if (errno == EINTR || errno == ECONNABORTED)
+            continue;
+        if (!would_block(errno))
+            throw io_error("Error accepting connection");
+        co_await reactor.readable(server.fd());
+    }
+}
+
+AsyncStream::AsyncStream(Reactor& reactor, int fd)
+    : reactor_(reactor), fd_(fd)
+{
+    set_nonblocking(fd);
+}
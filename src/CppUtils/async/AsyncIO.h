@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Reactor.h"
+#include "Task.h"
+
+#include "CppUtils/container/Span.h"
+#include "CppUtils/networking/Socket.h"
+
+#include <cstdint>
+
+/*
+ * Transfers on non-blocking descriptors, suspending on the reactor whenever
+ * the descriptor isn't ready. Same semantics as the handles' _read / _write /
+ * _var_read: async_read and async_write transfer exactly N bytes, and
+ * async_var_read returns what is available, 0 at the end of the stream.
+ * Writes to a socket whose peer has gone throw instead of raising SIGPIPE.
+ */
+Task<size_t> async_var_read(Reactor& reactor, int fd, uint8_t* buffer, size_t N);
+Task<void> async_read(Reactor& reactor, int fd, uint8_t* buffer, size_t N);
+Task<void> async_write(Reactor& reactor, int fd, const uint8_t* buffer, size_t N);
+
+/*
+ * Accepts the next connection on a listening server into client. The
+ * accepted socket is non-blocking, for use with AsyncStream.
+ *
+ * The server must have been made non-blocking with set_nonblocking first,
+ * else this throws; it isn't switched behind the caller's back, since a
+ * later blocking SocketHandle::accept on it would then fail with EAGAIN.
+ */
+Task<void> async_accept(Reactor& reactor, const SocketHandle& server, SocketHandle& client);
+
+void set_nonblocking(int fd);
+
+/*
+ * Typed asynchronous reads and writes on a handle's descriptor, mirroring
+ * BinaryReader / BinaryWriter, e.g.
+ *
+ *      AsyncStream stream(reactor, socket);
+ *      uint32_t length;
+ *      co_await stream.read(length);
+ *
+ * Works with any handle exposing fd(): SocketHandle, PipeHandle,
+ * DeviceHandle, UnixSocketHandle. The descriptor is switched to non-blocking
+ * mode and stays owned by the handle, which must outlive the stream.
+ * Arguments must stay valid until the returned task is awaited.
+ */
+class AsyncStream {
+public:
+    AsyncStream(Reactor& reactor, int fd);
+
+    template <typename Handle>
+    AsyncStream(Reactor& reactor, Handle& handle)
+        : AsyncStream(reactor, handle.fd())
+    {}
+
+    int fd() const { return fd_; }
+
+    // ----- fixed length read
+
+    template <typename T>
+    Task<void> read(T& t) {
+        return read(&t, 1);
+    }
+
+    template <typename T>
+    Task<void> read(T* buffer, size_t N) {
+        return async_read(reactor_, fd_, reinterpret_cast<uint8_t*>(buffer), sizeof(T) * N);
+    }
+
+    template <typename T>
+    Task<void> read(Span<T> buffer) {
+        return read(buffer.data(), buffer.size());
+    }
+
+    // ----- variable length read, returns the number of bytes read
+
+    template <typename T>
+    Task<size_t> var_read(T* buffer, size_t N) {
+        return async_var_read(reactor_, fd_, reinterpret_cast<uint8_t*>(buffer), sizeof(T) * N);
+    }
+
+    template <typename T>
+    Task<size_t> var_read(Span<T> buffer) {
+        return var_read(buffer.data(), buffer.size());
+    }
+
+    // ----- write
+
+    template <typename T>
+    Task<void> write(const T& t) {
+        return write(&t, 1);
+    }
+
+    template <typename T>
+    Task<void> write(const T* buffer, size_t N) {
+        return async_write(reactor_, fd_, reinterpret_cast<const uint8_t*>(buffer), sizeof(T) * N);
+    }
+
+    template <typename T>
+    Task<void> write(Span<T> buffer) {
+        return write(buffer.data(), buffer.size());
+    }
+
+private:
+    Reactor& reactor_;
+    int fd_;
+};
@@ -0,0 +1,146 @@
+#include "Reactor.h"
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+Reactor::Detached::promise_type::~promise_type() {
+    if (reactor != nullptr)
+        reactor->detached_.erase(std::coroutine_handle<promise_type>::from_promise(*this).address());
+}
+
+Reactor::Reactor()
+    : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)), tasks_(0), stopped_(false)
+{
+    if (epoll_fd_ < 0)
+        throw std::runtime_error("Couldn't create epoll instance: " + std::string(std::strerror(errno)));
+}
+
+Reactor::~Reactor() {
+    // Destroying a task's frame destroys the tasks it awaits
+    std::unordered_set<void*> detached = std::move(detached_);
+    detached_.clear();
+    for (void* frame : detached) {
+        std::coroutine_handle<>::from_address(frame).destroy();
+    }
+    ::close(epoll_fd_);
+}
+
+Reactor::Detached Reactor::detach(Task<void> task) {
+    try {
+        co_await task;
+    } catch (...) {
+        if (!error_)
+            error_ = std::current_exception();
+    }
+    tasks_--;
+}
+
+void Reactor::spawn(Task<void> task) {
+    Detached detached = detach(std::move(task));
+    detached.handle.promise().reactor = this;
+    detached_.insert(detached.handle.address());
+    tasks_++;
+    schedule(detached.handle);
+}
+
+void Reactor::run() {
+    stopped_ = false;
+    while (!stopped_) {
+        while (!ready_.empty() && !stopped_) {
+            std::coroutine_handle<> handle = ready_.front();
+            ready_.pop_front();
+            handle.resume();
+        }
+
+        if (error_) {
+            std::exception_ptr error = std::exchange(error_, nullptr);
+            std::rethrow_exception(error);
+        }
+        if (stopped_ || tasks_ == 0)
+            break;
+
+        if (ready_.empty()) {
+            if (waiters_.empty())
+                throw std::runtime_error("Reactor tasks are suspended with nothing to wait for");
+            poll();
+        }
+    }
+}
+
+void Reactor::watch(int fd, bool write, std::coroutine_handle<> handle) {
+    Waiters& waiters = waiters_.try_emplace(fd, Waiters{nullptr, nullptr, 0}).first->second;
+    std::coroutine_handle<>& slot = write ? waiters.writer : waiters.reader;
+    if (slot)
+        throw std::runtime_error("Descriptor " + std::to_string(fd) + " already has a waiting "
+                                 + (write ? "writer" : "reader"));
+    slot = handle;
+    try {
+        update(fd, waiters);
+    } catch (...) {
+        slot = nullptr;
+        if (waiters.events == 0)
+            waiters_.erase(fd);
+        throw;
+    }
+}
+
+void Reactor::update(int fd, Waiters& waiters) {
+    const uint32_t events = (waiters.reader ? uint32_t{EPOLLIN | EPOLLRDHUP} : 0u) | (waiters.writer ? uint32_t{EPOLLOUT} : 0u);
+    if (events == waiters.events)
+        return;
+
+    epoll_event event;
+    event.events = events;
+    event.data.fd = fd;
+    int result;
+    if (events == 0)
+        result = epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    else
+        result = epoll_ctl(epoll_fd_, waiters.events == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event);
+
+    if (result < 0 && errno == EPERM) {
+        // Regular files can't be polled and are always ready
+        if (waiters.reader)
+            schedule(waiters.reader);
+        if (waiters.writer)
+            schedule(waiters.writer);
+        waiters_.erase(fd);
+        return;
+    }
+    if (result < 0)
+        throw std::runtime_error("Couldn't watch descriptor " + std::to_string(fd) + ": " + std::strerror(errno));
+
+    if (events == 0)
+        waiters_.erase(fd);
+    else
+        waiters.events = events;
+}
+
+void Reactor::poll() {
+    constexpr int max_events = 64;
+    epoll_event events[max_events];
+    int n = epoll_wait(epoll_fd_, events, max_events, -1);
+    if (n < 0) {
+        if (errno == EINTR)
+            return;
+        throw std::runtime_error("Error waiting for events: " + std::string(std::strerror(errno)));
+    }
+
+    for (int i = 0; i < n; i++) {
+        auto waiters = waiters_.find(events[i].data.fd);
+        if (waiters == waiters_.end())
+            continue;
+
+        // Errors and hang ups wake both sides, whose transfer then reports them
+        const uint32_t ready = events[i].events;
+        if ((ready & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) && waiters->second.reader)
+            schedule(std::exchange(waiters->second.reader, nullptr));
+        if ((ready & (EPOLLOUT | EPOLLHUP | EPOLLERR)) && waiters->second.writer)
+            schedule(std::exchange(waiters->second.writer, nullptr));
+        update(waiters->first, waiters->second);
+    }
+}
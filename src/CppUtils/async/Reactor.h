@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Task.h"
+
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+ * Single-threaded epoll event loop driving coroutines.
+ *
+ * Tasks are spawned onto the reactor and run on the thread calling run(),
+ * suspending on readable() / writable() while a descriptor isn't ready, so
+ * one thread serves any number of concurrent sessions. Descriptors are
+ * watched level-triggered, and only while something waits on them; each may
+ * have one reading and one writing waiter at a time. A descriptor must not be
+ * closed while awaited.
+ */
+class Reactor {
+public:
+    Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    /*
+     * Destroys the tasks which haven't finished.
+     */
+    ~Reactor();
+
+    /*
+     * Starts task on the next run; the reactor owns it until it finishes.
+     */
+    void spawn(Task<void> task);
+
+    /*
+     * Runs until every spawned task has finished or stop() is called. An
+     * exception escaping a spawned task stops the loop and is rethrown here.
+     */
+    void run();
+
+    /*
+     * Spawns task and runs until everything has finished, returning its
+     * result.
+     */
+    template <typename T>
+    T run(Task<T> task);
+
+    /*
+     * Makes run() return after the current step; unfinished tasks stay
+     * suspended until the next run().
+     */
+    void stop() { stopped_ = true; }
+
+    size_t active_tasks() const { return tasks_; }
+
+    struct FdAwaiter {
+        Reactor& reactor;
+        int fd;
+        bool write;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { reactor.watch(fd, write, handle); }
+        void await_resume() const noexcept {}
+    };
+
+    /*
+     * Suspends until fd can be read / written without blocking, or has an
+     * error or hang up for the transfer to report.
+     */
+    FdAwaiter readable(int fd) { return FdAwaiter{*this, fd, false}; }
+    FdAwaiter writable(int fd) { return FdAwaiter{*this, fd, true}; }
+
+    /*
+     * Queues a suspended coroutine to resume on the loop.
+     */
+    void schedule(std::coroutine_handle<> handle) { ready_.push_back(handle); }
+
+private:
+    struct Detached {
+        struct promise_type {
+            Reactor* reactor = nullptr;
+
+            Detached get_return_object() {
+                return Detached{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            // The frame frees itself once the task is done
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() noexcept { std::terminate(); }
+
+            ~promise_type();
+        };
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    struct Waiters {
+        std::coroutine_handle<> reader;
+        std::coroutine_handle<> writer;
+        uint32_t events;
+    };
+
+    Detached detach(Task<void> task);
+    void watch(int fd, bool write, std::coroutine_handle<> handle);
+    void update(int fd, Waiters& waiters);
+    void poll();
+
+    int epoll_fd_;
+    std::unordered_map<int, Waiters> waiters_;
+    std::deque<std::coroutine_handle<> > ready_;
+    std::unordered_set<void*> detached_;
+    size_t tasks_;
+    bool stopped_;
+    std::exception_ptr error_;
+};
+
+template <typename T>
+T Reactor::run(Task<T> task) {
+    if constexpr (std::is_void_v<T>) {
+        spawn(std::move(task));
+        run();
+    } else {
+        std::optional<T> result;
+        spawn([] (Task<T> task, std::optional<T>& result) -> Task<void> {
+            result.emplace(co_await task);
+        }(std::move(task), result));
+        run();
+        if (!result)
+            throw std::runtime_error("Reactor stopped before the task finished");
+        return std::move(*result);
+    }
+}
@@ -12,6 +12,12 @@ enum class Endianness {
     Big,
 };
 
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr static Endianness native_endianness = Endianness::Big;
+#else
+constexpr static Endianness native_endianness = Endianness::Little;
+#endif
+
 
 template <Endianness endian, size_t N_bytes>
 class ByteArray {
@@ -0,0 +1,61 @@
+#include "Crc32.h"
+
+#include <array>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t polynomial = 0xedb88320u;
+
+using Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+constexpr Tables make_tables() {
+    Tables tables = {};
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? polynomial : 0);
+        }
+        tables[0][i] = crc;
+    }
+    // tables[k][i] is the CRC of byte i followed by k zero bytes
+    for (size_t k = 1; k < tables.size(); k++) {
+        for (size_t i = 0; i < 256; i++) {
+            const uint32_t previous = tables[k - 1][i];
+            tables[k][i] = (previous >> 8) ^ tables[0][previous & 0xff];
+        }
+    }
+    return tables;
+}
+
+constexpr Tables tables = make_tables();
+
+}
+
+uint32_t crc32(const uint8_t* data, size_t N, uint32_t crc) {
+    crc = ~crc;
+
+    while (N >= 8) {
+        uint32_t low;
+        uint32_t high;
+        std::memcpy(&low, data, 4);
+        std::memcpy(&high, data + 4, 4);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        low = __builtin_bswap32(low);
+        high = __builtin_bswap32(high);
+#endif
+        low ^= crc;
+        crc = tables[7][low & 0xff] ^ tables[6][(low >> 8) & 0xff]
+            ^ tables[5][(low >> 16) & 0xff] ^ tables[4][low >> 24]
+            ^ tables[3][high & 0xff] ^ tables[2][(high >> 8) & 0xff]
+            ^ tables[1][(high >> 16) & 0xff] ^ tables[0][high >> 24];
+        data += 8;
+        N -= 8;
+    }
+
+    while (N-- > 0) {
+        crc = (crc >> 8) ^ tables[0][(crc ^ *data++) & 0xff];
+    }
+
+    return ~crc;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * CRC-32 (IEEE 802.3, as used by zlib and PNG) of N bytes, continuing from
+ * crc, so a checksum can be computed in pieces:
+ *
+ *      uint32_t crc = crc32(header, sizeof(header));
+ *      crc = crc32(payload, N, crc);
+ *
+ * Uses slicing-by-8 tables, processing 8 bytes per step.
+ */
+uint32_t crc32(const uint8_t* data, size_t N, uint32_t crc = 0);
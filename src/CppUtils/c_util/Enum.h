@@ -7,6 +7,7 @@
 #include <utility>
 #include <optional>
 #include <functional>
+#include <stdexcept>
 
 #include "CppUtils/preproc/VariadicMacros.h"
 
@@ -37,6 +38,17 @@ constexpr bool contains(const Cont& xs, const T& x) {
     return false;
 }
 
+template <typename Cont>
+constexpr bool values_are_contiguous(const Cont& xs) {
+    for (size_t i = 0; i < xs.size(); i++) {
+        using Underlying = std::underlying_type_t<typename Cont::value_type>;
+        if (static_cast<Underlying>(xs[i]) < 0 || static_cast<size_t>(xs[i]) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
 template <typename EnumTableType, typename EnumTableType::FieldEnum f>
 struct LookupFunctor {
     using EnumType = typename EnumTableType::EnumType;
@@ -74,10 +86,21 @@ constexpr auto tuple_to_variadic(FuncType&& f, const TupleType& args) {
     return tuple_to_variadic(std::forward<FuncType>(f), args, std::make_index_sequence<std::tuple_size_v<TupleType> >{});
 }
 
+/*
+ * std::common_type recurses once per type, so only fall back to it when the
+ * results actually differ.
+ */
+template <typename T, typename... Ts>
+struct common_result {
+    using type = std::conditional_t<(std::is_same_v<T, Ts> && ...),
+                                    std::common_type<T>,
+                                    std::common_type<T, Ts...> >;
+};
+
 template <typename Enum, template <Enum> typename FunctorType, typename... Args>
 struct dispatch_return {
     template <Enum... EnumValues>
-    using type = std::common_type_t<std::invoke_result_t<FunctorType<EnumValues>, Args&&...>...>;
+    using type = typename common_result<decltype(std::declval<FunctorType<EnumValues> >()(std::declval<Args&&>()...))...>::type::type;
 };
 
 template <typename T>
@@ -104,18 +127,69 @@ struct optional_return<void> {
     static void base_case() {}
 };
 
-template <typename Enum, template <Enum> typename FunctorType, typename RetType, typename TupleType, Enum... EnumValues, std::enable_if_t<sizeof...(EnumValues) == 0, bool> = true>
-constexpr auto dispatch_enum(Enum, const TupleType&) {
-    return optional_return<RetType>::base_case();
+/*
+ * Kept as flat as possible, since it is instantiated once per enum value.
+ */
+template <typename Enum, template <Enum> typename FunctorType, typename RetType, typename TupleType, Enum value, size_t... Is>
+constexpr auto dispatch_one(const TupleType& args) {
+    if constexpr (std::is_void_v<RetType>) {
+        FunctorType<value>()(std::get<Is>(args)...);
+    } else {
+        return std::optional<RetType>(FunctorType<value>()(std::get<Is>(args)...));
+    }
 }
 
-template <typename Enum, template <Enum> typename FunctorType, typename RetType, typename TupleType, Enum value, Enum... EnumValues>
-constexpr auto dispatch_enum(Enum x, const TupleType& args) {
-    if (x == value) {
-        return optional_return<RetType>::eval(FunctorType<value>(), args);
+/*
+ * Calls FunctorType<EnumValues[index]> through a table of function pointers,
+ * one per enum value. index is the indexer position of the value to dispatch,
+ * or nullopt to take the base case.
+ */
+template <typename Enum, template <Enum> typename FunctorType, typename RetType, typename TupleType, Enum... EnumValues, size_t... Is>
+constexpr auto dispatch_enum(std::optional<size_t> index, const TupleType& args, std::index_sequence<Is...>) {
+    if constexpr (sizeof...(EnumValues) == 0) {
+        return optional_return<RetType>::base_case();
     } else {
-        return dispatch_enum<Enum, FunctorType, RetType, TupleType, EnumValues...>(x, args);
+        using ResultType = decltype(optional_return<RetType>::base_case());
+        using HandlerType = ResultType (*)(const TupleType&);
+        constexpr HandlerType handlers[] = {&dispatch_one<Enum, FunctorType, RetType, TupleType, EnumValues, Is...>...};
+
+        if (index)
+            return handlers[*index](args);
+        return optional_return<RetType>::base_case();
+    }
+}
+
+/*
+ * constexpr heap sort, used to build lookup tables for enums which aren't
+ * contiguous.
+ */
+template <typename T, size_t N, typename Compare>
+constexpr void sift_down(std::array<T, N>& xs, size_t root, size_t end, const Compare& less) {
+    while (2 * root + 1 < end) {
+        size_t child = 2 * root + 1;
+        if (child + 1 < end && less(xs[child], xs[child + 1]))
+            child++;
+        if (!less(xs[root], xs[child]))
+            return;
+        T tmp = xs[root];
+        xs[root] = xs[child];
+        xs[child] = tmp;
+        root = child;
+    }
+}
+
+template <typename T, size_t N, typename Compare>
+constexpr std::array<T, N> heap_sort(std::array<T, N> xs, const Compare& less) {
+    for (size_t i = N / 2; i > 0; i--) {
+        sift_down(xs, i - 1, N, less);
+    }
+    for (size_t end = N; end > 1; end--) {
+        T tmp = xs[0];
+        xs[0] = xs[end - 1];
+        xs[end - 1] = tmp;
+        sift_down(xs, 0, end - 1, less);
     }
+    return xs;
 }
 
 }
@@ -128,19 +202,81 @@ public:
     constexpr static size_t size = sizeof...(EnumValues);
     constexpr static std::array<Enum, size> values{EnumValues...};
 
+    /*
+     * True when values[i] == i for every index, which is always the case for
+     * enums declared through INDEXED_ENUM. Lookups are then a plain cast.
+     */
+    constexpr static bool contiguous = values_are_contiguous(values);
+
+private:
+    struct SortedEntry {
+        std::underlying_type_t<Enum> value;
+        size_t index;
+    };
+
+    constexpr static auto make_sorted() -> std::array<SortedEntry, size> {
+        std::array<SortedEntry, size> entries{};
+        for (size_t i = 0; i < size; i++) {
+            entries[i] = SortedEntry{static_cast<std::underlying_type_t<Enum> >(values[i]), i};
+        }
+        return heap_sort(entries, [] (const SortedEntry& a, const SortedEntry& b) { return a.value < b.value; });
+    }
+
+    /*
+     * (value, index) pairs sorted by value, for binary searching
+     * non-contiguous enums.
+     */
+    constexpr static std::array<SortedEntry, size> sorted = make_sorted();
+
+    constexpr static std::optional<size_t> search(EnumType t) {
+        const auto key = static_cast<std::underlying_type_t<Enum> >(t);
+        size_t low = 0;
+        size_t high = size;
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            if (sorted[mid].value < key)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        if (low < size && sorted[low].value == key)
+            return sorted[low].index;
+        return std::nullopt;
+    }
+
+public:
+
     template <EnumType t>
     constexpr static bool contains() {
-        return ::contains(values, t);
+        return get(t).has_value();
     }
 
     template <EnumType t>
     constexpr static size_t get() {
         static_assert(contains<t>());
-        return *::find_matching_index(values, t);
+        return *get(t);
     }
 
     constexpr static std::optional<size_t> get(EnumType t) {
-        return ::find_matching_index(values, t);
+        if constexpr (contiguous) {
+            using Underlying = std::underlying_type_t<Enum>;
+            if (static_cast<Underlying>(t) >= 0 && static_cast<size_t>(t) < size)
+                return static_cast<size_t>(t);
+            return std::nullopt;
+        } else {
+            return search(t);
+        }
+    }
+
+    /*
+     * Unchecked index of a value which is known to be in the indexer.
+     */
+    constexpr static size_t index(EnumType t) {
+        if constexpr (contiguous) {
+            return static_cast<size_t>(t);
+        } else {
+            return *search(t);
+        }
     }
 
     template <template <Enum> typename FuncType, typename... Args>
@@ -149,7 +285,8 @@ public:
                       FuncType,
                       typename dispatch_return<Enum, FuncType, Args...>::type<EnumValues...>,
                       std::tuple<Args&&...>,
-                      EnumValues...>(x, std::forward_as_tuple(args...));
+                      EnumValues...>(get(x), std::forward_as_tuple(std::forward<Args>(args)...),
+                                     std::index_sequence_for<Args...>{});
     }
 
     // template <template <Enum> typename FunctorType, typename... Args>
@@ -158,11 +295,17 @@ public:
     // }
 };
 
+/*
+ * The indexer is a distinct type rather than an alias for EnumIndexer<...>.
+ * Templates instantiated over it (EnumTable, EnumArray, ...) then carry one
+ * short argument instead of every enum value, which keeps per-value
+ * instantiations cheap for large enums.
+ */
 #define INDEXED_ENUM(enum_name, ...) \
     enum class enum_name { __VA_ARGS__ }; \
-    using enum_name##Indexer = EnumIndexer<enum_name, \
+    struct enum_name##Indexer : EnumIndexer<enum_name, \
         CPPUTILS_DECORATED_1_MAP(COMMA, CPPUTILS_PREPEND_NAMESPACE, enum_name, __VA_ARGS__) \
-    >;
+    > {};
 
 
 template <typename FieldsIndexer, typename... ValueTypes>
@@ -229,7 +372,7 @@ public:
     constexpr static auto make_table(const Args&... args) -> Self {
         static_assert(sizeof...(Args) == Indexer::size);
         return make_table_helper(
-                std::array<std::pair<EnumType, std::tuple<ValueTypes...> >, Indexer::size>{args...},
+                ArgumentsType{args...},
                 std::make_index_sequence<Indexer::size>{});
     }
  
@@ -257,7 +400,8 @@ public:
     
     template <EnumType e>
     constexpr auto get() const -> EntryType const& {
-        return entries_[Indexer::template get<e>()];
+        static_assert(Indexer::get(e).has_value());
+        return std::get<Indexer::index(e)>(entries_);
     }
 
     template <EnumType e, FieldEnum field>
@@ -286,7 +430,7 @@ public:
 
     template <EnumType e>
     constexpr auto c_get() const -> EntryType {
-        return entries_[Indexer::template get<e>()];
+        return get<e>();
     }
 
     template <EnumType e, FieldEnum field>
@@ -322,33 +466,31 @@ private:
         : entries_(entries)
     {}
 
+    using ArgumentsType = std::array<std::pair<EnumType, std::tuple<ValueTypes...> >, Indexer::size>;
+
     template <size_t... Is>
-    constexpr static auto make_table_helper(
-            const std::array<std::pair<EnumType, std::tuple<ValueTypes...> >, Indexer::size>& values,
-            std::index_sequence<Is...>) -> Self
+    constexpr static auto make_table_helper(const ArgumentsType& values, std::index_sequence<Is...>) -> Self
     {
-        return Self({reverse_lookup_1<Is>(values)...});
+        const std::array<size_t, Indexer::size> positions = argument_positions(values);
+        return Self({std::get<1>(values[positions[Is]])...});
     }
 
-    template <size_t i>
-    constexpr static auto reverse_lookup_1(
-            const std::array<std::pair<EnumType, std::tuple<ValueTypes...> >, Indexer::size>& values)
-        -> const std::tuple<ValueTypes...>&
+    /*
+     * positions[i] is the argument holding the entry for Indexer::values[i].
+     * Every value must appear exactly once.
+     */
+    constexpr static auto argument_positions(const ArgumentsType& values) -> std::array<size_t, Indexer::size>
     {
-        static_assert(i < Indexer::size);
-        std::optional<size_t> value_index = reverse_lookup<Indexer::values[i]>(values);
-        if (value_index) {
-            return std::get<1>(values[*value_index]);
+        std::array<size_t, Indexer::size> positions{};
+        std::array<bool, Indexer::size> seen{};
+        for (size_t i = 0; i < values.size(); i++) {
+            std::optional<size_t> index = Indexer::get(std::get<0>(values[i]));
+            if (!index || seen[*index])
+                throw std::logic_error("EnumTable entries must contain every enum value exactly once");
+            seen[*index] = true;
+            positions[*index] = i;
         }
-        __builtin_unreachable();
-    }
-
-    template <EnumType target>
-    constexpr static auto reverse_lookup(
-            const std::array<std::pair<EnumType, std::tuple<ValueTypes...> >, Indexer::size>& values)
-        -> std::optional<size_t>
-    {
-        return ::find_index(values, [] (const auto& x) { return std::get<0>(x) == target; });
+        return positions;
     }
 
 
@@ -0,0 +1,464 @@
+#pragma once
+
+#include "Enum.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+
+/*
+ * Index of e, throwing std::out_of_range if it isn't in the indexer.
+ */
+template <typename Indexer>
+constexpr size_t checked_enum_index(typename Indexer::EnumType e) {
+    if (std::optional<size_t> index = Indexer::get(e))
+        return *index;
+    throw std::out_of_range("Enum value isn't in the container's indexer");
+}
+
+}
+
+/*
+ * Fixed size array indexed by the values of an EnumIndexer.
+ *
+ * Storage is a flat std::array in indexer order, so lookups are a single
+ * offset (a cast, for INDEXED_ENUM enums) with no hashing or allocation.
+ * operator[] is unchecked; at and find accept any value of the enum.
+ */
+template <typename Indexer, typename T>
+class EnumArray {
+public:
+    using Self = EnumArray<Indexer, T>;
+    using EnumType = typename Indexer::EnumType;
+    using StorageType = std::array<T, Indexer::size>;
+
+    constexpr EnumArray()
+        : values_{}
+    {}
+
+    constexpr explicit EnumArray(const T& value)
+        : values_{}
+    {
+        fill(value);
+    }
+
+    /*
+     * Unchecked access, e must be in the indexer.
+     */
+    constexpr T& operator[](EnumType e) {
+        return values_[Indexer::index(e)];
+    }
+
+    constexpr const T& operator[](EnumType e) const {
+        return values_[Indexer::index(e)];
+    }
+
+    /*
+     * Throws std::out_of_range if e isn't in the indexer.
+     */
+    constexpr T& at(EnumType e) {
+        return values_[detail::checked_enum_index<Indexer>(e)];
+    }
+
+    constexpr const T& at(EnumType e) const {
+        return values_[detail::checked_enum_index<Indexer>(e)];
+    }
+
+    template <EnumType e>
+    constexpr T& get() {
+        static_assert(Indexer::get(e).has_value());
+        return std::get<Indexer::index(e)>(values_);
+    }
+
+    template <EnumType e>
+    constexpr const T& get() const {
+        static_assert(Indexer::get(e).has_value());
+        return std::get<Indexer::index(e)>(values_);
+    }
+
+    /*
+     * Checked access, returns nullptr if the value isn't in the indexer.
+     */
+    constexpr T* find(EnumType e) {
+        if (std::optional<size_t> index = Indexer::get(e))
+            return &values_[*index];
+        return nullptr;
+    }
+
+    constexpr const T* find(EnumType e) const {
+        if (std::optional<size_t> index = Indexer::get(e))
+            return &values_[*index];
+        return nullptr;
+    }
+
+    constexpr void fill(const T& value) {
+        for (size_t i = 0; i < Indexer::size; i++) {
+            values_[i] = value;
+        }
+    }
+
+    constexpr static size_t size() { return Indexer::size; }
+
+    constexpr static EnumType key(size_t i) { return Indexer::values[i]; }
+
+    T* data() { return values_.data(); }
+    constexpr const T* data() const { return values_.data(); }
+
+    auto begin() { return values_.begin(); }
+    auto end() { return values_.end(); }
+    constexpr auto begin() const { return values_.begin(); }
+    constexpr auto end() const { return values_.end(); }
+
+    constexpr bool operator==(const Self& other) const { return values_ == other.values_; }
+    constexpr bool operator!=(const Self& other) const { return !(*this == other); }
+
+private:
+    StorageType values_;
+};
+
+
+/*
+ * Set of enum values packed into 64-bit words.
+ *
+ * Like std::bitset, test, set, reset and flip throw std::out_of_range for
+ * values outside the indexer, while operator[] is unchecked.
+ */
+template <typename Indexer>
+class EnumBitSet {
+public:
+    using Self = EnumBitSet<Indexer>;
+    using EnumType = typename Indexer::EnumType;
+    using WordType = uint64_t;
+
+    constexpr static size_t bits_per_word = sizeof(WordType) * 8;
+    constexpr static size_t num_words = (Indexer::size + bits_per_word - 1) / bits_per_word;
+
+    constexpr EnumBitSet()
+        : words_{}
+    {}
+
+    template <typename... Enums>
+    constexpr EnumBitSet(EnumType e, Enums... es)
+        : words_{}
+    {
+        set(e);
+        (set(es), ...);
+    }
+
+    constexpr bool test(EnumType e) const {
+        return test_index(detail::checked_enum_index<Indexer>(e));
+    }
+
+    /*
+     * Unchecked test, e must be in the indexer.
+     */
+    constexpr bool operator[](EnumType e) const {
+        return test_index(Indexer::index(e));
+    }
+
+    constexpr Self& set(EnumType e) {
+        size_t i = detail::checked_enum_index<Indexer>(e);
+        words_[word_index(i)] |= bit_flag(i);
+        return *this;
+    }
+
+    constexpr Self& set(EnumType e, bool value) {
+        return value ? set(e) : reset(e);
+    }
+
+    constexpr Self& reset(EnumType e) {
+        size_t i = detail::checked_enum_index<Indexer>(e);
+        words_[word_index(i)] &= ~bit_flag(i);
+        return *this;
+    }
+
+    constexpr Self& flip(EnumType e) {
+        size_t i = detail::checked_enum_index<Indexer>(e);
+        words_[word_index(i)] ^= bit_flag(i);
+        return *this;
+    }
+
+    constexpr Self& set_all() {
+        for (size_t i = 0; i < num_words; i++) {
+            words_[i] = ~WordType{0};
+        }
+        clear_padding();
+        return *this;
+    }
+
+    constexpr Self& reset_all() {
+        for (size_t i = 0; i < num_words; i++) {
+            words_[i] = 0;
+        }
+        return *this;
+    }
+
+    size_t count() const {
+        size_t total = 0;
+        for (size_t i = 0; i < num_words; i++) {
+            total += static_cast<size_t>(__builtin_popcountll(words_[i]));
+        }
+        return total;
+    }
+
+    constexpr bool any() const {
+        for (size_t i = 0; i < num_words; i++) {
+            if (words_[i] != 0)
+                return true;
+        }
+        return false;
+    }
+
+    constexpr bool none() const { return !any(); }
+
+    constexpr bool all() const { return Self(*this).flip_all().none(); }
+
+    constexpr static size_t size() { return Indexer::size; }
+
+    /*
+     * Calls f(e) for every set value, in indexer order.
+     */
+    template <typename FuncType>
+    void for_each(FuncType&& f) const {
+        for (size_t w = 0; w < num_words; w++) {
+            WordType word = words_[w];
+            while (word != 0) {
+                size_t bit = static_cast<size_t>(__builtin_ctzll(word));
+                f(Indexer::values[w * bits_per_word + bit]);
+                word &= word - 1;
+            }
+        }
+    }
+
+    constexpr Self& operator|=(const Self& other) {
+        for (size_t i = 0; i < num_words; i++) words_[i] |= other.words_[i];
+        return *this;
+    }
+
+    constexpr Self& operator&=(const Self& other) {
+        for (size_t i = 0; i < num_words; i++) words_[i] &= other.words_[i];
+        return *this;
+    }
+
+    constexpr Self& operator^=(const Self& other) {
+        for (size_t i = 0; i < num_words; i++) words_[i] ^= other.words_[i];
+        return *this;
+    }
+
+    constexpr Self operator~() const { return Self(*this).flip_all(); }
+
+    friend constexpr Self operator|(Self a, const Self& b) { return a |= b; }
+    friend constexpr Self operator&(Self a, const Self& b) { return a &= b; }
+    friend constexpr Self operator^(Self a, const Self& b) { return a ^= b; }
+
+    constexpr bool operator==(const Self& other) const {
+        for (size_t i = 0; i < num_words; i++) {
+            if (words_[i] != other.words_[i])
+                return false;
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const Self& other) const { return !(*this == other); }
+
+    constexpr bool test_index(size_t i) const {
+        return (words_[word_index(i)] & bit_flag(i)) != 0;
+    }
+
+private:
+    constexpr static size_t word_index(size_t i) { return i / bits_per_word; }
+    constexpr static WordType bit_flag(size_t i) { return WordType{1} << (i % bits_per_word); }
+
+    constexpr Self& flip_all() {
+        for (size_t i = 0; i < num_words; i++) {
+            words_[i] = ~words_[i];
+        }
+        clear_padding();
+        return *this;
+    }
+
+    constexpr void clear_padding() {
+        constexpr size_t n_used = Indexer::size % bits_per_word;
+        if constexpr (num_words > 0 && n_used != 0) {
+            words_[num_words - 1] &= (WordType{1} << n_used) - 1;
+        }
+    }
+
+    std::array<WordType, num_words> words_;
+};
+
+
+/*
+ * Map from enum values to T with a presence bit per entry.
+ *
+ * Values are constructed in place in fixed inline storage; inserting and
+ * erasing never allocates.
+ */
+template <typename Indexer, typename T>
+class EnumMap {
+public:
+    using Self = EnumMap<Indexer, T>;
+    using EnumType = typename Indexer::EnumType;
+
+    EnumMap() = default;
+
+    EnumMap(const Self& other) {
+        other.present_.for_each([&] (EnumType e) { construct(e, other.get_unchecked(e)); });
+    }
+
+    EnumMap(Self&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        other.present_.for_each([&] (EnumType e) { construct(e, std::move(other.get_unchecked(e))); });
+        other.clear();
+    }
+
+    Self& operator=(const Self& other) {
+        if (this != &other) {
+            clear();
+            other.present_.for_each([&] (EnumType e) { construct(e, other.get_unchecked(e)); });
+        }
+        return *this;
+    }
+
+    Self& operator=(Self&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            other.present_.for_each([&] (EnumType e) { construct(e, std::move(other.get_unchecked(e))); });
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~EnumMap() {
+        clear();
+    }
+
+    bool contains(EnumType e) const {
+        std::optional<size_t> index = Indexer::get(e);
+        return index && present_.test_index(*index);
+    }
+
+    size_t size() const { return present_.count(); }
+    bool empty() const { return present_.none(); }
+    constexpr static size_t capacity() { return Indexer::size; }
+
+    const EnumBitSet<Indexer>& keys() const { return present_; }
+
+    /*
+     * Constructs the value for e in place, replacing any existing value.
+     * Throws std::out_of_range if e isn't in the indexer.
+     */
+    template <typename... Args>
+    T& emplace(EnumType e, Args&&... args) {
+        if (!Indexer::get(e))
+            throw std::out_of_range("Enum value isn't in the EnumMap's indexer");
+        erase(e);
+        return construct(e, std::forward<Args>(args)...);
+    }
+
+    /*
+     * Inserts the value if e is not present. Returns the stored value and
+     * whether an insertion happened.
+     */
+    template <typename U>
+    std::pair<T*, bool> insert(EnumType e, U&& value) {
+        if (contains(e))
+            return {&get_unchecked(e), false};
+        return {&emplace(e, std::forward<U>(value)), true};
+    }
+
+    /*
+     * Default constructs the value if not present.
+     */
+    T& operator[](EnumType e) {
+        if (!contains(e))
+            return emplace(e);
+        return get_unchecked(e);
+    }
+
+    bool erase(EnumType e) {
+        if (!contains(e))
+            return false;
+        get_unchecked(e).~T();
+        present_.reset(e);
+        return true;
+    }
+
+    void clear() {
+        present_.for_each([this] (EnumType e) { get_unchecked(e).~T(); });
+        present_.reset_all();
+    }
+
+    T* find(EnumType e) {
+        return contains(e) ? &get_unchecked(e) : nullptr;
+    }
+
+    const T* find(EnumType e) const {
+        return contains(e) ? &get_unchecked(e) : nullptr;
+    }
+
+    /*
+     * Throws std::out_of_range if e isn't present.
+     */
+    T& at(EnumType e) {
+        if (!contains(e))
+            throw std::out_of_range("EnumMap::at key not present");
+        return get_unchecked(e);
+    }
+
+    const T& at(EnumType e) const {
+        if (!contains(e))
+            throw std::out_of_range("EnumMap::at key not present");
+        return get_unchecked(e);
+    }
+
+    /*
+     * Unchecked access, e must be in the indexer and present.
+     */
+    T& get_unchecked(EnumType e) {
+        return *std::launder(reinterpret_cast<T*>(slot(e)));
+    }
+
+    const T& get_unchecked(EnumType e) const {
+        return *std::launder(reinterpret_cast<const T*>(slot(e)));
+    }
+
+    /*
+     * Calls f(e, value) for every present entry, in indexer order.
+     */
+    template <typename FuncType>
+    void for_each(FuncType&& f) {
+        present_.for_each([&] (EnumType e) { f(e, get_unchecked(e)); });
+    }
+
+    template <typename FuncType>
+    void for_each(FuncType&& f) const {
+        present_.for_each([&] (EnumType e) { f(e, get_unchecked(e)); });
+    }
+
+private:
+    using SlotType = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    /*
+     * e must be in the indexer and not present.
+     */
+    template <typename... Args>
+    T& construct(EnumType e, Args&&... args) {
+        T* value = new (slot(e)) T(std::forward<Args>(args)...);
+        present_.set(e);
+        return *value;
+    }
+
+    // e must be in the indexer
+    void* slot(EnumType e) { return &slots_[Indexer::index(e)]; }
+    const void* slot(EnumType e) const { return &slots_[Indexer::index(e)]; }
+
+    EnumBitSet<Indexer> present_;
+    std::array<SlotType, Indexer::size> slots_;
+};
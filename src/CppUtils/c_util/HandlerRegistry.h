@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Enum.h"
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Decodes messages of the form
+ *
+ *      [code : CodeType][argument 0]...[argument n]
+ *
+ * from a reader and calls the handler bound to the code. Binding is done at
+ * compile time: Handler<e> is a functor template specialized per enum value,
+ * which declares the arguments it expects on the wire, e.g.
+ *
+ *      template <Opcode op> struct OnMessage;
+ *
+ *      template <> struct OnMessage<Opcode::SetRate> {
+ *          using Arguments = std::tuple<uint8_t, float>;
+ *          void operator()(Device& device, uint8_t channel, float rate) const;
+ *      };
+ *
+ *      using Registry = HandlerRegistry<OpcodeIndexer, OnMessage, uint16_t>;
+ *      Registry::dispatch(reader, device);
+ *
+ * Extra arguments given to dispatch are passed through to the handler ahead of
+ * the decoded arguments. Arguments are read into a std::tuple on the stack and
+ * the handler is reached through EnumIndexer::dispatch, so there are no
+ * allocations or virtual calls beyond those of the reader itself. Handlers
+ * are bound by type rather than through an EnumTable, since each code decodes
+ * a different argument tuple.
+ *
+ * The wire code is the enum value cast to CodeType. Arguments are read with
+ * Reader::read(T&), in host byte order.
+ */
+template <typename Indexer, template <typename Indexer::EnumType> typename Handler,
+          typename CodeType = std::underlying_type_t<typename Indexer::EnumType> >
+class HandlerRegistry {
+public:
+    using EnumType = typename Indexer::EnumType;
+
+    template <EnumType e>
+    using Arguments = typename Handler<e>::Arguments;
+
+    /*
+     * Maps a wire code to its enum value, if it is bound to a handler.
+     */
+    constexpr static std::optional<EnumType> decode_code(CodeType code) {
+        const EnumType e = static_cast<EnumType>(code);
+        if (Indexer::get(e))
+            return e;
+        return std::nullopt;
+    }
+
+    /*
+     * Reads one message and calls its handler, returning the handler's
+     * result. Throws if the code isn't bound to a handler.
+     */
+    template <typename Reader, typename... Extra>
+    static auto dispatch(Reader& reader, Extra&&... extra) {
+        CodeType code;
+        reader.read(code);
+        return dispatch_code(code, reader, std::forward<Extra>(extra)...);
+    }
+
+    /*
+     * Like dispatch, for when the code has already been read.
+     */
+    template <typename Reader, typename... Extra>
+    static auto dispatch_code(CodeType code, Reader& reader, Extra&&... extra) {
+        std::optional<EnumType> e = decode_code(code);
+        if (!e)
+            throw std::runtime_error("No handler for message code " + std::to_string(code));
+
+        // The code is bound, so the indexer's std::optional is always engaged
+        using Result = decltype(Indexer::template dispatch<decode>(*e, reader, std::forward<Extra>(extra)...));
+        if constexpr (std::is_void_v<Result>)
+            Indexer::template dispatch<decode>(*e, reader, std::forward<Extra>(extra)...);
+        else
+            return *Indexer::template dispatch<decode>(*e, reader, std::forward<Extra>(extra)...);
+    }
+
+    /*
+     * Writes a message for e in the format dispatch expects.
+     */
+    template <EnumType e, typename Writer, typename... Args>
+    static void write_message(Writer& writer, Args&&... args) {
+        static_assert(sizeof...(Args) == std::tuple_size_v<Arguments<e> >);
+        writer.write(static_cast<CodeType>(e));
+        const Arguments<e> values(std::forward<Args>(args)...);
+        std::apply([&writer] (const auto&... value) { (writer.write(value), ...); }, values);
+    }
+
+private:
+    template <EnumType e>
+    struct decode {
+        template <typename Reader, typename... Extra>
+        auto operator()(Reader& reader, Extra&&... extra) const {
+            Arguments<e> values;
+            std::apply([&reader] (auto&... value) { (reader.read(value), ...); }, values);
+            return std::apply(
+                    [&extra...] (auto&... value) {
+                        return Handler<e>()(std::forward<Extra>(extra)..., value...);
+                    },
+                    values);
+        }
+    };
+};
@@ -0,0 +1,129 @@
+#include "ThreadPool.h"
+
+#include <stdexcept>
+
+namespace {
+
+struct WorkerIdentity {
+    const ThreadPool* pool = nullptr;
+    size_t index = 0;
+};
+
+thread_local WorkerIdentity current_worker;
+
+}
+
+ThreadPool::ThreadPool(size_t n_threads, size_t queue_capacity)
+    : injection_(queue_capacity), next_worker_(0), pending_(0), sleepers_(0), stopping_(false)
+{
+    if (n_threads == 0)
+        n_threads = 1;
+
+    for (size_t i = 0; i < n_threads; i++) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < n_threads; i++) {
+        threads_.emplace_back([this, i] { run(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+bool ThreadPool::in_pool() const {
+    return current_worker.pool == this;
+}
+
+void ThreadPool::post(Task task) {
+    // Counted before the task is visible, so a worker never takes a task
+    // which isn't counted yet; workers retry until the push lands.
+    pending_.fetch_add(1, std::memory_order_seq_cst);
+
+    try {
+        if (in_pool()) {
+            Worker& worker = *workers_[current_worker.index];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.tasks.push_back(std::move(task));
+        } else if (!injection_.try_push(std::move(task))) {
+            // try_push only moves from task on success
+            Worker& worker = *workers_[next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size()];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.tasks.push_back(std::move(task));
+        }
+    } catch (...) {
+        // The task never landed; a count without a task keeps workers spinning
+        pending_.fetch_sub(1, std::memory_order_seq_cst);
+        throw;
+    }
+
+    // Sleepers register before their last check of pending_, under the lock;
+    // we check in the opposite order, so either they see the task or we see
+    // them and take the lock to wake them.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) != 0) {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        wake_.notify_one();
+    }
+}
+
+bool ThreadPool::try_get(size_t index, Task& task) {
+    {
+        Worker& self = *workers_[index];
+        std::lock_guard<std::mutex> lock(self.mutex);
+        if (!self.tasks.empty()) {
+            task = std::move(self.tasks.back());
+            self.tasks.pop_back();
+            return true;
+        }
+    }
+
+    if (injection_.try_pop(task))
+        return true;
+
+    for (size_t i = 1; i < workers_.size(); i++) {
+        Worker& victim = *workers_[(index + i) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(size_t index) {
+    current_worker.pool = this;
+    current_worker.index = index;
+
+    Task task;
+    while (true) {
+        if (pending_.load(std::memory_order_acquire) > 0 && try_get(index, task)) {
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        if (stopping_ && pending_.load(std::memory_order_acquire) == 0)
+            break;
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake_.wait(lock, [this] { return stopping_ || pending_.load(std::memory_order_acquire) > 0; });
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        if (stopping_ && pending_.load(std::memory_order_acquire) == 0)
+            break;
+    }
+
+    current_worker.pool = nullptr;
+}
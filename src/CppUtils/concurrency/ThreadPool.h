@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CppUtils/container/MpmcQueue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Work-stealing thread pool.
+ *
+ * Each worker owns a deque of tasks: tasks posted from a worker go to the back
+ * of its own deque and are run newest first, while idle workers steal the
+ * oldest task from the front of another worker's deque. Tasks posted from
+ * other threads go through a shared bounded MpmcQueue, falling back to the
+ * workers' deques when it is full.
+ *
+ * The destructor runs every task which has already been posted, then joins
+ * the workers.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t n_threads = std::thread::hardware_concurrency(), size_t queue_capacity = 1024);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool();
+
+    size_t size() const { return threads_.size(); }
+
+    /*
+     * Runs task on the pool, fire and forget. Exceptions escaping the task
+     * terminate the program; use submit to propagate them.
+     */
+    void post(Task task);
+
+    /*
+     * Runs f(args...) on the pool, returning a future for the result.
+     */
+    template <typename FuncType, typename... Args>
+    auto submit(FuncType&& f, Args&&... args) -> std::future<std::invoke_result_t<FuncType, Args...> > {
+        using ResultType = std::invoke_result_t<FuncType, Args...>;
+
+        // std::function needs a copyable target, packaged_task isn't
+        auto task = std::make_shared<std::packaged_task<ResultType()> >(
+                [f = std::forward<FuncType>(f), args = std::make_tuple(std::forward<Args>(args)...)] () mutable {
+                    return std::apply(std::move(f), std::move(args));
+                });
+        std::future<ResultType> result = task->get_future();
+        post([task] { (*task)(); });
+        return result;
+    }
+
+    /*
+     * True if called from one of this pool's workers.
+     */
+    bool in_pool() const;
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(size_t index);
+    bool try_get(size_t index, Task& task);
+
+    std::vector<std::unique_ptr<Worker> > workers_;
+    MpmcQueue<Task> injection_;
+    std::atomic<size_t> next_worker_;
+
+    std::atomic<size_t> pending_;
+    std::atomic<size_t> sleepers_;
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stopping_;
+
+    std::vector<std::thread> threads_;
+};
+
+
+// ----- I/O helpers
+// The reader / writer and buffer must stay alive until the future is ready.
+
+template <typename Reader, typename T>
+std::future<void> submit_read(ThreadPool& pool, Reader& reader, T* buffer, size_t N) {
+    return pool.submit([&reader, buffer, N] { reader.read(buffer, N); });
+}
+
+template <typename Reader, typename T>
+std::future<size_t> submit_var_read(ThreadPool& pool, Reader& reader, T* buffer, size_t N) {
+    return pool.submit([&reader, buffer, N] { return reader.var_read(buffer, N); });
+}
+
+template <typename Writer, typename T>
+std::future<void> submit_write(ThreadPool& pool, Writer& writer, const T* buffer, size_t N) {
+    return pool.submit([&writer, buffer, N] { writer.write(buffer, N); });
+}
@@ -0,0 +1,426 @@
+#pragma once
+
+#include "Span.h"
+#include "Layout.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace detail {
+
+/*
+ * Large zeroed allocation, optionally backed by huge pages.
+ *
+ * With huge_pages the memory is first requested with MAP_HUGETLB, which only
+ * succeeds if the system has huge pages reserved, then with a plain mapping
+ * advised with MADV_HUGEPAGE for transparent huge pages.
+ */
+class Slab {
+public:
+    constexpr static size_t huge_page_size = 2 * 1024 * 1024;
+
+    Slab(size_t size, bool huge_pages)
+        : data_(nullptr), size_(size), huge_pages_(false)
+    {
+        if (huge_pages) {
+            const size_t huge_size = (size + huge_page_size - 1) / huge_page_size * huge_page_size;
+            void* data = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (data != MAP_FAILED) {
+                data_ = static_cast<uint8_t*>(data);
+                size_ = huge_size;
+                huge_pages_ = true;
+                return;
+            }
+        }
+
+        void* data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (data == MAP_FAILED)
+            throw std::bad_alloc();
+        if (huge_pages)
+            madvise(data, size_, MADV_HUGEPAGE);
+        data_ = static_cast<uint8_t*>(data);
+    }
+
+    Slab(const Slab&) = delete;
+    Slab& operator=(const Slab&) = delete;
+
+    ~Slab() {
+        munmap(data_, size_);
+    }
+
+    uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    /*
+     * True if the MAP_HUGETLB mapping succeeded.
+     */
+    bool huge_pages() const { return huge_pages_; }
+
+private:
+    uint8_t* data_;
+    size_t size_;
+    bool huge_pages_;
+};
+
+}
+
+
+class BufferPool;
+
+/*
+ * Buffer borrowed from a BufferPool, returned to it on destruction.
+ *
+ * size() starts at the pool's buffer size and may be shrunk with resize, e.g.
+ * to the length of a variable length read; capacity() doesn't change.
+ */
+class PooledBuffer {
+public:
+    PooledBuffer()
+        : pool_(nullptr), data_(nullptr), size_(0)
+    {}
+
+    PooledBuffer(BufferPool* pool, uint8_t* data, size_t size)
+        : pool_(pool), data_(data), size_(size)
+    {}
+
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+    PooledBuffer(PooledBuffer&& other)
+        : pool_(std::exchange(other.pool_, nullptr)),
+          data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0))
+    {}
+
+    PooledBuffer& operator=(PooledBuffer&& other) {
+        if (this != &other) {
+            release();
+            pool_ = std::exchange(other.pool_, nullptr);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~PooledBuffer() {
+        release();
+    }
+
+    uint8_t* data() { return data_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    size_t capacity() const;
+    bool empty() const { return size_ == 0; }
+
+    uint8_t* begin() { return data_; }
+    uint8_t* end() { return data_ + size_; }
+    const uint8_t* begin() const { return data_; }
+    const uint8_t* end() const { return data_ + size_; }
+
+    uint8_t& operator[](size_t i) { return data_[i]; }
+    const uint8_t& operator[](size_t i) const { return data_[i]; }
+
+    void resize(size_t size) {
+        if (size > capacity())
+            throw std::length_error("PooledBuffer::resize above capacity");
+        size_ = size;
+    }
+
+    Span<uint8_t> span() { return Span<uint8_t>(data_, size_); }
+    Span<const uint8_t> span() const { return Span<const uint8_t>(data_, size_); }
+
+    std::string_view str() const {
+        return std::string_view(reinterpret_cast<const char*>(data_), size_);
+    }
+
+    explicit operator bool() const { return data_ != nullptr; }
+
+    /*
+     * Returns the buffer to its pool early.
+     */
+    void release();
+
+private:
+    BufferPool* pool_;
+    uint8_t* data_;
+    size_t size_;
+};
+
+
+/*
+ * Pool of fixed size, cache line aligned byte buffers.
+ *
+ * Buffers are carved out of slabs of buffers_per_slab buffers, which are
+ * allocated on demand and only returned to the system when the pool is
+ * destroyed. Free buffers are kept in intrusive free lists striped over
+ * n_shards shards, each on its own cache line; a thread uses the shard picked
+ * by its id and only looks at the others when its own is empty, so threads
+ * mostly hit an uncontended lock and get back the buffers they freed last,
+ * which are still warm in their cache.
+ *
+ * Buffers must not outlive the pool.
+ */
+class BufferPool {
+public:
+    constexpr static size_t n_shards = 8;
+
+    explicit BufferPool(size_t buffer_size, size_t buffers_per_slab = 64, bool huge_pages = false)
+        : buffer_size_(std::max<size_t>(buffer_size, 1)),
+          stride_((std::max(buffer_size_, sizeof(FreeNode)) + layout::cache_line_size - 1) / layout::cache_line_size * layout::cache_line_size),
+          buffers_per_slab_(std::max<size_t>(buffers_per_slab, 1)),
+          huge_pages_(huge_pages)
+    {}
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    size_t buffer_size() const { return buffer_size_; }
+
+    size_t slab_count() const {
+        std::lock_guard<std::mutex> lock(slabs_mutex_);
+        return slabs_.size();
+    }
+
+    /*
+     * Total number of buffers, borrowed or free.
+     */
+    size_t buffer_count() const {
+        std::lock_guard<std::mutex> lock(slabs_mutex_);
+        size_t total = 0;
+        for (const auto& slab : slabs_) {
+            total += slab->size() / stride_;
+        }
+        return total;
+    }
+
+    PooledBuffer acquire() {
+        return PooledBuffer(this, allocate(), buffer_size_);
+    }
+
+    /*
+     * Raw interface; the buffer must be given back with deallocate.
+     */
+    uint8_t* allocate() {
+        const size_t home = home_shard();
+        for (size_t i = 0; i < n_shards; i++) {
+            if (uint8_t* buffer = shards_[(home + i) % n_shards].pop())
+                return buffer;
+        }
+        return grow(shards_[home]);
+    }
+
+    void deallocate(uint8_t* buffer) {
+        shards_[home_shard()].push(buffer);
+    }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct alignas(layout::cache_line_size) Shard {
+        std::mutex mutex;
+        FreeNode* head = nullptr;
+
+        uint8_t* pop() {
+            std::lock_guard<std::mutex> lock(mutex);
+            FreeNode* node = head;
+            if (node == nullptr)
+                return nullptr;
+            head = node->next;
+            return reinterpret_cast<uint8_t*>(node);
+        }
+
+        void push(uint8_t* buffer) {
+            FreeNode* node = new (buffer) FreeNode;
+            std::lock_guard<std::mutex> lock(mutex);
+            node->next = head;
+            head = node;
+        }
+    };
+
+    static size_t home_shard() {
+        thread_local const size_t shard = std::hash<std::thread::id>()(std::this_thread::get_id()) % n_shards;
+        return shard;
+    }
+
+    /*
+     * Allocates a new slab, returning its first buffer and giving the rest
+     * to shard.
+     */
+    uint8_t* grow(Shard& shard) {
+        auto slab = std::make_unique<detail::Slab>(stride_ * buffers_per_slab_, huge_pages_);
+        const size_t count = slab->size() / stride_;
+        uint8_t* first = slab->data();
+        {
+            std::lock_guard<std::mutex> lock(slabs_mutex_);
+            slabs_.push_back(std::move(slab));
+        }
+
+        FreeNode* head = nullptr;
+        FreeNode* tail = nullptr;
+        for (size_t i = count; i-- > 1;) {
+            FreeNode* node = new (first + i * stride_) FreeNode;
+            node->next = head;
+            head = node;
+            if (tail == nullptr)
+                tail = node;
+        }
+        if (head != nullptr) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            tail->next = shard.head;
+            shard.head = head;
+        }
+        return first;
+    }
+
+    const size_t buffer_size_;
+    const size_t stride_;
+    const size_t buffers_per_slab_;
+    const bool huge_pages_;
+
+    std::array<Shard, n_shards> shards_;
+
+    mutable std::mutex slabs_mutex_;
+    std::vector<std::unique_ptr<detail::Slab> > slabs_;
+};
+
+inline size_t PooledBuffer::capacity() const {
+    return pool_ != nullptr ? pool_->buffer_size() : 0;
+}
+
+inline void PooledBuffer::release() {
+    if (pool_ != nullptr) {
+        pool_->deallocate(data_);
+        pool_ = nullptr;
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+
+/*
+ * Bump allocator for per-message scratch data.
+ *
+ * Allocations are carved sequentially out of chunks and are all freed at once
+ * by reset(), which keeps the chunks for reuse, so a steady state loop of
+ * "decode message, reset" allocates nothing. Destructors of allocated objects
+ * are never run; it is meant for bytes and trivially destructible types.
+ */
+class MonotonicArena {
+public:
+    explicit MonotonicArena(size_t chunk_size = 64 * 1024)
+        : chunk_size_(std::max<size_t>(chunk_size, layout::cache_line_size)), current_(0), offset_(0)
+    {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        while (current_ < chunks_.size()) {
+            Chunk& chunk = chunks_[current_];
+            const size_t start = align_offset(chunk.data.get(), offset_, alignment);
+            if (start + size <= chunk.size) {
+                offset_ = start + size;
+                return chunk.data.get() + start;
+            }
+            current_++;
+            offset_ = 0;
+        }
+
+        // Chunks are aligned to a cache line; larger alignments may need padding
+        const size_t size_needed = size + (alignment > layout::cache_line_size ? alignment : 0);
+        chunks_.push_back(Chunk(std::max(chunk_size_, size_needed)));
+        current_ = chunks_.size() - 1;
+        Chunk& chunk = chunks_.back();
+        const size_t start = align_offset(chunk.data.get(), 0, alignment);
+        offset_ = start + size;
+        return chunk.data.get() + start;
+    }
+
+    /*
+     * Uninitialized storage for N objects of trivial type T.
+     */
+    template <typename T>
+    Span<T> allocate(size_t N) {
+        static_assert(std::is_trivially_destructible_v<T>);
+        return Span<T>(static_cast<T*>(allocate(sizeof(T) * N, alignof(T))), N);
+    }
+
+    /*
+     * Copies str into the arena.
+     */
+    std::string_view copy(std::string_view str) {
+        char* data = allocate<char>(str.size()).data();
+        std::copy(str.begin(), str.end(), data);
+        return std::string_view(data, str.size());
+    }
+
+    /*
+     * Frees every allocation, keeping the chunks.
+     */
+    void reset() {
+        current_ = 0;
+        offset_ = 0;
+    }
+
+    /*
+     * Frees every allocation and the chunks.
+     */
+    void release() {
+        chunks_.clear();
+        reset();
+    }
+
+    /*
+     * Bytes reserved from the system.
+     */
+    size_t capacity() const {
+        size_t total = 0;
+        for (const Chunk& chunk : chunks_) {
+            total += chunk.size;
+        }
+        return total;
+    }
+
+private:
+    struct AlignedDelete {
+        void operator()(uint8_t* data) const {
+            ::operator delete(data, std::align_val_t(layout::cache_line_size));
+        }
+    };
+
+    struct Chunk {
+        explicit Chunk(size_t size)
+            : data(static_cast<uint8_t*>(::operator new(size, std::align_val_t(layout::cache_line_size)))), size(size)
+        {}
+
+        std::unique_ptr<uint8_t, AlignedDelete> data;
+        size_t size;
+    };
+
+    static size_t align_offset(const uint8_t* base, size_t offset, size_t alignment) {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(base) + offset;
+        const uintptr_t aligned = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        return offset + (aligned - address);
+    }
+
+    const size_t chunk_size_;
+    std::vector<Chunk> chunks_;
+    size_t current_;
+    size_t offset_;
+};
@@ -0,0 +1,578 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace detail {
+
+/*
+ * Finalizer of murmur3's 64-bit hash, spreads std::hash results (the identity
+ * for integers) over all bits.
+ */
+constexpr uint64_t mix_hash(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/*
+ * Sixteen control bytes of a FlatHashMap, matched all at once.
+ */
+class ControlGroup {
+public:
+    constexpr static size_t width = 16;
+
+    explicit ControlGroup(const int8_t* ctrl) {
+#if defined(__SSE2__)
+        ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+        std::memcpy(ctrl_, ctrl, width);
+#endif
+    }
+
+    /*
+     * Bit i is set if byte i equals value.
+     */
+    uint32_t match(int8_t value) const {
+#if defined(__SSE2__)
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), ctrl_)));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < width; i++) {
+            mask |= static_cast<uint32_t>(ctrl_[i] == value) << i;
+        }
+        return mask;
+#endif
+    }
+
+    /*
+     * Bit i is set if byte i is empty or deleted, i.e. negative.
+     */
+    uint32_t match_available() const {
+#if defined(__SSE2__)
+        return static_cast<uint32_t>(_mm_movemask_epi8(ctrl_));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < width; i++) {
+            mask |= static_cast<uint32_t>(ctrl_[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+
+private:
+#if defined(__SSE2__)
+    __m128i ctrl_;
+#else
+    int8_t ctrl_[width];
+#endif
+};
+
+}
+
+/*
+ * Default hash of FlatHashMap: std::hash followed by a bit mixer.
+ */
+template <typename T>
+struct FlatHash {
+    size_t operator()(const T& x) const {
+        return static_cast<size_t>(detail::mix_hash(static_cast<uint64_t>(std::hash<T>()(x))));
+    }
+};
+
+/*
+ * Hash of composite keys such as an I2C (bus, address) pair.
+ */
+template <typename A, typename B>
+struct FlatHash<std::pair<A, B> > {
+    size_t operator()(const std::pair<A, B>& x) const {
+        const uint64_t a = static_cast<uint64_t>(std::hash<A>()(x.first));
+        const uint64_t b = static_cast<uint64_t>(std::hash<B>()(x.second));
+        return static_cast<size_t>(detail::mix_hash(a * 0x9e3779b97f4a7c15ULL ^ b));
+    }
+};
+
+
+/*
+ * Open-addressing hash map laid out as a Swiss table.
+ *
+ * Slots are grouped by 16. Each slot has a control byte which is either empty,
+ * deleted (a tombstone) or the low 7 bits of the key's hash; a lookup hashes
+ * once, then compares a whole group of control bytes against those 7 bits in
+ * one SSE2 instruction (a byte loop without SSE2) and only touches slots whose
+ * byte matched. Entries live in one flat array, there is no per-entry
+ * allocation.
+ *
+ * In fixed capacity mode the table is sized once to hold at least `capacity`
+ * entries and never allocates afterwards; inserting more than max_load()
+ * entries throws std::length_error.
+ * Otherwise the table doubles once it is 7/8 full.
+ *
+ * Inserting or erasing may invalidate pointers and iterators to entries.
+ */
+template <typename K, typename V, typename Hash = FlatHash<K>, typename KeyEqual = std::equal_to<K> >
+class FlatHashMap {
+public:
+    using Self = FlatHashMap<K, V, Hash, KeyEqual>;
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+
+    template <bool is_const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Self::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<is_const, const value_type*, value_type*>;
+        using reference = std::conditional_t<is_const, const value_type&, value_type&>;
+
+        Iterator() : map_(nullptr), index_(0) {}
+
+        operator Iterator<true>() const { return Iterator<true>(map_, index_); }
+
+        reference operator*() const { return *map_->slot(index_); }
+        pointer operator->() const { return map_->slot(index_); }
+
+        Iterator& operator++() {
+            index_ = map_->next_full(index_ + 1);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const Iterator& other) const { return index_ != other.index_; }
+
+    private:
+        friend class FlatHashMap;
+        template <bool> friend class Iterator;
+
+        using MapPointer = std::conditional_t<is_const, const FlatHashMap*, FlatHashMap*>;
+
+        Iterator(MapPointer map, size_t index) : map_(map), index_(index) {}
+
+        MapPointer map_;
+        size_t index_;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    explicit FlatHashMap(size_t capacity = 0, bool fixed_capacity = false)
+        : fixed_capacity_(fixed_capacity)
+    {
+        if (capacity > 0 || fixed_capacity)
+            allocate(capacity_for(capacity));
+    }
+
+    FlatHashMap(const Self& other)
+        : fixed_capacity_(other.fixed_capacity_)
+    {
+        if (other.capacity_ > 0)
+            allocate(other.capacity_);
+        for (const value_type& entry : other) {
+            insert_unique(hash_of(entry.first), entry);
+        }
+    }
+
+    FlatHashMap(Self&& other)
+        : ctrl_(std::exchange(other.ctrl_, nullptr)),
+          slots_(std::exchange(other.slots_, nullptr)),
+          capacity_(std::exchange(other.capacity_, 0)),
+          size_(std::exchange(other.size_, 0)),
+          growth_left_(std::exchange(other.growth_left_, 0)),
+          fixed_capacity_(other.fixed_capacity_)
+    {}
+
+    Self& operator=(const Self& other) {
+        if (this != &other) {
+            Self copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    Self& operator=(Self&& other) {
+        if (this != &other) {
+            Self moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    ~FlatHashMap() {
+        clear();
+        deallocate();
+    }
+
+    void swap(Self& other) {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(growth_left_, other.growth_left_);
+        std::swap(fixed_capacity_, other.fixed_capacity_);
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /*
+     * Number of slots; at most 7/8 of them can be full.
+     */
+    size_t bucket_count() const { return capacity_; }
+
+    /*
+     * Entries the table holds before it has to grow (or throw, in fixed
+     * capacity mode).
+     */
+    size_t max_load() const { return max_load(capacity_); }
+
+    bool fixed_capacity() const { return fixed_capacity_; }
+
+    iterator begin() { return iterator(this, next_full(0)); }
+    iterator end() { return iterator(this, capacity_); }
+    const_iterator begin() const { return const_iterator(this, next_full(0)); }
+    const_iterator end() const { return const_iterator(this, capacity_); }
+
+    iterator find(const K& key) {
+        return iterator(this, find_index(key));
+    }
+
+    const_iterator find(const K& key) const {
+        return const_iterator(this, find_index(key));
+    }
+
+    bool contains(const K& key) const {
+        return find_index(key) != capacity_;
+    }
+
+    size_t count(const K& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    V& at(const K& key) {
+        size_t index = find_index(key);
+        if (index == capacity_)
+            throw std::out_of_range("FlatHashMap::at key not found");
+        return slot(index)->second;
+    }
+
+    const V& at(const K& key) const {
+        size_t index = find_index(key);
+        if (index == capacity_)
+            throw std::out_of_range("FlatHashMap::at key not found");
+        return slot(index)->second;
+    }
+
+    V& operator[](const K& key) {
+        return try_emplace(key).first->second;
+    }
+
+    /*
+     * Inserts (key, V(args...)) if key is not present; args are unused
+     * otherwise.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+        const size_t hash = hash_of(key);
+        size_t index = find_index(key, hash);
+        if (index != capacity_)
+            return {iterator(this, index), false};
+        index = insert_unique(hash, std::piecewise_construct, std::forward_as_tuple(key),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+        return {iterator(this, index), true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type& entry) {
+        return try_emplace(entry.first, entry.second);
+    }
+
+    template <typename U>
+    std::pair<iterator, bool> insert_or_assign(const K& key, U&& value) {
+        std::pair<iterator, bool> result = try_emplace(key, std::forward<U>(value));
+        if (!result.second)
+            result.first->second = std::forward<U>(value);
+        return result;
+    }
+
+    size_t erase(const K& key) {
+        size_t index = find_index(key);
+        if (index == capacity_)
+            return 0;
+        erase_index(index);
+        return 1;
+    }
+
+    void erase(const_iterator it) {
+        erase_index(it.index_);
+    }
+
+    void clear() {
+        for (size_t i = 0; i < capacity_; i++) {
+            if (is_full(ctrl_[i]))
+                slot(i)->~value_type();
+        }
+        if (capacity_ > 0)
+            std::memset(ctrl_, empty_byte, capacity_);
+        size_ = 0;
+        growth_left_ = max_load(capacity_);
+    }
+
+    /*
+     * Grows the table to hold count entries without rehashing. Throws in
+     * fixed capacity mode if that needs more slots.
+     */
+    void reserve(size_t count) {
+        if (count > max_load(capacity_)) {
+            if (fixed_capacity_)
+                throw std::length_error("FlatHashMap is at its fixed capacity");
+            rehash(capacity_for(count));
+        }
+    }
+
+private:
+    using Group = detail::ControlGroup;
+    using SlotType = std::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
+
+    constexpr static size_t group_width = Group::width;
+    constexpr static int8_t empty_byte = static_cast<int8_t>(0x80);
+    constexpr static int8_t deleted_byte = static_cast<int8_t>(0xfe);
+
+    static bool is_full(int8_t ctrl) { return ctrl >= 0; }
+
+    static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7f); }
+    static size_t h1(size_t hash) { return hash >> 7; }
+
+    constexpr static size_t max_load(size_t capacity) { return capacity - capacity / 8; }
+
+    /*
+     * Smallest power of two number of slots, at least one group, which holds
+     * count entries.
+     */
+    static size_t capacity_for(size_t count) {
+        size_t capacity = group_width;
+        while (max_load(capacity) < count) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    size_t hash_of(const K& key) const { return Hash()(key); }
+
+    value_type* slot(size_t i) { return std::launder(reinterpret_cast<value_type*>(&slots_[i])); }
+    const value_type* slot(size_t i) const { return std::launder(reinterpret_cast<const value_type*>(&slots_[i])); }
+
+    /*
+     * Visits groups in triangular order, which reaches every group of a power
+     * of two table.
+     */
+    class ProbeSequence {
+    public:
+        ProbeSequence(size_t hash, size_t n_groups)
+            : mask_(n_groups - 1), group_(hash & mask_), step_(0)
+        {}
+
+        size_t offset() const { return group_ * group_width; }
+
+        void next() {
+            step_++;
+            group_ = (group_ + step_) & mask_;
+        }
+
+    private:
+        size_t mask_;
+        size_t group_;
+        size_t step_;
+    };
+
+    size_t find_index(const K& key) const {
+        return find_index(key, hash_of(key));
+    }
+
+    size_t find_index(const K& key, size_t hash) const {
+        if (capacity_ == 0)
+            return capacity_;
+
+        ProbeSequence probe(h1(hash), capacity_ / group_width);
+        for (size_t i = 0; i < capacity_ / group_width; i++) {
+            const Group group(ctrl_ + probe.offset());
+            for (uint32_t match = group.match(h2(hash)); match != 0; match &= match - 1) {
+                const size_t index = probe.offset() + static_cast<size_t>(__builtin_ctz(match));
+                if (KeyEqual()(slot(index)->first, key))
+                    return index;
+            }
+            if (group.match(empty_byte) != 0)
+                return capacity_;
+            probe.next();
+        }
+        return capacity_;
+    }
+
+    /*
+     * First empty or deleted slot on the probe sequence of hash.
+     */
+    size_t find_available(size_t hash) const {
+        ProbeSequence probe(h1(hash), capacity_ / group_width);
+        while (true) {
+            const uint32_t available = Group(ctrl_ + probe.offset()).match_available();
+            if (available != 0)
+                return probe.offset() + static_cast<size_t>(__builtin_ctz(available));
+            probe.next();
+        }
+    }
+
+    /*
+     * Constructs an entry for a key known not to be present.
+     */
+    template <typename... Args>
+    size_t insert_unique(size_t hash, Args&&... args) {
+        if (capacity_ == 0)
+            allocate(capacity_for(1));
+
+        size_t index = find_available(hash);
+        if (growth_left_ == 0 && ctrl_[index] != deleted_byte) {
+            make_room();
+            index = find_available(hash);
+        }
+
+        new (&slots_[index]) value_type(std::forward<Args>(args)...);
+        if (ctrl_[index] == empty_byte)
+            growth_left_--;
+        ctrl_[index] = h2(hash);
+        size_++;
+        return index;
+    }
+
+    /*
+     * Called when no empty slot may be used up: either clears out tombstones
+     * in place, or grows.
+     */
+    void make_room() {
+        if (size_ < max_load(capacity_) && (fixed_capacity_ || size_ <= capacity_ * 25 / 32)) {
+            drop_deleted();
+        } else if (fixed_capacity_) {
+            throw std::length_error("FlatHashMap is at its fixed capacity");
+        } else {
+            rehash(capacity_ * 2);
+        }
+    }
+
+    void erase_index(size_t index) {
+        slot(index)->~value_type();
+        size_--;
+
+        // A probe only goes past a group without empty slots, so if this group
+        // has one no probe for another key goes through it: no tombstone needed
+        const size_t group_offset = index / group_width * group_width;
+        if (Group(ctrl_ + group_offset).match(empty_byte) != 0) {
+            ctrl_[index] = empty_byte;
+            growth_left_++;
+        } else {
+            ctrl_[index] = deleted_byte;
+        }
+    }
+
+    size_t next_full(size_t index) const {
+        while (index < capacity_ && !is_full(ctrl_[index])) {
+            index++;
+        }
+        return index;
+    }
+
+    void allocate(size_t capacity) {
+        ctrl_ = static_cast<int8_t*>(::operator new(capacity));
+        std::memset(ctrl_, empty_byte, capacity);
+        slots_ = static_cast<SlotType*>(::operator new(capacity * sizeof(SlotType), std::align_val_t(alignof(SlotType))));
+        capacity_ = capacity;
+        growth_left_ = max_load(capacity);
+    }
+
+    void deallocate() {
+        if (capacity_ == 0)
+            return;
+        ::operator delete(ctrl_);
+        ::operator delete(slots_, std::align_val_t(alignof(SlotType)));
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = 0;
+        growth_left_ = 0;
+    }
+
+    void rehash(size_t capacity) {
+        Self grown;
+        grown.allocate(capacity);
+        for (size_t i = 0; i < capacity_; i++) {
+            if (is_full(ctrl_[i])) {
+                grown.insert_unique(hash_of(slot(i)->first), std::move(*slot(i)));
+            }
+        }
+        grown.fixed_capacity_ = fixed_capacity_;
+        swap(grown);
+    }
+
+    /*
+     * Rehashes in place, turning tombstones back into empty slots without
+     * allocating: full slots are marked deleted, then each is moved to the
+     * first available slot of its probe sequence, swapping with a not yet
+     * placed entry if that slot holds one.
+     */
+    void drop_deleted() {
+        for (size_t i = 0; i < capacity_; i++) {
+            ctrl_[i] = is_full(ctrl_[i]) ? deleted_byte : empty_byte;
+        }
+
+        for (size_t i = 0; i < capacity_; i++) {
+            if (ctrl_[i] != deleted_byte)
+                continue;
+
+            const size_t hash = hash_of(slot(i)->first);
+            const size_t target = find_available(hash);
+            if (target / group_width == i / group_width) {
+                ctrl_[i] = h2(hash);
+            } else if (ctrl_[target] == empty_byte) {
+                new (&slots_[target]) value_type(std::move(*slot(i)));
+                slot(i)->~value_type();
+                ctrl_[target] = h2(hash);
+                ctrl_[i] = empty_byte;
+            } else {
+                value_type temp(std::move(*slot(target)));
+                slot(target)->~value_type();
+                new (&slots_[target]) value_type(std::move(*slot(i)));
+                slot(i)->~value_type();
+                new (&slots_[i]) value_type(std::move(temp));
+                ctrl_[target] = h2(hash);
+                i--;
+            }
+        }
+        growth_left_ = max_load(capacity_) - size_;
+    }
+
+    int8_t* ctrl_ = nullptr;
+    SlotType* slots_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    size_t growth_left_ = 0;
+    bool fixed_capacity_;
+};
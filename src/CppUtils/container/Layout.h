@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+/*
+ * Memory layout constants shared by the concurrent containers and handles.
+ */
+namespace layout {
+
+/*
+ * Alignment which keeps data written by different threads on different cache
+ * lines, avoiding false sharing.
+ */
+constexpr size_t cache_line_size = 64;
+
+constexpr size_t next_power_of_two(size_t n) {
+    size_t result = 1;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Layout.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Bounded multi-producer / multi-consumer queue (Dmitry Vyukov's design).
+ *
+ * Each cell carries a sequence number which tells producers and consumers
+ * whether it is free for the current lap, so a push or pop is one CAS on the
+ * shared position plus uncontended accesses to the cell. try_push / try_pop
+ * never block, they fail when the queue is full / empty.
+ *
+ * The capacity is rounded up to a power of two and allocated once.
+ */
+template <typename T>
+class MpmcQueue {
+public:
+    using Type = T;
+
+    explicit MpmcQueue(size_t capacity)
+        : capacity_(layout::next_power_of_two(std::max<size_t>(capacity, 2))),
+          mask_(capacity_ - 1),
+          cells_(new Cell[capacity_])
+    {
+        for (size_t i = 0; i < capacity_; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /*
+     * Must not run concurrently with pushes or pops. Remaining elements are
+     * destroyed in place, so T needn't be default constructible.
+     */
+    ~MpmcQueue() {
+        const size_t end = enqueue_pos_.load(std::memory_order_relaxed);
+        for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != end; pos++) {
+            std::launder(reinterpret_cast<T*>(&cells_[pos & mask_].storage))->~T();
+        }
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    /*
+     * Approximate when called concurrently.
+     */
+    size_t size() const {
+        const size_t head = enqueue_pos_.load(std::memory_order_relaxed);
+        const size_t tail = dequeue_pos_.load(std::memory_order_relaxed);
+        return head >= tail ? head - tail : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    bool try_push(const T& x) { return try_emplace(x); }
+    bool try_push(T&& x) { return try_emplace(std::move(x)); }
+
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        Cell* cell;
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (&cell->storage) T(std::forward<Args>(args)...);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& x) {
+        Cell* cell;
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* value = std::launder(reinterpret_cast<T*>(&cell->storage));
+        x = std::move(*value);
+        value->~T();
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+    };
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(layout::cache_line_size) std::atomic<size_t> enqueue_pos_{0};
+    alignas(layout::cache_line_size) std::atomic<size_t> dequeue_pos_{0};
+};
@@ -0,0 +1,308 @@
+#pragma once
+
+#include "Span.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Vector which stores up to N elements inline, in the object itself, and only
+ * allocates once it grows beyond that.
+ *
+ * Moving a SmallVector which has spilled to the heap steals the allocation;
+ * moving an inline one moves its elements. Moves are noexcept when T's move
+ * constructor is, so containers of SmallVectors move them on reallocation.
+ * Converts implicitly to Span.
+ */
+template <typename T, size_t N>
+class SmallVector {
+public:
+    using Type = T;
+    using Self = SmallVector<T,N>;
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    constexpr static size_t inline_capacity = N;
+
+    SmallVector()
+        : data_(inline_data()), size_(0), capacity_(N)
+    {}
+
+    explicit SmallVector(size_t count)
+        : SmallVector()
+    {
+        resize(count);
+    }
+
+    SmallVector(size_t count, const T& value)
+        : SmallVector()
+    {
+        resize(count, value);
+    }
+
+    template <typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    SmallVector(Iterator first, Iterator last)
+        : SmallVector()
+    {
+        assign(first, last);
+    }
+
+    SmallVector(std::initializer_list<T> values)
+        : SmallVector(values.begin(), values.end())
+    {}
+
+    SmallVector(const Self& other)
+        : SmallVector(other.begin(), other.end())
+    {}
+
+    SmallVector(Self&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : SmallVector()
+    {
+        take(std::move(other));
+    }
+
+    Self& operator=(const Self& other) {
+        if (this != &other)
+            assign(other.begin(), other.end());
+        return *this;
+    }
+
+    Self& operator=(Self&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            take(std::move(other));
+        }
+        return *this;
+    }
+
+    Self& operator=(std::initializer_list<T> values) {
+        assign(values.begin(), values.end());
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        deallocate();
+    }
+
+    template <typename Iterator>
+    void assign(Iterator first, Iterator last) {
+        clear();
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>) {
+            reserve(static_cast<size_t>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    // ----- access
+
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+
+    T& at(size_t i) {
+        if (i >= size_)
+            throw std::out_of_range("SmallVector::at index out of range");
+        return data_[i];
+    }
+
+    const T& at(size_t i) const {
+        if (i >= size_)
+            throw std::out_of_range("SmallVector::at index out of range");
+        return data_[i];
+    }
+
+    T& front() { return data_[0]; }
+    const T& front() const { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    Span<T> span() { return Span<T>(data_, size_); }
+    Span<const T> span() const { return Span<const T>(data_, size_); }
+
+    operator Span<T>() { return span(); }
+    operator Span<const T>() const { return span(); }
+
+    // ----- capacity
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    /*
+     * True while the elements are stored in the object itself.
+     */
+    bool is_inline() const { return data_ == inline_data(); }
+
+    void reserve(size_t capacity) {
+        if (capacity > capacity_)
+            reallocate(capacity);
+    }
+
+    /*
+     * Moves the elements back inline if they fit, else shrinks the
+     * allocation to size().
+     */
+    void shrink_to_fit() {
+        if (!is_inline() && size_ < capacity_)
+            reallocate(size_);
+    }
+
+    // ----- modifiers
+
+    void clear() {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            // args may alias an element, construct before moving the storage
+            T value(std::forward<Args>(args)...);
+            reallocate(grown_capacity(size_ + 1));
+            return *new (data_ + size_++) T(std::move(value));
+        }
+        return *new (data_ + size_++) T(std::forward<Args>(args)...);
+    }
+
+    void pop_back() {
+        data_[--size_].~T();
+    }
+
+    /*
+     * Appends count elements copied from values, which must not point into
+     * this vector.
+     */
+    void append(const T* values, size_t count) {
+        if (size_ + count > capacity_)
+            reallocate(grown_capacity(size_ + count));
+        std::uninitialized_copy(values, values + count, data_ + size_);
+        size_ += count;
+    }
+
+    void append(Span<const T> values) {
+        append(values.data(), values.size());
+    }
+
+    void resize(size_t count) {
+        resize_impl(count, [] (T* p) { new (p) T(); });
+    }
+
+    void resize(size_t count, const T& value) {
+        resize_impl(count, [&value] (T* p) { new (p) T(value); });
+    }
+
+    iterator erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        T* dest = data_ + (first - data_);
+        T* src = data_ + (last - data_);
+        T* new_end = std::move(src, end(), dest);
+        std::destroy(new_end, end());
+        size_ = static_cast<size_t>(new_end - data_);
+        return dest;
+    }
+
+    bool operator==(const Self& other) const {
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+
+    bool operator!=(const Self& other) const { return !(*this == other); }
+
+private:
+    T* inline_data() { return reinterpret_cast<T*>(&inline_); }
+    const T* inline_data() const { return reinterpret_cast<const T*>(&inline_); }
+
+    size_t grown_capacity(size_t required) const {
+        return std::max(required, capacity_ * 2);
+    }
+
+    template <typename Construct>
+    void resize_impl(size_t count, Construct construct) {
+        if (count < size_) {
+            std::destroy(data_ + count, data_ + size_);
+        } else if (count > size_) {
+            reserve(count);
+            for (size_t i = size_; i < count; i++) {
+                construct(data_ + i);
+            }
+        }
+        size_ = count;
+    }
+
+    /*
+     * Moves the elements to storage of the given capacity, inline if it fits.
+     */
+    void reallocate(size_t capacity) {
+        T* new_data = capacity <= N
+            ? inline_data()
+            : static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t(alignof(T))));
+        if (new_data == data_)
+            return;
+
+        try {
+            std::uninitialized_move(data_, data_ + size_, new_data);
+        } catch (...) {
+            if (new_data != inline_data())
+                ::operator delete(new_data, std::align_val_t(alignof(T)));
+            throw;
+        }
+        std::destroy(data_, data_ + size_);
+        deallocate();
+        data_ = new_data;
+        capacity_ = std::max(capacity, N);
+    }
+
+    void deallocate() {
+        if (!is_inline())
+            ::operator delete(data_, std::align_val_t(alignof(T)));
+        data_ = inline_data();
+        capacity_ = N;
+    }
+
+    /*
+     * Takes other's elements; this must be empty. Doesn't allocate, since an
+     * inline other always fits in this vector's storage.
+     */
+    void take(Self&& other) {
+        if (other.is_inline()) {
+            reserve(other.size_);
+            std::uninitialized_move(other.begin(), other.end(), data_);
+            size_ = other.size_;
+            other.clear();
+        } else {
+            deallocate();
+            data_ = std::exchange(other.data_, other.inline_data());
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, N);
+        }
+    }
+
+    T* data_;
+    size_t size_;
+    size_t capacity_;
+    std::aligned_storage_t<sizeof(T) * (N > 0 ? N : 1), alignof(T)> inline_;
+};
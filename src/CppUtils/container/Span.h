@@ -0,0 +1,138 @@
+#pragma once
+
+#include "ArrayView.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Non-owning view of a contiguous array whose size is only known at run time.
+ *
+ * Complements ArrayView, which carries its size in the type. Converts
+ * implicitly from ArrayView, std::array, std::vector and C arrays, and from
+ * Span<U> to Span<const U>.
+ */
+template <typename T>
+class Span {
+    template <typename U>
+    using enable_if_convertible = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>, bool>;
+
+public:
+    using Type = T;
+    using Self = Span<T>;
+
+    constexpr static size_t npos = static_cast<size_t>(-1);
+
+    constexpr Span()
+        : data_(nullptr), size_(0)
+    {}
+
+    constexpr Span(T* data, size_t size)
+        : data_(data), size_(size)
+    {}
+
+    template <typename U, size_t N, enable_if_convertible<U> = true>
+    constexpr Span(U (&arr)[N])
+        : data_(arr), size_(N)
+    {}
+
+    template <typename U, size_t N, enable_if_convertible<U> = true>
+    Span(ArrayView<U,N> arr)
+        : data_(arr.data()), size_(N)
+    {}
+
+    template <typename U, size_t N, enable_if_convertible<U> = true>
+    constexpr Span(std::array<U,N>& arr)
+        : data_(arr.data()), size_(N)
+    {}
+
+    template <typename U, size_t N, enable_if_convertible<const U> = true>
+    constexpr Span(const std::array<U,N>& arr)
+        : data_(arr.data()), size_(N)
+    {}
+
+    template <typename U, typename Alloc, enable_if_convertible<U> = true>
+    Span(std::vector<U, Alloc>& vec)
+        : data_(vec.data()), size_(vec.size())
+    {}
+
+    template <typename U, typename Alloc, enable_if_convertible<const U> = true>
+    Span(const std::vector<U, Alloc>& vec)
+        : data_(vec.data()), size_(vec.size())
+    {}
+
+    template <typename U, enable_if_convertible<U> = true>
+    constexpr Span(const Span<U>& other)
+        : data_(other.data()), size_(other.size())
+    {}
+
+    constexpr T& operator[](size_t i) const {
+        return data_[i];
+    }
+
+    constexpr T* data() const { return data_; }
+    constexpr size_t size() const { return size_; }
+    constexpr size_t size_bytes() const { return size_ * sizeof(T); }
+    constexpr bool empty() const { return size_ == 0; }
+
+    constexpr T* begin() const { return data_; }
+    constexpr T* end() const { return data_ + size_; }
+
+    T& front() const { return data_[0]; }
+    T& back() const { return data_[size_ - 1]; }
+
+    /*
+     * View of count elements starting at offset, or of everything after
+     * offset if count is npos.
+     */
+    Self subspan(size_t offset, size_t count = npos) const {
+        if (offset > size_)
+            throw std::out_of_range("Span::subspan offset out of range");
+        if (count == npos)
+            count = size_ - offset;
+        if (count > size_ - offset)
+            throw std::out_of_range("Span::subspan count out of range");
+        return Self(data_ + offset, count);
+    }
+
+    Self first(size_t count) const {
+        return subspan(0, count);
+    }
+
+    Self last(size_t count) const {
+        if (count > size_)
+            throw std::out_of_range("Span::last count out of range");
+        return Self(data_ + size_ - count, count);
+    }
+
+    /*
+     * Fixed size view of the first N elements.
+     */
+    template <size_t N>
+    ArrayView<T,N> first() const {
+        if (N > size_)
+            throw std::out_of_range("Span::first count out of range");
+        return ArrayView<T,N>(data_);
+    }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+/*
+ * Views the object representation of a span.
+ */
+template <typename T>
+Span<const uint8_t> as_bytes(Span<T> span) {
+    return Span<const uint8_t>(reinterpret_cast<const uint8_t*>(span.data()), span.size_bytes());
+}
+
+template <typename T, std::enable_if_t<!std::is_const_v<T>, bool> = true>
+Span<uint8_t> as_writable_bytes(Span<T> span) {
+    return Span<uint8_t>(reinterpret_cast<uint8_t*>(span.data()), span.size_bytes());
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+#include "Layout.h"
+#include "Span.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+/*
+ * Lock-free single-producer / single-consumer ring buffer.
+ *
+ * One thread may call the producer side (push, reserve_write, commit_write)
+ * and one other thread the consumer side (pop, reserve_read, commit_read).
+ * The capacity is rounded up to a power of two and allocated once, at
+ * construction.
+ *
+ * The read and write indices live on separate cache lines, and each side
+ * keeps a cached copy of the other side's index so the shared line is only
+ * reloaded when the cached value says the buffer is full / empty.
+ *
+ * Either side may close() the buffer to signal the end of the stream.
+ *
+ * A side which would rather sleep than spin when the buffer is empty / full
+ * waits with wait_readable / wait_writable; the other side then calls
+ * notify_readable / notify_writable after committing, which only takes a
+ * lock when someone is asleep.
+ */
+template <typename T>
+class SpscRingBuffer {
+    static_assert(std::is_trivially_copyable_v<T>);
+public:
+    using Type = T;
+
+    explicit SpscRingBuffer(size_t capacity)
+        : capacity_(layout::next_power_of_two(std::max<size_t>(capacity, 1))),
+          mask_(capacity_ - 1),
+          data_(new T[capacity_])
+    {}
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    size_t capacity() const { return capacity_; }
+
+    /*
+     * Approximate when called concurrently with either side.
+     */
+    size_t size() const {
+        return write_.index.load(std::memory_order_acquire) - read_.index.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        notify(readers_);
+        notify(writers_);
+    }
+
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+    // ----- producer
+
+    bool try_push(const T& x) {
+        return push(&x, 1) == 1;
+    }
+
+    /*
+     * Pushes up to N elements, returns the number pushed.
+     */
+    size_t push(const T* xs, size_t N) {
+        size_t total = 0;
+        while (total < N) {
+            Span<T> region = reserve_write(N - total);
+            if (region.empty())
+                break;
+            std::copy(xs + total, xs + total + region.size(), region.data());
+            commit_write(region.size());
+            total += region.size();
+        }
+        return total;
+    }
+
+    /*
+     * Contiguous free region of at most max_size elements, which may be
+     * filled in place and then published with commit_write. Empty if the
+     * buffer is full. The region stops at the end of the storage, so a second
+     * reserve may be needed to use all free space.
+     */
+    Span<T> reserve_write(size_t max_size = Span<T>::npos) {
+        const size_t head = write_.index.load(std::memory_order_relaxed);
+        if (head - write_.cached_other == capacity_) {
+            write_.cached_other = read_.index.load(std::memory_order_acquire);
+        }
+        const size_t free = capacity_ - (head - write_.cached_other);
+        const size_t offset = head & mask_;
+        const size_t count = std::min({free, capacity_ - offset, max_size});
+        return Span<T>(data_.get() + offset, count);
+    }
+
+    void commit_write(size_t N) {
+        write_.index.store(write_.index.load(std::memory_order_relaxed) + N, std::memory_order_release);
+    }
+
+    // ----- consumer
+
+    bool try_pop(T& x) {
+        return pop(&x, 1) == 1;
+    }
+
+    /*
+     * Pops up to N elements, returns the number popped.
+     */
+    size_t pop(T* xs, size_t N) {
+        size_t total = 0;
+        while (total < N) {
+            Span<const T> region = reserve_read(N - total);
+            if (region.empty())
+                break;
+            std::copy(region.begin(), region.end(), xs + total);
+            commit_read(region.size());
+            total += region.size();
+        }
+        return total;
+    }
+
+    /*
+     * Contiguous readable region of at most max_size elements, released with
+     * commit_read. Empty if the buffer is empty.
+     */
+    Span<const T> reserve_read(size_t max_size = Span<T>::npos) {
+        const size_t tail = read_.index.load(std::memory_order_relaxed);
+        if (tail == read_.cached_other) {
+            read_.cached_other = write_.index.load(std::memory_order_acquire);
+        }
+        const size_t available = read_.cached_other - tail;
+        const size_t offset = tail & mask_;
+        const size_t count = std::min({available, capacity_ - offset, max_size});
+        return Span<const T>(data_.get() + offset, count);
+    }
+
+    void commit_read(size_t N) {
+        read_.index.store(read_.index.load(std::memory_order_relaxed) + N, std::memory_order_release);
+    }
+
+    // ----- blocking
+
+    /*
+     * Waits until there is data to read or the buffer is closed, spinning
+     * briefly before sleeping. Returns false if the deadline passes first.
+     */
+    template <typename Clock, typename Duration>
+    bool wait_readable(const std::chrono::time_point<Clock, Duration>& deadline) {
+        return wait(readers_, deadline, [this] { return closed() || !empty(); });
+    }
+
+    /*
+     * Waits until there is space to write or the buffer is closed.
+     */
+    template <typename Clock, typename Duration>
+    bool wait_writable(const std::chrono::time_point<Clock, Duration>& deadline) {
+        return wait(writers_, deadline, [this] { return closed() || size() < capacity_; });
+    }
+
+    void notify_readable() { notify(readers_); }
+    void notify_writable() { notify(writers_); }
+
+private:
+    // Checks of the buffer before a waiting side goes to sleep
+    constexpr static size_t spin_count = 128;
+
+    struct Sleepers {
+        std::atomic<uint32_t> waiting{0};
+        std::mutex mutex;
+        std::condition_variable wake;
+    };
+
+    template <typename Clock, typename Duration, typename Ready>
+    bool wait(Sleepers& sleepers, const std::chrono::time_point<Clock, Duration>& deadline, Ready&& ready) {
+        for (size_t i = 0; i < spin_count; i++) {
+            if (ready())
+                return true;
+        }
+
+        // Announce the waiter before checking again under the lock; notify()
+        // checks in the opposite order, so either we see the update or it
+        // sees us and takes the lock to wake us
+        std::unique_lock<std::mutex> lock(sleepers.mutex);
+        sleepers.waiting.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool result = true;
+        if (deadline == std::chrono::time_point<Clock, Duration>::max())
+            sleepers.wake.wait(lock, ready);
+        else
+            result = sleepers.wake.wait_until(lock, deadline, ready);
+        sleepers.waiting.fetch_sub(1, std::memory_order_relaxed);
+        return result;
+    }
+
+    void notify(Sleepers& sleepers) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.waiting.load(std::memory_order_relaxed) != 0) {
+            std::lock_guard<std::mutex> lock(sleepers.mutex);
+            sleepers.wake.notify_all();
+        }
+    }
+
+    /*
+     * Index owned by one side, plus that side's last view of the other
+     * side's index.
+     */
+    struct alignas(layout::cache_line_size) Cursor {
+        std::atomic<size_t> index{0};
+        size_t cached_other = 0;
+    };
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> data_;
+
+    Cursor write_;
+    Cursor read_;
+    alignas(layout::cache_line_size) std::atomic<bool> closed_{false};
+    Sleepers readers_;
+    Sleepers writers_;
+};
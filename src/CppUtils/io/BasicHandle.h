@@ -9,6 +9,12 @@ enum class OpenMode {
     ReadWrite
 };
 
+enum class SeekOrigin {
+    Begin,
+    Current,
+    End
+};
+
 class BasicHandle {
 public:
     BasicHandle()
@@ -2,13 +2,14 @@
 
 #include "BinaryReader.h"
 #include "BinaryWriter.h"
+#include "RandomAccess.h"
 
 template <typename T>
 class BinaryReaderWriterTemplate : public T, public BinaryReader, public BinaryWriter {
 public:
     template <typename... Args>
     BinaryReaderWriterTemplate(Args&&... args)
-        : T(std::forward<Args>(args)...), BinaryWriter(), BinaryReader()
+        : T(std::forward<Args>(args)...), BinaryReader(), BinaryWriter()
     {}
 
     virtual ~BinaryReaderWriterTemplate() {}
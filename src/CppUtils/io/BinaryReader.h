@@ -1,7 +1,10 @@
 #pragma once
 
+#include "CppUtils/container/Span.h"
+
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 class BinaryReader {
 public:
@@ -23,17 +26,36 @@ public:
         this->read_impl((uint8_t*) buffer, sizeof(T) * N);
     }
 
+    template <typename T>
+    void read(Span<T> buffer) {
+        read(buffer.data(), buffer.size());
+    }
+
     template <typename T>
     void read_buffer(T& buffer) {
         read(buffer.data(), buffer.size());
     }
 
+    template <typename T>
+    void read_buffer(Span<T> buffer) {
+        read(buffer.data(), buffer.size());
+    }
+
     template <typename T>
     std::string read_string(T& buffer) {
         read_buffer(buffer);
         return std::string(buffer.data(), buffer.size());
     }
 
+    /*
+     * Like read_string, without copying: the view points into buffer.
+     */
+    template <typename T>
+    std::string_view read_string_view(T& buffer) {
+        read_buffer(buffer);
+        return std::string_view(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(*buffer.data()));
+    }
+
     // ----- variable length reading
     // returns the length of data read; may be smaller than buffer size
 
@@ -47,11 +69,21 @@ public:
         return this->var_read_impl((uint8_t*) buffer, sizeof(T) * N);
     }
 
+    template <typename T>
+    size_t var_read(Span<T> buffer) {
+        return var_read(buffer.data(), buffer.size());
+    }
+
     template <typename T>
     size_t var_read_buffer(T& buffer) {
         return var_read(buffer.data(), buffer.size());
     }
 
+    template <typename T>
+    size_t var_read_buffer(Span<T> buffer) {
+        return var_read(buffer.data(), buffer.size());
+    }
+
 protected:
     virtual void read_impl(uint8_t* buffer, size_t N) = 0;
     virtual size_t var_read_impl(uint8_t* buffer, size_t N) = 0;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "CppUtils/container/Span.h"
+
 #include <cstdint>
 #include <string>
 
@@ -24,11 +26,21 @@ public:
         write(buffer, N);
     }
 
+    template <typename T>
+    void write(Span<T> buffer) {
+        write(buffer.data(), buffer.size());
+    }
+
     template <typename T>
     void write_buffer(const T& buffer) {
         write(buffer.data(), buffer.size());
     }
 
+    template <typename T>
+    void write_buffer(Span<T> buffer) {
+        write(buffer.data(), buffer.size());
+    }
+
 protected:
     virtual void write_impl(const uint8_t* buffer, size_t N) = 0;
 };
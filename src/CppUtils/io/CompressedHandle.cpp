@@ -0,0 +1,218 @@
+#include "CompressedHandle.h"
+#include "IOUtils.h"
+#include "LzCodec.h"
+#include "Serialization.h"
+
+#include "CppUtils/concurrency/ThreadPool.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Upper bound on a block the reader accepts, so a corrupt header can't make
+// it allocate gigabytes
+constexpr uint32_t max_block_size = 64 * 1024 * 1024;
+
+detail::CompressedBlock compress_block(std::vector<uint8_t> raw) {
+    detail::CompressedBlock block;
+    block.raw_size = static_cast<uint32_t>(raw.size());
+    block.data.resize(lz_compress_bound(raw.size()));
+    const size_t size = lz_compress(raw.data(), raw.size(), block.data.data());
+    if (size < raw.size()) {
+        block.data.resize(size);
+        block.stored_size = static_cast<uint32_t>(size);
+    } else {
+        block.data = std::move(raw);
+        block.stored_size = block.raw_size | detail::block_stored_raw;
+    }
+    return block;
+}
+
+}
+
+// ----- CompressingHandle
+
+CompressingHandle::CompressingHandle()
+    : BasicHandle(), sink_(nullptr), block_size_(default_block_size), pool_(nullptr)
+{}
+
+CompressingHandle::CompressingHandle(BinaryWriter& sink, size_t block_size, ThreadPool* pool)
+    : CompressingHandle()
+{
+    open(sink, block_size, pool);
+}
+
+CompressingHandle::~CompressingHandle() {
+    try {
+        close();
+    } catch (...) {
+        // Errors are only reported by an explicit close()
+    }
+}
+
+void CompressingHandle::open(BinaryWriter& sink, size_t block_size, ThreadPool* pool) {
+    if (block_size == 0 || block_size > max_block_size)
+        throw std::runtime_error("Invalid compression block size " + std::to_string(block_size));
+
+    sink_ = &sink;
+    block_size_ = block_size;
+    pool_ = pool;
+    block_.reserve(block_size_);
+}
+
+bool CompressingHandle::good() const {
+    return sink_ != nullptr;
+}
+
+void CompressingHandle::close() {
+    if (good()) {
+        try {
+            flush();
+            write_block(detail::CompressedBlock{{}, 0, 0});
+        } catch (...) {
+            release();
+            throw;
+        }
+        sink_ = nullptr;
+    }
+}
+
+void CompressingHandle::release() {
+    // Pending compressions own their data, their results are just dropped
+    in_flight_.clear();
+    block_.clear();
+    sink_ = nullptr;
+}
+
+void CompressingHandle::flush() {
+    if (!block_.empty())
+        submit_block();
+    drain(0);
+}
+
+void CompressingHandle::_write(const uint8_t* buffer, size_t N) {
+    while (N > 0) {
+        const size_t n = std::min(N, block_size_ - block_.size());
+        block_.insert(block_.end(), buffer, buffer + n);
+        buffer += n;
+        N -= n;
+
+        if (block_.size() == block_size_)
+            submit_block();
+    }
+}
+
+void CompressingHandle::submit_block() {
+    std::vector<uint8_t> raw;
+    raw.reserve(block_size_);
+    raw.swap(block_);
+
+    if (pool_ == nullptr) {
+        write_block(compress_block(std::move(raw)));
+        return;
+    }
+
+    in_flight_.push_back(pool_->submit(compress_block, std::move(raw)));
+    // Bounds the memory held by pending blocks
+    drain(2 * pool_->size());
+}
+
+void CompressingHandle::drain(size_t max_in_flight) {
+    while (in_flight_.size() > max_in_flight) {
+        detail::CompressedBlock block = in_flight_.front().get();
+        in_flight_.pop_front();
+        write_block(block);
+    }
+}
+
+void CompressingHandle::write_block(const detail::CompressedBlock& block) {
+    write_serialized(*sink_, block.stored_size);
+    write_serialized(*sink_, block.raw_size);
+    sink_->write(block.data.data(), block.data.size());
+}
+
+// ----- DecompressingHandle
+
+DecompressingHandle::DecompressingHandle()
+    : BasicHandle(), source_(nullptr), position_(0), ended_(false)
+{}
+
+DecompressingHandle::DecompressingHandle(BinaryReader& source)
+    : DecompressingHandle()
+{
+    open(source);
+}
+
+DecompressingHandle::~DecompressingHandle() {
+    close();
+}
+
+void DecompressingHandle::open(BinaryReader& source) {
+    source_ = &source;
+    block_.clear();
+    position_ = 0;
+    ended_ = false;
+}
+
+bool DecompressingHandle::good() const {
+    return source_ != nullptr;
+}
+
+void DecompressingHandle::close() {
+    source_ = nullptr;
+}
+
+bool DecompressingHandle::next_block() {
+    uint32_t stored_size;
+    uint32_t raw_size;
+    read_serialized(*source_, stored_size);
+    read_serialized(*source_, raw_size);
+
+    if (raw_size == 0) {
+        ended_ = true;
+        return false;
+    }
+
+    const bool stored_raw = (stored_size & detail::block_stored_raw) != 0;
+    stored_size &= ~detail::block_stored_raw;
+    if (raw_size > max_block_size || stored_size > lz_compress_bound(raw_size))
+        throw std::runtime_error("Corrupt compressed block header");
+
+    block_.resize(raw_size);
+    position_ = 0;
+    if (stored_raw) {
+        if (stored_size != raw_size)
+            throw std::runtime_error("Corrupt compressed block header");
+        source_->read(block_.data(), raw_size);
+    } else {
+        compressed_.resize(stored_size);
+        source_->read(compressed_.data(), stored_size);
+        if (lz_decompress(compressed_.data(), stored_size, block_.data(), raw_size) != raw_size)
+            throw std::runtime_error("Compressed block is shorter than its header says");
+    }
+    return true;
+}
+
+void DecompressingHandle::_read(uint8_t* buffer, size_t N) {
+    detail::staggered_io(
+            [this] (uint8_t* xs, size_t n) {
+                return static_cast<int>(this->_var_read(xs, n));
+            },
+            buffer, N);
+}
+
+size_t DecompressingHandle::_var_read(uint8_t* buffer, size_t N) {
+    if (N == 0)
+        return 0;
+
+    while (position_ == block_.size()) {
+        if (ended_ || !next_block())
+            return 0;
+    }
+
+    const size_t n = std::min(N, block_.size() - position_);
+    std::memcpy(buffer, block_.data() + position_, n);
+    position_ += n;
+    return n;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "BasicHandle.h"
+
+#include <deque>
+#include <future>
+#include <vector>
+
+class ThreadPool;
+
+/*
+ * Compressed stream framing shared by the handles below. The stream is a
+ * sequence of blocks, each
+ *
+ *      [stored size : u32][raw size : u32][data]
+ *
+ * in little endian, where the top bit of the stored size marks a block kept
+ * uncompressed because compression didn't shrink it. A block with raw size 0
+ * ends the stream.
+ */
+namespace detail {
+
+constexpr uint32_t block_stored_raw = 0x80000000u;
+
+struct CompressedBlock {
+    std::vector<uint8_t> data;
+    uint32_t stored_size;
+    uint32_t raw_size;
+};
+
+}
+
+/*
+ * Write side: compresses everything written into independent blocks and
+ * writes them to another writer.
+ *
+ * With a ThreadPool, full blocks are compressed on the pool, a few at a time,
+ * and written in order as they complete. close() flushes the partial block and
+ * the end of stream marker, but doesn't close the underlying writer.
+ *
+ * Call close() explicitly while the sink is alive to see write errors; the
+ * destructor closes too but swallows them. If the sink may go away first,
+ * release() the handle, which drops unwritten data and never touches the sink
+ * again.
+ */
+class CompressingHandle : public BasicHandle {
+public:
+    constexpr static size_t default_block_size = 64 * 1024;
+
+    CompressingHandle();
+    CompressingHandle(BinaryWriter& sink, size_t block_size = default_block_size, ThreadPool* pool = nullptr);
+
+    virtual ~CompressingHandle();
+
+    void open(BinaryWriter& sink, size_t block_size = default_block_size, ThreadPool* pool = nullptr);
+    virtual bool good() const override;
+    virtual void close() override;
+
+    /*
+     * Detaches from the sink without writing anything more.
+     */
+    void release();
+
+    /*
+     * Compresses and writes the buffered partial block now.
+     */
+    void flush();
+
+protected:
+    BinaryWriter* sink_;
+    size_t block_size_;
+    ThreadPool* pool_;
+    std::vector<uint8_t> block_;
+    std::deque<std::future<detail::CompressedBlock> > in_flight_;
+
+    void _write(const uint8_t* buffer, size_t N);
+
+private:
+    void submit_block();
+    void write_block(const detail::CompressedBlock& block);
+    void drain(size_t max_in_flight);
+};
+
+/*
+ * Read side: reads blocks from another reader and decompresses them.
+ */
+class DecompressingHandle : public BasicHandle {
+public:
+    DecompressingHandle();
+    DecompressingHandle(BinaryReader& source);
+
+    virtual ~DecompressingHandle();
+
+    void open(BinaryReader& source);
+    virtual bool good() const override;
+    virtual void close() override;
+
+protected:
+    BinaryReader* source_;
+    std::vector<uint8_t> compressed_;
+    std::vector<uint8_t> block_;
+    size_t position_;
+    bool ended_;
+
+    void _read(uint8_t* buffer, size_t N);
+    size_t _var_read(uint8_t* buffer, size_t N);
+
+private:
+    bool next_block();
+};
+
+using CompressedWriter = BinaryWriterTemplate<CompressingHandle>;
+using CompressedReader = BinaryReaderTemplate<DecompressingHandle>;
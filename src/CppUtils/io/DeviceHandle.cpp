@@ -1,9 +1,12 @@
 #include "DeviceHandle.h"
 #include "IOUtils.h"
 
+#include <sys/stat.h>
 #include <unistd.h>
 #include <fcntl.h>
 
+#include <cerrno>
+
 
 DeviceHandle::DeviceHandle()
     : BasicHandle(), fd_(-1)
@@ -15,6 +18,12 @@ DeviceHandle::DeviceHandle(const std::string& filename, OpenMode mode)
     open(filename, mode);
 }
 
+DeviceHandle::DeviceHandle(const std::string& filename, OpenMode mode, OpenOptions options)
+    : DeviceHandle()
+{
+    open(filename, mode, options);
+}
+
 DeviceHandle::DeviceHandle(const std::string& filename, int mode)
     : DeviceHandle()
 {
@@ -26,20 +35,39 @@ DeviceHandle::~DeviceHandle() {
 }
 
 void DeviceHandle::open(const std::string& filename, OpenMode mode) {
+    open(filename, mode, OpenOptions());
+}
+
+void DeviceHandle::open(const std::string& filename, OpenMode mode, OpenOptions options) {
+    int flags = 0;
     switch (mode) {
         case OpenMode::Append:
-            open_raw(filename, O_WRONLY | O_CREAT | O_APPEND);
+            flags = O_WRONLY | O_CREAT | O_APPEND;
             break;
         case OpenMode::Truncate:
-            open_raw(filename, O_WRONLY | O_CREAT | O_TRUNC);
+            flags = O_WRONLY | O_CREAT | O_TRUNC;
             break;
         case OpenMode::Read:
-            open_raw(filename, O_RDONLY);
+            flags = O_RDONLY;
             break;
         case OpenMode::ReadWrite:
-            open_raw(filename, O_RDWR | O_CREAT);
+            flags = O_RDWR | O_CREAT;
             break;
     }
+
+    if (options.no_create)
+        flags &= ~O_CREAT;
+    if (options.direct)
+        flags |= O_DIRECT;
+    if (options.dsync)
+        flags |= O_DSYNC;
+
+    if (options.noatime) {
+        open_raw(filename, flags | O_NOATIME);
+        if (good() || errno != EPERM)
+            return;
+    }
+    open_raw(filename, flags);
 }
 
 void DeviceHandle::open_raw(const std::string& filename, int mode) {
@@ -58,6 +86,12 @@ void DeviceHandle::close() {
     }
 }
 
+void DeviceHandle::adopt(int fd) {
+    if (fd != fd_)
+        close();
+    fd_ = fd;
+}
+
 void DeviceHandle::_write(const uint8_t* buffer, size_t N) {
     detail::staggered_io(
             [fd = fd_] (const uint8_t* xs, size_t n) {
@@ -81,3 +115,70 @@ void DeviceHandle::_read(uint8_t* buffer, size_t N) {
             },
             buffer, N);
 }
+
+namespace {
+
+int seek_whence(SeekOrigin origin) {
+    switch (origin) {
+        case SeekOrigin::Current:
+            return SEEK_CUR;
+        case SeekOrigin::End:
+            return SEEK_END;
+        case SeekOrigin::Begin:
+        default:
+            return SEEK_SET;
+    }
+}
+
+}
+
+uint64_t DeviceHandle::seek(int64_t offset, SeekOrigin origin) {
+    off_t result = lseek(fd_, static_cast<off_t>(offset), seek_whence(origin));
+    if (result == -1)
+        throw std::runtime_error("Couldn't seek device file descriptor");
+    return static_cast<uint64_t>(result);
+}
+
+uint64_t DeviceHandle::tell() const {
+    off_t result = lseek(fd_, 0, SEEK_CUR);
+    if (result == -1)
+        throw std::runtime_error("Couldn't get device file descriptor position");
+    return static_cast<uint64_t>(result);
+}
+
+uint64_t DeviceHandle::size() const {
+    struct stat st;
+    if (fstat(fd_, &st) == -1)
+        throw std::runtime_error("Couldn't stat device file descriptor");
+    return static_cast<uint64_t>(st.st_size);
+}
+
+void DeviceHandle::_write_at(uint64_t offset, const uint8_t* buffer, size_t N) {
+    size_t total = 0;
+    detail::staggered_io(
+            [fd = fd_, offset, &total] (const uint8_t* xs, size_t n) {
+                ssize_t result = ::pwrite(fd, xs, n, static_cast<off_t>(offset + total));
+                if (result > 0)
+                    total += static_cast<size_t>(result);
+                return result;
+            },
+            buffer, N);
+}
+
+size_t DeviceHandle::_var_read_at(uint64_t offset, uint8_t* buffer, size_t N) {
+    ssize_t result = ::pread(fd_, buffer, N, static_cast<off_t>(offset));
+    if (result < 0)
+        throw std::runtime_error("Error while reading data from device file descriptor");
+    return static_cast<size_t>(result);
+}
+
+void DeviceHandle::_read_at(uint64_t offset, uint8_t* buffer, size_t N) {
+    size_t total = 0;
+    detail::staggered_io(
+            [this, offset, &total] (uint8_t* xs, size_t n) {
+                size_t result = this->_var_read_at(offset + total, xs, n);
+                total += result;
+                return static_cast<int>(result);
+            },
+            buffer, N);
+}
@@ -3,17 +3,56 @@
 #include "BasicHandle.h"
 #include <stdexcept>
 
+/*
+ * Extra open(2) flags for DeviceHandle::open.
+ *
+ * direct (O_DIRECT) bypasses the page cache; transfers must then use buffers,
+ * sizes and file offsets aligned to the device's logical block size (see
+ * DirectIOHandle). dsync (O_DSYNC) makes each write durable before it
+ * returns. noatime (O_NOATIME) skips access time updates on reads; it is
+ * dropped silently for files the process doesn't own. no_create drops the
+ * O_CREAT of the writing modes, so opening a missing path fails instead of
+ * creating a regular file, as device nodes need.
+ */
+struct OpenOptions {
+    bool direct = false;
+    bool dsync = false;
+    bool noatime = false;
+    bool no_create = false;
+};
+
 class DeviceHandle : public BasicHandle {
 public:
     DeviceHandle();
     DeviceHandle(const std::string& filename, OpenMode mode);
+    DeviceHandle(const std::string& filename, OpenMode mode, OpenOptions options);
 
     virtual ~DeviceHandle();
 
     void open(const std::string& filename, OpenMode mode);
+    void open(const std::string& filename, OpenMode mode, OpenOptions options);
     virtual bool good() const override;
     virtual void close() override;
 
+    int fd() const { return fd_; }
+
+    /*
+     * Takes ownership of an open descriptor, e.g. one received from another
+     * process; closes the current one.
+     */
+    void adopt(int fd);
+
+    /*
+     * Moves the file position, returning the new position from the start.
+     */
+    uint64_t seek(int64_t offset, SeekOrigin origin = SeekOrigin::Begin);
+    uint64_t tell() const;
+
+    /*
+     * Current size of the file.
+     */
+    uint64_t size() const;
+
 protected:
     int fd_;
 
@@ -23,8 +62,15 @@ protected:
     void _write(const uint8_t* buffer, size_t N);
     void _read(uint8_t* buffer, size_t N);
     size_t _var_read(uint8_t* buffer, size_t N);
+
+    void _write_at(uint64_t offset, const uint8_t* buffer, size_t N);
+    void _read_at(uint64_t offset, uint8_t* buffer, size_t N);
+    size_t _var_read_at(uint64_t offset, uint8_t* buffer, size_t N);
 };
 
 using DeviceWriter = BinaryWriterTemplate<DeviceHandle>;
 using DeviceReader = BinaryReaderTemplate<DeviceHandle>;
 using DeviceReaderWriter = BinaryReaderWriterTemplate<DeviceHandle>;
+using DeviceRandomReader = RandomAccessReaderTemplate<DeviceHandle>;
+using DeviceRandomWriter = RandomAccessWriterTemplate<DeviceHandle>;
+using DeviceRandomReaderWriter = RandomAccessReaderWriterTemplate<DeviceHandle>;
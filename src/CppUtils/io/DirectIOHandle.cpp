@@ -0,0 +1,138 @@
+#include "DirectIOHandle.h"
+#include "IOUtils.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+DirectIOHandle::DirectIOHandle()
+    : DeviceHandle(), buffer_(nullptr), alignment_(default_alignment), capacity_(0), size_(0), direct_(false)
+{}
+
+DirectIOHandle::DirectIOHandle(const std::string& filename, size_t alignment, size_t buffer_size, bool dsync)
+    : DirectIOHandle()
+{
+    open(filename, alignment, buffer_size, dsync);
+}
+
+DirectIOHandle::~DirectIOHandle() {
+    try {
+        close();
+    } catch (...) {
+        // Errors are only reported by an explicit close()
+    }
+    free_buffer();
+}
+
+void DirectIOHandle::open(const std::string& filename, size_t alignment, size_t buffer_size, bool dsync) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+        throw std::runtime_error("Direct I/O alignment must be a power of two");
+
+    OpenOptions options;
+    options.direct = true;
+    options.dsync = dsync;
+    DeviceHandle::open(filename, OpenMode::Truncate, options);
+    direct_ = good();
+    if (!good() && errno == EINVAL) {
+        options.direct = false;
+        DeviceHandle::open(filename, OpenMode::Truncate, options);
+    }
+    if (!good())
+        throw std::runtime_error("Couldn't open " + filename + " for direct I/O");
+
+    free_buffer();
+    alignment_ = alignment;
+    capacity_ = std::max(buffer_size / alignment * alignment, alignment);
+    buffer_ = static_cast<uint8_t*>(::operator new(capacity_, std::align_val_t(alignment_)));
+    size_ = 0;
+}
+
+void DirectIOHandle::close() {
+    try {
+        if (good()) {
+            flush();
+            write_tail();
+        }
+    } catch (...) {
+        size_ = 0;
+        DeviceHandle::close();
+        throw;
+    }
+    DeviceHandle::close();
+}
+
+void DirectIOHandle::free_buffer() {
+    if (buffer_ != nullptr) {
+        ::operator delete(buffer_, std::align_val_t(alignment_));
+        buffer_ = nullptr;
+    }
+}
+
+void DirectIOHandle::_write(const uint8_t* buffer, size_t N) {
+    while (N > 0) {
+        // Whole aligned chunks go straight from an aligned source when
+        // nothing is staged, skipping the copy
+        if (size_ == 0 && N >= capacity_ && reinterpret_cast<uintptr_t>(buffer) % alignment_ == 0) {
+            const size_t n = N / alignment_ * alignment_;
+            write_out(buffer, n);
+            buffer += n;
+            N -= n;
+            continue;
+        }
+
+        const size_t n = std::min(N, capacity_ - size_);
+        std::memcpy(buffer_ + size_, buffer, n);
+        size_ += n;
+        buffer += n;
+        N -= n;
+        if (size_ == capacity_) {
+            write_out(buffer_, size_);
+            size_ = 0;
+        }
+    }
+}
+
+void DirectIOHandle::flush() {
+    const size_t aligned = size_ / alignment_ * alignment_;
+    if (aligned == 0)
+        return;
+    write_out(buffer_, aligned);
+    std::memmove(buffer_, buffer_ + aligned, size_ - aligned);
+    size_ -= aligned;
+}
+
+void DirectIOHandle::write_out(const uint8_t* buffer, size_t N) {
+    detail::staggered_io(
+            [fd = fd_] (const uint8_t* xs, size_t n) {
+                return ::write(fd, xs, n);
+            },
+            buffer, N);
+}
+
+void DirectIOHandle::write_tail() {
+    if (size_ == 0)
+        return;
+
+    if (direct_) {
+        const int flags = fcntl(fd_, F_GETFL);
+        if (flags == -1 || fcntl(fd_, F_SETFL, flags & ~O_DIRECT) == -1) {
+            // Pad the last block, then cut the file back to its real length
+            const off_t end = lseek(fd_, 0, SEEK_CUR);
+            const size_t padded = (size_ + alignment_ - 1) / alignment_ * alignment_;
+            std::memset(buffer_ + size_, 0, padded - size_);
+            write_out(buffer_, padded);
+            if (end == -1 || ftruncate(fd_, end + static_cast<off_t>(size_)) == -1)
+                throw std::runtime_error("Couldn't truncate direct I/O padding");
+            size_ = 0;
+            return;
+        }
+        direct_ = false;
+    }
+
+    write_out(buffer_, size_);
+    size_ = 0;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "DeviceHandle.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Sequential writer to a file opened with O_DIRECT, bypassing the page cache.
+ *
+ * O_DIRECT requires the buffer address, transfer size and file offset to be
+ * multiples of the device's logical block size. Writes are staged in an
+ * aligned buffer and written in whole buffers; on close the unaligned tail is
+ * written after clearing O_DIRECT on the descriptor (or, if that fails,
+ * padded to the alignment and the file truncated back to its real size).
+ *
+ * If the file system doesn't support O_DIRECT (e.g. tmpfs) the file is opened
+ * without it, see direct(); writes are still batched the same way.
+ *
+ * Call close() explicitly to see errors writing the staged data; it closes
+ * the file either way. The destructor closes too but swallows them.
+ *
+ * The file is always truncated on open.
+ */
+class DirectIOHandle : public DeviceHandle {
+public:
+    constexpr static size_t default_alignment = 4096;
+    constexpr static size_t default_buffer_size = 1024 * 1024;
+
+    DirectIOHandle();
+    DirectIOHandle(const std::string& filename, size_t alignment = default_alignment,
+                   size_t buffer_size = default_buffer_size, bool dsync = false);
+
+    virtual ~DirectIOHandle();
+
+    void open(const std::string& filename, size_t alignment = default_alignment,
+              size_t buffer_size = default_buffer_size, bool dsync = false);
+    virtual void close() override;
+
+    /*
+     * True if the file was opened with O_DIRECT.
+     */
+    bool direct() const { return direct_; }
+
+    /*
+     * Writes the whole aligned blocks buffered so far.
+     */
+    void flush();
+
+protected:
+    uint8_t* buffer_;
+    size_t alignment_;
+    size_t capacity_;
+    size_t size_;
+    bool direct_;
+
+    void _write(const uint8_t* buffer, size_t N);
+
+private:
+    void write_out(const uint8_t* buffer, size_t N);
+    void write_tail();
+    void free_buffer();
+};
+
+using DirectWriter = BinaryWriterTemplate<DirectIOHandle>;
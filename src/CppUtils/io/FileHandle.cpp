@@ -37,6 +37,10 @@ bool FileHandle::good() const {
     return file_ != nullptr;
 }
 
+int FileHandle::fd() const {
+    return good() ? fileno(file_) : -1;
+}
+
 void FileHandle::close() {
     if (good()) {
         fclose(file_);
@@ -59,3 +63,22 @@ void FileHandle::_read(uint8_t* buffer, size_t N) {
 size_t FileHandle::_var_read(uint8_t* buffer, size_t N) {
     return fread(buffer, sizeof(uint8_t), N, file_);
 }
+
+uint64_t FileHandle::seek(int64_t offset, SeekOrigin origin) {
+    int whence = SEEK_SET;
+    if (origin == SeekOrigin::Current)
+        whence = SEEK_CUR;
+    else if (origin == SeekOrigin::End)
+        whence = SEEK_END;
+
+    if (fseeko(file_, static_cast<off_t>(offset), whence) != 0)
+        throw std::runtime_error("Seek failure");
+    return tell();
+}
+
+uint64_t FileHandle::tell() const {
+    off_t result = ftello(file_);
+    if (result == -1)
+        throw std::runtime_error("Tell failure");
+    return static_cast<uint64_t>(result);
+}
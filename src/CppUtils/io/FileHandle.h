@@ -12,7 +12,20 @@ public:
 
     virtual bool good() const override;
     virtual void close() override;
-    
+
+    /*
+     * Underlying descriptor, e.g. to pass to another process. It shares the
+     * file position; flush before handing it over.
+     */
+    int fd() const;
+
+    /*
+     * Moves the file position, returning the new position from the start.
+     * Buffered writes are flushed first.
+     */
+    uint64_t seek(int64_t offset, SeekOrigin origin = SeekOrigin::Begin);
+    uint64_t tell() const;
+
 protected:
     FILE* file_;
 
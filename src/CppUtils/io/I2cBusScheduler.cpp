@@ -0,0 +1,201 @@
+#include "I2cBusScheduler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+bool try_transfer(I2cHandle& bus, const I2cTransaction& transaction) {
+    try {
+        bus.transfer(transaction);
+        return true;
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+}
+
+}
+
+I2cBusScheduler::I2cBusScheduler(std::chrono::microseconds coalesce_window)
+    : coalesce_window_(coalesce_window), running_(false)
+{}
+
+I2cBusScheduler::~I2cBusScheduler() {
+    stop();
+}
+
+size_t I2cBusScheduler::add_bus(uint8_t bus_id) {
+    return add_bus(std::make_unique<I2cHandle>(bus_id));
+}
+
+size_t I2cBusScheduler::add_bus(std::unique_ptr<I2cHandle> handle) {
+    if (running_)
+        throw std::runtime_error("Can't add an I2C bus to a running scheduler");
+    buses_.push_back(Bus{std::move(handle), {}, {}});
+    return buses_.size() - 1;
+}
+
+I2cBusScheduler::DeviceId I2cBusScheduler::add_device(size_t bus, uint8_t address, uint8_t reg, size_t N,
+                                                      std::chrono::microseconds period) {
+    if (running_)
+        throw std::runtime_error("Can't add an I2C device to a running scheduler");
+    if (bus >= buses_.size())
+        throw std::runtime_error("Unknown I2C bus index " + std::to_string(bus));
+    if (N == 0 || N > max_read_size)
+        throw std::runtime_error("I2C poll size must be between 1 and " + std::to_string(max_read_size));
+    if (period.count() <= 0)
+        throw std::runtime_error("I2C poll period must be positive");
+
+    devices_.push_back(Device{bus, address, reg, N, period, Clock::time_point(), std::make_unique<Slot>()});
+    buses_[bus].devices.push_back(devices_.size() - 1);
+    return devices_.size() - 1;
+}
+
+void I2cBusScheduler::start() {
+    if (running_)
+        return;
+    running_ = true;
+
+    const Clock::time_point now = Clock::now();
+    for (Device& device : devices_) {
+        device.next_due = now;
+    }
+    for (Bus& bus : buses_) {
+        bus.thread = std::thread([this, &bus] { run(bus); });
+    }
+}
+
+void I2cBusScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_)
+            return;
+        running_ = false;
+    }
+    wake_.notify_all();
+    for (Bus& bus : buses_) {
+        if (bus.thread.joinable())
+            bus.thread.join();
+    }
+}
+
+void I2cBusScheduler::run(Bus& bus) {
+    if (bus.devices.empty())
+        return;
+
+    // Sized for every device on the bus, so polling doesn't allocate
+    const size_t n_devices = bus.devices.size();
+    I2cTransaction transaction;
+    transaction.reserve(n_devices);
+    std::vector<size_t> due;
+    due.reserve(n_devices);
+    std::vector<uint8_t> succeeded;
+    succeeded.reserve(n_devices);
+    std::vector<uint8_t> results(n_devices * max_read_size);
+
+    while (true) {
+        Clock::time_point next = Clock::time_point::max();
+        for (size_t id : bus.devices) {
+            next = std::min(next, devices_[id].next_due);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (wake_.wait_until(lock, next, [this] { return !running_; }))
+                return;
+        }
+
+        // Everything due up to the window after the deadline goes in this batch
+        const Clock::time_point horizon = next + coalesce_window_;
+        due.clear();
+        for (size_t id : bus.devices) {
+            if (devices_[id].next_due <= horizon)
+                due.push_back(id);
+        }
+
+        transaction.clear();
+        for (size_t i = 0; i < due.size(); i++) {
+            const Device& device = devices_[due[i]];
+            transaction.read_register(device.address, device.reg, results.data() + i * max_read_size, device.size);
+        }
+        succeeded.assign(due.size(), try_transfer(*bus.handle, transaction));
+
+        // A failed batch doesn't say which device failed; poll them one at a
+        // time, so a dead device doesn't cost the others on the bus their
+        // samples
+        if (!succeeded.empty() && !succeeded.front() && due.size() > 1) {
+            for (size_t i = 0; i < due.size(); i++) {
+                const Device& device = devices_[due[i]];
+                transaction.clear();
+                transaction.read_register(device.address, device.reg, results.data() + i * max_read_size, device.size);
+                succeeded[i] = try_transfer(*bus.handle, transaction);
+            }
+        }
+
+        const Clock::time_point now = Clock::now();
+        for (size_t i = 0; i < due.size(); i++) {
+            Device& device = devices_[due[i]];
+            if (succeeded[i])
+                publish(device, results.data() + i * max_read_size, now);
+            else
+                device.slot->errors.fetch_add(1, std::memory_order_relaxed);
+
+            // Skip periods missed while the bus was busy instead of bursting
+            device.next_due += device.period;
+            if (device.next_due < now) {
+                const auto missed = (now - device.next_due) / device.period + 1;
+                device.next_due += missed * device.period;
+            }
+        }
+    }
+}
+
+void I2cBusScheduler::publish(Device& device, const uint8_t* data, Clock::time_point time) {
+    Slot& slot = *device.slot;
+    const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.time.store(time.time_since_epoch().count(), std::memory_order_relaxed);
+    for (size_t w = 0; w < Slot::n_words; w++) {
+        uint64_t word;
+        std::memcpy(&word, data + w * sizeof(uint64_t), sizeof(word));
+        slot.words[w].store(word, std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool I2cBusScheduler::latest(DeviceId id, I2cSample& sample) const {
+    const Device& device = devices_.at(id);
+    const Slot& slot = *device.slot;
+
+    uint64_t words[Slot::n_words];
+    while (true) {
+        const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before == 0)
+            return false;
+        if (before % 2 != 0)
+            continue;
+
+        const int64_t time = slot.time.load(std::memory_order_relaxed);
+        for (size_t w = 0; w < Slot::n_words; w++) {
+            words[w] = slot.words[w].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (slot.sequence.load(std::memory_order_relaxed) == before) {
+            sample.sequence = before / 2;
+            sample.time = Clock::time_point(Clock::duration(time));
+            sample.size = device.size;
+            std::memcpy(sample.data, words, max_read_size);
+            return true;
+        }
+    }
+}
+
+uint64_t I2cBusScheduler::error_count(DeviceId id) const {
+    return devices_.at(id).slot->errors.load(std::memory_order_relaxed);
+}
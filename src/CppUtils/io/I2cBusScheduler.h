@@ -0,0 +1,116 @@
+#pragma once
+
+#include "I2cHandle.h"
+
+#include "CppUtils/container/Layout.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct I2cSample {
+    // Number of the poll this sample comes from, starting at 1
+    uint64_t sequence;
+    std::chrono::steady_clock::time_point time;
+    size_t size;
+    uint8_t data[32];
+};
+
+/*
+ * Polls registers of many I2C devices at fixed rates, one thread per bus.
+ *
+ * Each bus thread collects every device due within coalesce_window of the
+ * next deadline and reads them all in one I2cTransaction (one I2C_RDWR
+ * ioctl, no I2C_SLAVE switching). If the batch fails, its devices are
+ * retried one at a time, so errors are counted per device. Results are
+ * published into per-device seqlock slots, so consumers read the latest
+ * sample without locking and never block the bus thread.
+ *
+ * Buses and devices are registered before start(). A bus may be any
+ * I2cHandle, including a simulated one overriding _ioctl.
+ */
+class I2cBusScheduler {
+public:
+    using DeviceId = size_t;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr static size_t max_read_size = sizeof(I2cSample::data);
+
+    explicit I2cBusScheduler(std::chrono::microseconds coalesce_window = std::chrono::microseconds(500));
+
+    I2cBusScheduler(const I2cBusScheduler&) = delete;
+    I2cBusScheduler& operator=(const I2cBusScheduler&) = delete;
+
+    ~I2cBusScheduler();
+
+    /*
+     * Returns the bus index used by add_device.
+     */
+    size_t add_bus(uint8_t bus_id);
+    size_t add_bus(std::unique_ptr<I2cHandle> handle);
+
+    /*
+     * Polls N bytes from register reg of the device every period.
+     */
+    DeviceId add_device(size_t bus, uint8_t address, uint8_t reg, size_t N, std::chrono::microseconds period);
+
+    void start();
+    void stop();
+
+    /*
+     * Latest sample of the device. Returns false if none was read yet.
+     */
+    bool latest(DeviceId id, I2cSample& sample) const;
+
+    /*
+     * Number of polls of the device which failed.
+     */
+    uint64_t error_count(DeviceId id) const;
+
+private:
+    /*
+     * Single writer seqlock: the sequence is odd while the bus thread writes,
+     * and readers retry if it was odd or changed across their copy. The data
+     * is held in atomic words so concurrent copies are well defined.
+     */
+    struct alignas(layout::cache_line_size) Slot {
+        constexpr static size_t n_words = (max_read_size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<int64_t> time{0};
+        std::atomic<uint64_t> words[n_words] = {};
+        std::atomic<uint64_t> errors{0};
+    };
+
+    struct Device {
+        size_t bus;
+        uint8_t address;
+        uint8_t reg;
+        size_t size;
+        Clock::duration period;
+        Clock::time_point next_due;
+        std::unique_ptr<Slot> slot;
+    };
+
+    struct Bus {
+        std::unique_ptr<I2cHandle> handle;
+        std::vector<size_t> devices;
+        std::thread thread;
+    };
+
+    void run(Bus& bus);
+    void publish(Device& device, const uint8_t* data, Clock::time_point time);
+
+    Clock::duration coalesce_window_;
+    std::vector<Bus> buses_;
+    std::vector<Device> devices_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool running_;
+};
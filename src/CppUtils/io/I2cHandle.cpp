@@ -3,22 +3,271 @@
 #include <sys/ioctl.h>
 #include <linux/i2c-dev.h>
 
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+uint16_t message_length(size_t N) {
+    if (N > std::numeric_limits<uint16_t>::max())
+        throw std::runtime_error("I2C message of " + std::to_string(N) + " bytes is too long");
+    return static_cast<uint16_t>(N);
+}
+
+}
+
+// ----- I2cTransaction
+
+I2cTransaction::I2cTransaction(const I2cTransaction& other)
+    : messages_(other.messages_), operations_(other.operations_), bytes_(other.bytes_), owned_(other.owned_)
+{
+    rebase();
+}
+
+I2cTransaction& I2cTransaction::operator=(const I2cTransaction& other) {
+    if (this != &other) {
+        messages_ = other.messages_;
+        operations_ = other.operations_;
+        bytes_ = other.bytes_;
+        owned_ = other.owned_;
+        rebase();
+    }
+    return *this;
+}
+
+void I2cTransaction::add(std::initializer_list<i2c_msg> messages) {
+    if (messages.size() > I2cHandle::max_messages)
+        throw std::runtime_error("I2C operation has too many messages");
+    operations_.push_back(messages_.size());
+    messages_.insert(messages_.end(), messages);
+}
+
+size_t I2cTransaction::store(uint8_t reg, const uint8_t* buffer, size_t N) {
+    const size_t offset = bytes_.size();
+    const uint8_t* data = bytes_.data();
+    bytes_.push_back(reg);
+    bytes_.insert(bytes_.end(), buffer, buffer + N);
+    if (bytes_.data() != data)
+        rebase();
+    return offset;
+}
+
+void I2cTransaction::rebase() {
+    for (const OwnedMessage& owned : owned_) {
+        messages_[owned.message].buf = bytes_.data() + owned.offset;
+    }
+}
+
+void I2cTransaction::write(uint8_t address, const uint8_t* buffer, size_t N) {
+    add({i2c_msg{address, 0, message_length(N), const_cast<uint8_t*>(buffer)}});
+}
+
+void I2cTransaction::read(uint8_t address, uint8_t* buffer, size_t N) {
+    add({i2c_msg{address, I2C_M_RD, message_length(N), buffer}});
+}
+
+void I2cTransaction::read_register(uint8_t address, uint8_t reg, uint8_t* buffer, size_t N) {
+    const size_t offset = store(reg, nullptr, 0);
+    owned_.push_back({messages_.size(), offset});
+    add({
+        i2c_msg{address, 0, 1, bytes_.data() + offset},
+        i2c_msg{address, I2C_M_RD, message_length(N), buffer},
+    });
+}
+
+void I2cTransaction::write_register(uint8_t address, uint8_t reg, const uint8_t* buffer, size_t N) {
+    const uint16_t length = message_length(N + 1);
+    const size_t offset = store(reg, buffer, N);
+    owned_.push_back({messages_.size(), offset});
+    add({i2c_msg{address, 0, length, bytes_.data() + offset}});
+}
+
+void I2cTransaction::clear() {
+    messages_.clear();
+    operations_.clear();
+    bytes_.clear();
+    owned_.clear();
+}
+
+void I2cTransaction::reserve(size_t n_operations, size_t n_bytes) {
+    messages_.reserve(2 * n_operations);
+    operations_.reserve(n_operations);
+    bytes_.reserve(n_operations + n_bytes);
+    owned_.reserve(n_operations);
+    rebase();
+}
+
+// ----- I2cHandle
+
 I2cHandle::I2cHandle()
-    : DeviceHandle()
+    : DeviceHandle(), address_(-1)
 {}
 
 I2cHandle::I2cHandle(uint8_t bus_id, uint8_t dev_id, OpenMode mode) 
-    : DeviceHandle()
+    : DeviceHandle(), address_(-1)
 {
     open(bus_id, dev_id, mode);
 }
 
+I2cHandle::I2cHandle(uint8_t bus_id)
+    : DeviceHandle(), address_(-1)
+{
+    open_bus(bus_id, OpenMode::ReadWrite);
+}
+
 I2cHandle::~I2cHandle()
 {}
 
 void I2cHandle::open(uint8_t bus_id, uint8_t dev_id, OpenMode mode) {
-    DeviceHandle::open("/dev/i2c-" + std::to_string(bus_id), mode);
-    if (ioctl(fd_, I2C_SLAVE, dev_id) == -1) {
+    open_bus(bus_id, mode);
+    if (_ioctl(I2C_SLAVE, reinterpret_cast<void*>(static_cast<uintptr_t>(dev_id))) == -1) {
         throw std::runtime_error("Couldn't open I2C Bus " + std::to_string(bus_id) + " device " + std::to_string(dev_id));
     }
+    address_ = dev_id;
+}
+
+void I2cHandle::open_bus(uint8_t bus_id, OpenMode mode) {
+    address_ = -1;
+    // Never create a regular file in place of a missing device node
+    OpenOptions options;
+    options.no_create = true;
+    DeviceHandle::open("/dev/i2c-" + std::to_string(bus_id), mode, options);
+    if (!good())
+        throw std::runtime_error("Couldn't open I2C Bus " + std::to_string(bus_id));
+}
+
+int I2cHandle::_ioctl(unsigned long request, void* arg) {
+    return ioctl(fd_, request, arg);
+}
+
+void I2cHandle::transfer(const I2cTransaction& transaction) {
+    const std::vector<i2c_msg>& messages = transaction.messages_;
+    const std::vector<size_t>& operations = transaction.operations_;
+
+    size_t start = 0;
+    size_t op = 0;
+    while (start < messages.size()) {
+        // Take whole operations up to the message limit
+        size_t end = start;
+        while (op < operations.size()) {
+            const size_t op_end = op + 1 < operations.size() ? operations[op + 1] : messages.size();
+            if (op_end - start > max_messages)
+                break;
+            end = op_end;
+            op++;
+        }
+
+        i2c_rdwr_ioctl_data data;
+        data.msgs = const_cast<i2c_msg*>(messages.data() + start);
+        data.nmsgs = static_cast<uint32_t>(end - start);
+        if (_ioctl(I2C_RDWR, &data) < 0)
+            throw std::runtime_error("I2C transaction failed");
+        start = end;
+    }
+}
+
+void I2cHandle::read_register(uint8_t address, uint8_t reg, uint8_t* buffer, size_t N) {
+    scratch_.clear();
+    scratch_.read_register(address, reg, buffer, N);
+    transfer(scratch_);
+}
+
+void I2cHandle::write_register(uint8_t address, uint8_t reg, const uint8_t* buffer, size_t N) {
+    scratch_.clear();
+    scratch_.write_register(address, reg, buffer, N);
+    transfer(scratch_);
+}
+
+void I2cHandle::read_registers(uint8_t address, const uint8_t* regs, size_t N_regs, uint8_t* buffers, size_t N_bytes) {
+    if (N_bytes != 0 && N_regs > std::numeric_limits<size_t>::max() / N_bytes)
+        throw std::runtime_error("I2C register map of " + std::to_string(N_regs) + " registers of " + std::to_string(N_bytes) + " bytes is too large");
+    scratch_.clear();
+    for (size_t i = 0; i < N_regs; i++) {
+        scratch_.read_register(address, regs[i], buffers + i * N_bytes, N_bytes);
+    }
+    transfer(scratch_);
+}
+
+// ----- SMBus
+
+void I2cHandle::select(uint8_t address) {
+    if (address_ == address)
+        return;
+    if (_ioctl(I2C_SLAVE, reinterpret_cast<void*>(static_cast<uintptr_t>(address))) == -1) {
+        address_ = -1;
+        throw std::runtime_error("Couldn't select I2C device " + std::to_string(address));
+    }
+    address_ = address;
+}
+
+void I2cHandle::smbus_access(uint8_t address, uint8_t read_write, uint8_t reg, uint32_t size, i2c_smbus_data* data) {
+    select(address);
+    i2c_smbus_ioctl_data args;
+    args.read_write = read_write;
+    args.command = reg;
+    args.size = size;
+    args.data = data;
+    if (_ioctl(I2C_SMBUS, &args) < 0)
+        throw std::runtime_error("SMBus transfer to device " + std::to_string(address) + " failed");
+}
+
+uint8_t I2cHandle::smbus_read_byte(uint8_t address, uint8_t reg) {
+    i2c_smbus_data data;
+    smbus_access(address, I2C_SMBUS_READ, reg, I2C_SMBUS_BYTE_DATA, &data);
+    return data.byte;
+}
+
+void I2cHandle::smbus_write_byte(uint8_t address, uint8_t reg, uint8_t value) {
+    i2c_smbus_data data;
+    data.byte = value;
+    smbus_access(address, I2C_SMBUS_WRITE, reg, I2C_SMBUS_BYTE_DATA, &data);
+}
+
+uint16_t I2cHandle::smbus_read_word(uint8_t address, uint8_t reg) {
+    i2c_smbus_data data;
+    smbus_access(address, I2C_SMBUS_READ, reg, I2C_SMBUS_WORD_DATA, &data);
+    return data.word;
+}
+
+void I2cHandle::smbus_write_word(uint8_t address, uint8_t reg, uint16_t value) {
+    i2c_smbus_data data;
+    data.word = value;
+    smbus_access(address, I2C_SMBUS_WRITE, reg, I2C_SMBUS_WORD_DATA, &data);
+}
+
+size_t I2cHandle::smbus_read_block(uint8_t address, uint8_t reg, uint8_t* buffer, size_t N) {
+    i2c_smbus_data data;
+    smbus_access(address, I2C_SMBUS_READ, reg, I2C_SMBUS_BLOCK_DATA, &data);
+    const size_t count = std::min<size_t>({data.block[0], max_block_size, N});
+    std::copy(data.block + 1, data.block + 1 + count, buffer);
+    return count;
+}
+
+void I2cHandle::smbus_write_block(uint8_t address, uint8_t reg, const uint8_t* buffer, size_t N) {
+    if (N > max_block_size)
+        throw std::runtime_error("SMBus block of " + std::to_string(N) + " bytes is too long");
+    i2c_smbus_data data;
+    data.block[0] = static_cast<uint8_t>(N);
+    std::copy(buffer, buffer + N, data.block + 1);
+    smbus_access(address, I2C_SMBUS_WRITE, reg, I2C_SMBUS_BLOCK_DATA, &data);
+}
+
+void I2cHandle::smbus_read_i2c_block(uint8_t address, uint8_t reg, uint8_t* buffer, size_t N) {
+    if (N > max_block_size)
+        throw std::runtime_error("SMBus block of " + std::to_string(N) + " bytes is too long");
+    i2c_smbus_data data;
+    data.block[0] = static_cast<uint8_t>(N);
+    smbus_access(address, I2C_SMBUS_READ, reg, I2C_SMBUS_I2C_BLOCK_DATA, &data);
+    if (data.block[0] < N)
+        throw std::runtime_error("Short SMBus block read from device " + std::to_string(address));
+    std::copy(data.block + 1, data.block + 1 + N, buffer);
+}
+
+void I2cHandle::smbus_write_i2c_block(uint8_t address, uint8_t reg, const uint8_t* buffer, size_t N) {
+    if (N > max_block_size)
+        throw std::runtime_error("SMBus block of " + std::to_string(N) + " bytes is too long");
+    i2c_smbus_data data;
+    data.block[0] = static_cast<uint8_t>(N);
+    std::copy(buffer, buffer + N, data.block + 1);
+    smbus_access(address, I2C_SMBUS_WRITE, reg, I2C_SMBUS_I2C_BLOCK_DATA, &data);
 }
@@ -2,15 +2,188 @@
 
 #include "DeviceHandle.h"
 
+#include "CppUtils/container/Span.h"
+
+#include <linux/i2c.h>
+
+#include <initializer_list>
+#include <vector>
+
+/*
+ * Batch of I2C messages submitted with a single I2C_RDWR ioctl.
+ *
+ * Messages within a batch are joined by repeated starts, with one STOP at the
+ * end, and may address different devices. Each call adds one operation of one
+ * or two messages; the buffers given must stay valid until the transaction is
+ * transferred.
+ *
+ * Register numbers and register write data are copied into one contiguous
+ * buffer owned by the transaction. clear() keeps the capacity, so a
+ * transaction which is cleared and refilled stops allocating once it has
+ * grown to its working size.
+ */
+class I2cTransaction {
+public:
+    I2cTransaction() = default;
+    I2cTransaction(const I2cTransaction& other);
+    I2cTransaction(I2cTransaction&&) = default;
+    I2cTransaction& operator=(const I2cTransaction& other);
+    I2cTransaction& operator=(I2cTransaction&&) = default;
+
+    void write(uint8_t address, const uint8_t* buffer, size_t N);
+    void read(uint8_t address, uint8_t* buffer, size_t N);
+    void write(uint8_t address, Span<const uint8_t> buffer) { write(address, buffer.data(), buffer.size()); }
+    void read(uint8_t address, Span<uint8_t> buffer) { read(address, buffer.data(), buffer.size()); }
+
+    /*
+     * Register read: writes the register number, then reads N bytes after a
+     * repeated start.
+     */
+    void read_register(uint8_t address, uint8_t reg, uint8_t* buffer, size_t N);
+    void read_register(uint8_t address, uint8_t reg, Span<uint8_t> buffer) {
+        read_register(address, reg, buffer.data(), buffer.size());
+    }
+
+    /*
+     * Register write: the register number followed by the data, in one
+     * message.
+     */
+    void write_register(uint8_t address, uint8_t reg, const uint8_t* buffer, size_t N);
+    void write_register(uint8_t address, uint8_t reg, Span<const uint8_t> buffer) {
+        write_register(address, reg, buffer.data(), buffer.size());
+    }
+
+    size_t size() const { return messages_.size(); }
+    bool empty() const { return messages_.empty(); }
+    void clear();
+
+    /*
+     * Reserves room for n_operations register operations carrying n_bytes of
+     * register write data in total.
+     */
+    void reserve(size_t n_operations, size_t n_bytes = 0);
+
+private:
+    friend class I2cHandle;
+
+    struct OwnedMessage {
+        size_t message;
+        size_t offset;
+    };
+
+    std::vector<i2c_msg> messages_;
+    // Index of the first message of each operation
+    std::vector<size_t> operations_;
+    // Owned bytes messages point to, and which messages point into them
+    std::vector<uint8_t> bytes_;
+    std::vector<OwnedMessage> owned_;
+
+    void add(std::initializer_list<i2c_msg> messages);
+
+    /*
+     * Copies the register number and data into bytes_, returns its offset.
+     */
+    size_t store(uint8_t reg, const uint8_t* buffer, size_t N);
+
+    /*
+     * Points the owned messages back into bytes_, after it moved.
+     */
+    void rebase();
+};
+
 class I2cHandle : public DeviceHandle {
 public:
+    /*
+     * Messages the kernel accepts per I2C_RDWR call (I2C_RDWR_IOCTL_MAX_MSGS).
+     */
+    constexpr static size_t max_messages = 42;
+
     I2cHandle();
     I2cHandle(uint8_t bus_id, uint8_t dev_id, OpenMode mode);
 
+    /*
+     * Opens the bus without binding a device, for use with transactions.
+     * Like open, it fails if /dev/i2c-<bus_id> doesn't exist rather than
+     * create it.
+     */
+    I2cHandle(uint8_t bus_id);
+
     virtual ~I2cHandle();
 
+    /*
+     * Submits the transaction. Transactions of more than max_messages messages
+     * are split into several ioctls, between operations, so there is a STOP
+     * between those chunks.
+     */
+    void transfer(const I2cTransaction& transaction);
+
+    void read_register(uint8_t address, uint8_t reg, uint8_t* buffer, size_t N);
+    void write_register(uint8_t address, uint8_t reg, const uint8_t* buffer, size_t N);
+
+    void read_register(uint8_t address, uint8_t reg, Span<uint8_t> buffer) {
+        read_register(address, reg, buffer.data(), buffer.size());
+    }
+
+    void write_register(uint8_t address, uint8_t reg, Span<const uint8_t> buffer) {
+        write_register(address, reg, buffer.data(), buffer.size());
+    }
+
+    /*
+     * Reads a register map in one batch: for each i, N_bytes bytes of
+     * register regs[i] into buffers + i * N_bytes.
+     */
+    void read_registers(uint8_t address, const uint8_t* regs, size_t N_regs, uint8_t* buffers, size_t N_bytes);
+
+    // ----- SMBus
+    // Each call is one I2C_SMBUS ioctl on the given device. The device is
+    // selected with I2C_SLAVE only when it differs from the previous one.
+
+    /*
+     * Largest SMBus block (I2C_SMBUS_BLOCK_MAX).
+     */
+    constexpr static size_t max_block_size = 32;
+
+    uint8_t smbus_read_byte(uint8_t address, uint8_t reg);
+    void smbus_write_byte(uint8_t address, uint8_t reg, uint8_t value);
+
+    /*
+     * Words are little endian on the bus, low byte at reg.
+     */
+    uint16_t smbus_read_word(uint8_t address, uint8_t reg);
+    void smbus_write_word(uint8_t address, uint8_t reg, uint16_t value);
+
+    /*
+     * SMBus block transfers, where the device sends the byte count first.
+     * Returns the number of bytes read, at most N.
+     */
+    size_t smbus_read_block(uint8_t address, uint8_t reg, uint8_t* buffer, size_t N);
+    void smbus_write_block(uint8_t address, uint8_t reg, const uint8_t* buffer, size_t N);
+
+    /*
+     * Plain I2C block transfers of exactly N bytes through the SMBus
+     * interface, for adapters without I2C_RDWR support.
+     */
+    void smbus_read_i2c_block(uint8_t address, uint8_t reg, uint8_t* buffer, size_t N);
+    void smbus_write_i2c_block(uint8_t address, uint8_t reg, const uint8_t* buffer, size_t N);
+
 protected:
     void open(uint8_t bus_id, uint8_t dev_id, OpenMode mode);
+    void open_bus(uint8_t bus_id, OpenMode mode);
+
+    /*
+     * All ioctls on the bus go through here, so tests can replace the
+     * driver.
+     */
+    virtual int _ioctl(unsigned long request, void* arg);
+
+private:
+    // Device last selected with I2C_SLAVE, -1 if none
+    int address_;
+    // Reused by the register helpers, so they don't allocate per call
+    I2cTransaction scratch_;
+
+    void select(uint8_t address);
+    void smbus_access(uint8_t address, uint8_t read_write, uint8_t reg, uint32_t size, i2c_smbus_data* data);
 };
 
 using I2cReader = BinaryReaderTemplate<I2cHandle>;
@@ -0,0 +1,107 @@
+#include "I2cRegisterCache.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+I2cRegisterCache::I2cRegisterCache(I2cHandle& bus, uint8_t address)
+    : bus_(bus), address_(address), values_(), cached_(), non_volatile_(), hits_(0), misses_(0)
+{}
+
+void I2cRegisterCache::check_range(uint8_t reg, size_t N) {
+    if (reg + N > n_registers)
+        throw std::runtime_error("I2C register range " + std::to_string(reg) + "+" + std::to_string(N)
+                                 + " is out of the register map");
+}
+
+void I2cRegisterCache::set_non_volatile(uint8_t reg, size_t N) {
+    check_range(reg, N);
+    for (size_t i = reg; i < reg + N; i++) {
+        non_volatile_.set(i);
+    }
+}
+
+void I2cRegisterCache::set_volatile(uint8_t reg, size_t N) {
+    check_range(reg, N);
+    for (size_t i = reg; i < reg + N; i++) {
+        non_volatile_.reset(i);
+        cached_.reset(i);
+    }
+}
+
+void I2cRegisterCache::invalidate() {
+    cached_.reset();
+}
+
+void I2cRegisterCache::invalidate(uint8_t reg, size_t N) {
+    check_range(reg, N);
+    for (size_t i = reg; i < reg + N; i++) {
+        cached_.reset(i);
+    }
+}
+
+void I2cRegisterCache::store(uint8_t reg, const uint8_t* buffer, size_t N) {
+    for (size_t i = 0; i < N; i++) {
+        if (non_volatile_.test(reg + i)) {
+            values_[reg + i] = buffer[i];
+            cached_.set(reg + i);
+        }
+    }
+}
+
+uint8_t I2cRegisterCache::read(uint8_t reg) {
+    uint8_t value;
+    read(reg, &value, 1);
+    return value;
+}
+
+void I2cRegisterCache::read(uint8_t reg, uint8_t* buffer, size_t N) {
+    check_range(reg, N);
+
+    bool all_cached = true;
+    for (size_t i = reg; i < reg + N && all_cached; i++) {
+        all_cached = cached_.test(i);
+    }
+    if (all_cached) {
+        std::copy(values_.begin() + reg, values_.begin() + reg + N, buffer);
+        hits_++;
+        return;
+    }
+
+    bus_.read_register(address_, reg, buffer, N);
+    store(reg, buffer, N);
+    misses_++;
+}
+
+void I2cRegisterCache::write(uint8_t reg, uint8_t value) {
+    write(reg, &value, 1);
+}
+
+void I2cRegisterCache::write(uint8_t reg, const uint8_t* buffer, size_t N) {
+    check_range(reg, N);
+
+    // Only the span from the first to the last changed byte goes to the bus
+    size_t first = N;
+    size_t last = 0;
+    for (size_t i = 0; i < N; i++) {
+        if (!cached_.test(reg + i) || values_[reg + i] != buffer[i]) {
+            first = std::min(first, i);
+            last = i + 1;
+        }
+    }
+    if (first == N) {
+        hits_++;
+        return;
+    }
+
+    const uint8_t start = static_cast<uint8_t>(reg + first);
+    try {
+        bus_.write_register(address_, start, buffer + first, last - first);
+    } catch (...) {
+        // The device may hold part of the write
+        invalidate(start, last - first);
+        throw;
+    }
+    store(start, buffer + first, last - first);
+    misses_++;
+}
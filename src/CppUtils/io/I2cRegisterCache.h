@@ -0,0 +1,61 @@
+#pragma once
+
+#include "I2cHandle.h"
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+/*
+ * Write-through cache of the register map of one I2C device, for 8 bit
+ * register addresses with auto-increment.
+ *
+ * Registers marked non-volatile (configuration the device never changes by
+ * itself) are remembered once read or written: reads of them are served from
+ * the cache, and writes only go to the bus for the bytes that differ, so
+ * rewriting a full configuration block costs nothing when it hasn't changed.
+ * Volatile registers always go to the bus.
+ *
+ * Each read or write call counts as one hit if it needed no bus traffic,
+ * else as one miss.
+ */
+class I2cRegisterCache {
+public:
+    constexpr static size_t n_registers = 256;
+
+    I2cRegisterCache(I2cHandle& bus, uint8_t address);
+
+    void set_non_volatile(uint8_t reg, size_t N = 1);
+    void set_volatile(uint8_t reg, size_t N = 1);
+
+    uint8_t read(uint8_t reg);
+    void read(uint8_t reg, uint8_t* buffer, size_t N);
+
+    void write(uint8_t reg, uint8_t value);
+    void write(uint8_t reg, const uint8_t* buffer, size_t N);
+
+    /*
+     * Forgets cached values, e.g. after the device was reset.
+     */
+    void invalidate();
+    void invalidate(uint8_t reg, size_t N = 1);
+
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+
+    uint8_t address() const { return address_; }
+
+private:
+    I2cHandle& bus_;
+    uint8_t address_;
+
+    std::array<uint8_t, n_registers> values_;
+    std::bitset<n_registers> cached_;
+    std::bitset<n_registers> non_volatile_;
+
+    uint64_t hits_;
+    uint64_t misses_;
+
+    static void check_range(uint8_t reg, size_t N);
+    void store(uint8_t reg, const uint8_t* buffer, size_t N);
+};
@@ -0,0 +1,155 @@
+#include "LzCodec.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr size_t min_match = 4;
+// The format requires the last 5 bytes to be literals, and the last match to
+// start at least 12 bytes before the end
+constexpr size_t last_literals = 5;
+constexpr size_t match_limit = 12;
+constexpr size_t max_offset = 65535;
+
+constexpr size_t hash_bits = 12;
+
+uint32_t read32(const uint8_t* p) {
+    uint32_t x;
+    std::memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+size_t hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - hash_bits);
+}
+
+uint8_t* write_length(uint8_t* out, size_t length) {
+    while (length >= 255) {
+        *out++ = 255;
+        length -= 255;
+    }
+    *out++ = static_cast<uint8_t>(length);
+    return out;
+}
+
+uint8_t* write_sequence(uint8_t* out, const uint8_t* literals, size_t n_literals, size_t offset, size_t match_length) {
+    uint8_t* token = out++;
+    *token = static_cast<uint8_t>(std::min<size_t>(n_literals, 15) << 4);
+    if (n_literals >= 15)
+        out = write_length(out, n_literals - 15);
+    std::memcpy(out, literals, n_literals);
+    out += n_literals;
+
+    if (match_length == 0)
+        return out;
+
+    *out++ = static_cast<uint8_t>(offset);
+    *out++ = static_cast<uint8_t>(offset >> 8);
+    const size_t extra = match_length - min_match;
+    *token |= static_cast<uint8_t>(std::min<size_t>(extra, 15));
+    if (extra >= 15)
+        out = write_length(out, extra - 15);
+    return out;
+}
+
+}
+
+size_t lz_compress(const uint8_t* src, size_t N, uint8_t* dst) {
+    uint8_t* out = dst;
+    size_t anchor = 0;
+
+    if (N > match_limit) {
+        // Positions + 1, so 0 means empty
+        uint32_t table[1 << hash_bits] = {};
+        size_t pos = 0;
+        size_t misses = 0;
+
+        while (pos < N - match_limit) {
+            const uint32_t sequence = read32(src + pos);
+            const size_t h = hash(sequence);
+            const size_t candidate = table[h];
+            table[h] = static_cast<uint32_t>(pos + 1);
+
+            if (candidate == 0 || pos - (candidate - 1) > max_offset || read32(src + candidate - 1) != sequence) {
+                // Skip faster through incompressible data
+                pos += 1 + (misses++ >> 6);
+                continue;
+            }
+            misses = 0;
+
+            const size_t match = candidate - 1;
+            size_t length = min_match;
+            while (pos + length < N - last_literals && src[match + length] == src[pos + length]) {
+                length++;
+            }
+
+            out = write_sequence(out, src + anchor, pos - anchor, pos - match, length);
+            pos += length;
+            anchor = pos;
+        }
+    }
+
+    out = write_sequence(out, src + anchor, N - anchor, 0, 0);
+    return static_cast<size_t>(out - dst);
+}
+
+size_t lz_decompress(const uint8_t* src, size_t N, uint8_t* dst, size_t capacity) {
+    const uint8_t* in = src;
+    const uint8_t* const in_end = src + N;
+    uint8_t* out = dst;
+    uint8_t* const out_end = dst + capacity;
+
+    auto read_length = [&in, in_end] (size_t length) {
+        if (length != 15)
+            return length;
+        uint8_t byte;
+        do {
+            if (in == in_end)
+                throw std::runtime_error("Malformed LZ block: truncated length");
+            byte = *in++;
+            length += byte;
+        } while (byte == 255);
+        return length;
+    };
+
+    while (in < in_end) {
+        const uint8_t token = *in++;
+
+        const size_t n_literals = read_length(token >> 4);
+        if (n_literals > static_cast<size_t>(in_end - in) || n_literals > static_cast<size_t>(out_end - out))
+            throw std::runtime_error("Malformed LZ block: literals out of range");
+        std::memcpy(out, in, n_literals);
+        in += n_literals;
+        out += n_literals;
+
+        // The last sequence has no match
+        if (in == in_end)
+            break;
+
+        if (in_end - in < 2)
+            throw std::runtime_error("Malformed LZ block: truncated offset");
+        const size_t offset = static_cast<size_t>(in[0]) | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        const size_t length = read_length(token & 0x0f) + min_match;
+
+        if (offset == 0 || offset > static_cast<size_t>(out - dst))
+            throw std::runtime_error("Malformed LZ block: offset out of range");
+        if (length > static_cast<size_t>(out_end - out))
+            throw std::runtime_error("Malformed LZ block: match out of range");
+
+        // Overlapping copies repeat the pattern, so copy forwards bytewise
+        const uint8_t* match = out - offset;
+        if (offset >= length) {
+            std::memcpy(out, match, length);
+        } else {
+            for (size_t i = 0; i < length; i++) {
+                out[i] = match[i];
+            }
+        }
+        out += length;
+    }
+
+    return static_cast<size_t>(out - dst);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * LZ77 block codec using the LZ4 block format: a sequence of
+ * (literal run, back-reference) pairs with 64 KiB match offsets, greedy
+ * matching through a hash table of 4-byte prefixes. Fast to compress and very
+ * fast to decompress; each block is independent.
+ */
+
+/*
+ * Worst case compressed size of N bytes.
+ */
+constexpr size_t lz_compress_bound(size_t N) {
+    return N + N / 255 + 16;
+}
+
+/*
+ * Compresses N bytes of src into dst, which must hold lz_compress_bound(N)
+ * bytes. Returns the compressed size.
+ */
+size_t lz_compress(const uint8_t* src, size_t N, uint8_t* dst);
+
+/*
+ * Decompresses N bytes of src into dst, which holds capacity bytes. Returns
+ * the decompressed size. Throws if the data is malformed or doesn't fit.
+ */
+size_t lz_decompress(const uint8_t* src, size_t N, uint8_t* dst, size_t capacity);
@@ -1,14 +1,22 @@
 #include "PipeHandle.h"
-#include "IOUtils.h"
 
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <errno.h>
 
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
 PipeHandle::PipeHandle()
-    : BasicHandle(), fd_(-1)
+    : BasicHandle(), fd_(-1), options_()
 {}
 
 PipeHandle::~PipeHandle()
@@ -27,28 +35,55 @@ void PipeHandle::close() {
     }
 }
 
-void PipeHandle::_write(const uint8_t* buffer, size_t N) {
-    detail::staggered_io(
-            [fd = fd_] (const uint8_t* xs, size_t n) {
-                return ::write(fd, xs, n);
-            },
-            buffer, N);
+size_t PipeHandle::capacity() const {
+    int result = fcntl(fd_, F_GETPIPE_SZ);
+    if (result < 0)
+        throw std::runtime_error("Failed to get pipe capacity: " + std::string(std::strerror(errno)));
+    return static_cast<size_t>(result);
+}
+
+size_t PipeHandle::set_capacity(size_t capacity) {
+    int result = fcntl(fd_, F_SETPIPE_SZ, static_cast<int>(capacity));
+    if (result < 0)
+        throw std::runtime_error("Failed to set pipe capacity to " + std::to_string(capacity) + ": "
+                                 + std::string(std::strerror(errno)));
+    return static_cast<size_t>(result);
 }
 
+void PipeHandle::apply_options() {
+    if (good() && options_.capacity > 0)
+        set_capacity(options_.capacity);
+}
 
-void PipeHandle::_read(uint8_t* buffer, size_t N) {
-    detail::staggered_io(
-            [this] (uint8_t* xs, size_t n) {
-                return this->_var_read(xs, n);
-            },
-            buffer, N);
+Clock::time_point PipeHandle::deadline(std::chrono::milliseconds timeout) const {
+    if (timeout.count() < 0)
+        return Clock::time_point::max();
+    return Clock::now() + timeout;
 }
 
-size_t PipeHandle::_var_read(uint8_t* buffer, size_t N) {
-    int result = ::read(fd_, buffer, N);
-    if (result < 0)
-        throw std::runtime_error("Failed to read pipe: " + std::to_string(result));
-    return static_cast<size_t>(result);
+short PipeHandle::poll_until(short events, Clock::time_point deadline) {
+    while (true) {
+        int timeout_ms = -1;
+        if (deadline != Clock::time_point::max()) {
+            const auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now());
+            timeout_ms = static_cast<int>(std::max<int64_t>(left.count(), 0));
+        }
+
+        pollfd descriptor{fd_, events, 0};
+        int result = ::poll(&descriptor, 1, timeout_ms);
+        if (result > 0)
+            return descriptor.revents;
+        if (result == 0)
+            return 0;
+        if (errno != EINTR)
+            throw std::runtime_error("Failed to poll pipe: " + std::string(std::strerror(errno)));
+    }
+}
+
+bool PipeHandle::wait_ready(std::chrono::milliseconds timeout) {
+    int flags = fcntl(fd_, F_GETFL);
+    short events = (flags & O_ACCMODE) == O_WRONLY ? POLLOUT : POLLIN;
+    return poll_until(events, deadline(timeout)) != 0;
 }
 
 void PipeHandle::make_pipe(const std::string& name) {
@@ -65,16 +100,78 @@ void PipeHandle::make_pipe(const std::string& name) {
 
 
 InputPipeHandle::InputPipeHandle()
-    : PipeHandle()
+    : PipeHandle(), hung_up_(false)
 {}
 
-InputPipeHandle::InputPipeHandle(const std::string& name) {
+InputPipeHandle::InputPipeHandle(const std::string& name)
+    : InputPipeHandle()
+{
     open(name);
 }
 
+InputPipeHandle::InputPipeHandle(const std::string& name, const PipeOptions& options)
+    : InputPipeHandle()
+{
+    open(name, options);
+}
+
 void InputPipeHandle::open(const std::string& filename) {
     make_pipe(filename);
+    hung_up_ = false;
     fd_ = ::open(filename.c_str(), O_RDONLY | O_NONBLOCK);
+    apply_options();
+}
+
+void InputPipeHandle::open(const std::string& filename, const PipeOptions& options) {
+    options_ = options;
+    open(filename);
+}
+
+bool InputPipeHandle::wait_data(ssize_t result, Clock::time_point deadline) {
+    const short events = poll_until(POLLIN, deadline);
+    hung_up_ = result == 0 && events != 0 && !(events & POLLIN);
+    return events != 0;
+}
+
+void InputPipeHandle::_read(uint8_t* buffer, size_t N) {
+    const Clock::time_point end = deadline(options_.timeout);
+    size_t total = 0;
+    while (total < N) {
+        ssize_t result = ::read(fd_, buffer + total, N - total);
+        if (result > 0) {
+            total += static_cast<size_t>(result);
+            continue;
+        }
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result < 0 && errno != EAGAIN)
+            throw std::runtime_error("Failed to read pipe: " + std::string(std::strerror(errno)));
+
+        if (!wait_data(result, end))
+            throw std::runtime_error("Timed out reading pipe after " + std::to_string(total) + " of "
+                                     + std::to_string(N) + " bytes");
+        if (hung_up_)
+            throw std::runtime_error("End of stream while transferring data (incomplete)");
+    }
+}
+
+size_t InputPipeHandle::_var_read(uint8_t* buffer, size_t N) {
+    if (N == 0)
+        return 0;
+
+    const Clock::time_point end = deadline(options_.timeout);
+    while (true) {
+        ssize_t result = ::read(fd_, buffer, N);
+        if (result > 0)
+            return static_cast<size_t>(result);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result < 0 && errno != EAGAIN)
+            throw std::runtime_error("Failed to read pipe: " + std::string(std::strerror(errno)));
+
+        if (!wait_data(result, end) || hung_up_)
+            return 0;
+    }
 }
 
 
@@ -82,11 +179,74 @@ OutputPipeHandle::OutputPipeHandle()
     : PipeHandle()
 {}
 
-OutputPipeHandle::OutputPipeHandle(const std::string& name) {
+OutputPipeHandle::OutputPipeHandle(const std::string& name)
+    : OutputPipeHandle()
+{
     open(name);
 }
 
+OutputPipeHandle::OutputPipeHandle(const std::string& name, const PipeOptions& options)
+    : OutputPipeHandle()
+{
+    open(name, options);
+}
+
 void OutputPipeHandle::open(const std::string& filename) {
     make_pipe(filename);
-    fd_ = ::open(filename.c_str(), O_WRONLY | O_NONBLOCK);
+
+    // Opening for writing fails with ENXIO until there is a reader, and a FIFO
+    // can't be polled before it is open, so retry with a growing backoff
+    const Clock::time_point end = deadline(options_.open_timeout);
+    std::chrono::milliseconds backoff(1);
+    while (true) {
+        fd_ = ::open(filename.c_str(), O_WRONLY | O_NONBLOCK);
+        if (fd_ >= 0 || (errno != ENXIO && errno != EINTR))
+            break;
+
+        const Clock::time_point now = Clock::now();
+        if (now >= end)
+            break;
+        if (end != Clock::time_point::max())
+            backoff = std::min(backoff, std::chrono::ceil<std::chrono::milliseconds>(end - now));
+        std::this_thread::sleep_for(backoff);
+        backoff = std::min(backoff * 2, std::chrono::milliseconds(50));
+    }
+    apply_options();
+}
+
+void OutputPipeHandle::open(const std::string& filename, const PipeOptions& options) {
+    options_ = options;
+    open(filename);
+}
+
+size_t OutputPipeHandle::write_some(const uint8_t* buffer, size_t N) {
+    const Clock::time_point end = deadline(options_.timeout);
+    while (true) {
+        ssize_t result = ::write(fd_, buffer, N);
+        if (result >= 0)
+            return static_cast<size_t>(result);
+        if (errno == EAGAIN) {
+            if (poll_until(POLLOUT, end) == 0)
+                return 0;
+        } else if (errno != EINTR) {
+            throw std::runtime_error("Failed to write pipe: " + std::string(std::strerror(errno)));
+        }
+    }
+}
+
+void OutputPipeHandle::_write(const uint8_t* buffer, size_t N) {
+    const Clock::time_point end = deadline(options_.timeout);
+    size_t total = 0;
+    while (total < N) {
+        ssize_t result = ::write(fd_, buffer + total, N - total);
+        if (result >= 0) {
+            total += static_cast<size_t>(result);
+        } else if (errno == EAGAIN) {
+            if (poll_until(POLLOUT, end) == 0)
+                throw std::runtime_error("Timed out writing pipe after " + std::to_string(total) + " of "
+                                         + std::to_string(N) + " bytes");
+        } else if (errno != EINTR) {
+            throw std::runtime_error("Failed to write pipe: " + std::string(std::strerror(errno)));
+        }
+    }
 }
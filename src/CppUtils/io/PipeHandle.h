@@ -2,6 +2,27 @@
 
 #include "BasicHandle.h"
 
+#include "CppUtils/container/Span.h"
+
+#include <chrono>
+
+#include <sys/types.h>
+
+/*
+ * FIFOs are opened non-blocking; waits for data, space or a peer are done with
+ * poll(2) and bounded by these timeouts. A negative timeout waits forever.
+ *
+ * timeout bounds each read or write call. open_timeout is how long an
+ * OutputPipeHandle waits for a reader to open the FIFO; with the default of 0
+ * the open fails right away, leaving the handle not good(). capacity, if
+ * non-zero, resizes the pipe buffer with F_SETPIPE_SZ.
+ */
+struct PipeOptions {
+    std::chrono::milliseconds timeout{-1};
+    std::chrono::milliseconds open_timeout{0};
+    size_t capacity = 0;
+};
+
 class PipeHandle : public BasicHandle {
 public:
     PipeHandle();
@@ -12,22 +33,71 @@ public:
     virtual bool good() const override;
     virtual void close() override;
 
+    int fd() const { return fd_; }
+
+    void set_timeout(std::chrono::milliseconds timeout) { options_.timeout = timeout; }
+    std::chrono::milliseconds timeout() const { return options_.timeout; }
+
+    /*
+     * Size of the pipe buffer. set_capacity returns the size the kernel
+     * picked, rounded up to a whole number of pages; unprivileged processes
+     * are limited to /proc/sys/fs/pipe-max-size.
+     */
+    size_t capacity() const;
+    size_t set_capacity(size_t capacity);
+
+    /*
+     * Waits until the pipe can be read from (input) or written to (output)
+     * without blocking. Returns false on timeout.
+     */
+    bool wait_ready(std::chrono::milliseconds timeout);
+
 protected:
     int fd_;
+    PipeOptions options_;
 
     void make_pipe(const std::string& name);
-
-    void _write(const uint8_t* buffer, size_t N);
-    void _read(uint8_t* buffer, size_t N);
-    size_t _var_read(uint8_t* buffer, size_t N);
+    void apply_options();
+
+    /*
+     * Polls for events until the deadline. Returns the events which occurred,
+     * 0 on timeout.
+     */
+    short poll_until(short events, std::chrono::steady_clock::time_point deadline);
+    std::chrono::steady_clock::time_point deadline(std::chrono::milliseconds timeout) const;
 };
 
 class InputPipeHandle : public PipeHandle {
 public:
     InputPipeHandle();
     InputPipeHandle(const std::string& filename);
+    InputPipeHandle(const std::string& filename, const PipeOptions& options);
 
     void open(const std::string& filename) override;
+    void open(const std::string& filename, const PipeOptions& options);
+
+    /*
+     * True once a read found the pipe empty with no writer left.
+     */
+    bool hung_up() const { return hung_up_; }
+
+protected:
+    bool hung_up_;
+
+    /*
+     * Waits after a read found no data. A FIFO reads 0 bytes both before
+     * the first writer opened it and after the last one closed it, but only
+     * reports POLLHUP in the latter case. Returns false on timeout.
+     */
+    bool wait_data(ssize_t result, std::chrono::steady_clock::time_point deadline);
+
+    void _read(uint8_t* buffer, size_t N);
+
+    /*
+     * Waits up to the timeout for data. Returns 0 if none arrived in time or
+     * the writer hung up; hung_up() tells those apart.
+     */
+    size_t _var_read(uint8_t* buffer, size_t N);
 };
 
 using PipeReader = BinaryReaderTemplate<InputPipeHandle>;
@@ -39,8 +109,28 @@ class OutputPipeHandle : public PipeHandle {
 public:
     OutputPipeHandle();
     OutputPipeHandle(const std::string& filename);
+    OutputPipeHandle(const std::string& filename, const PipeOptions& options);
 
     void open(const std::string& filename) override;
+    void open(const std::string& filename, const PipeOptions& options);
+
+    /*
+     * Writes as much as the pipe takes, waiting up to the timeout for space.
+     * Returns the number of bytes written, 0 on timeout, so a producer can
+     * keep the rest and continue later instead of blocking.
+     */
+    size_t write_some(const uint8_t* buffer, size_t N);
+
+    size_t write_some(Span<const uint8_t> buffer) {
+        return write_some(buffer.data(), buffer.size());
+    }
+
+protected:
+    /*
+     * Writes all N bytes, waiting for space as the reader drains the pipe.
+     * Throws if the timeout passes first.
+     */
+    void _write(const uint8_t* buffer, size_t N);
 };
 
 using PipeWriter = BinaryWriterTemplate<OutputPipeHandle>;
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "BinaryReader.h"
+
+#include "CppUtils/container/BufferPool.h"
+#include "CppUtils/container/Span.h"
+
+#include <cstddef>
+#include <string_view>
+
+/*
+ * Reads N chars into the arena; the view is valid until the arena is reset.
+ */
+inline std::string_view read_string(BinaryReader& reader, MonotonicArena& arena, size_t N) {
+    Span<char> buffer = arena.allocate<char>(N);
+    reader.read(buffer);
+    return std::string_view(buffer.data(), N);
+}
+
+/*
+ * Borrows a buffer from the pool and reads into it; the result is sized to
+ * the length read.
+ */
+inline PooledBuffer var_read_buffer(BinaryReader& reader, BufferPool& pool) {
+    PooledBuffer buffer = pool.acquire();
+    buffer.resize(reader.var_read(buffer.data(), buffer.size()));
+    return buffer;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CppUtils/container/Span.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+/*
+ * Positional I/O: transfers at an explicit file offset, without using or
+ * moving the handle's file position. Several threads may read (or write
+ * disjoint regions) through the same handle concurrently.
+ */
+class RandomAccessReader {
+public:
+    // ----- fixed length read
+    // fails if the specified length of data is not read.
+
+    template <typename T>
+    void read_at(uint64_t offset, T& t) {
+        read_at(offset, &t, 1);
+    }
+
+    template <typename T>
+    void read_at(uint64_t offset, T* buffer, size_t N) {
+        this->read_at_impl(offset, (uint8_t*) buffer, sizeof(T) * N);
+    }
+
+    template <typename T>
+    void read_at(uint64_t offset, Span<T> buffer) {
+        read_at(offset, buffer.data(), buffer.size());
+    }
+
+    // ----- variable length reading
+    // returns the length of data read; smaller than the buffer at the end of
+    // the file
+
+    template <typename T>
+    size_t var_read_at(uint64_t offset, T* buffer, size_t N) {
+        return this->var_read_at_impl(offset, (uint8_t*) buffer, sizeof(T) * N);
+    }
+
+    template <typename T>
+    size_t var_read_at(uint64_t offset, Span<T> buffer) {
+        return var_read_at(offset, buffer.data(), buffer.size());
+    }
+
+protected:
+    virtual void read_at_impl(uint64_t offset, uint8_t* buffer, size_t N) = 0;
+    virtual size_t var_read_at_impl(uint64_t offset, uint8_t* buffer, size_t N) = 0;
+};
+
+class RandomAccessWriter {
+public:
+    template <typename T>
+    void write_at(uint64_t offset, const T& t) {
+        write_at(offset, &t, 1);
+    }
+
+    template <typename T>
+    void write_at(uint64_t offset, const T* buffer, size_t N) {
+        this->write_at_impl(offset, (const uint8_t*) buffer, sizeof(T) * N);
+    }
+
+    template <typename T>
+    void write_at(uint64_t offset, Span<T> buffer) {
+        write_at(offset, buffer.data(), buffer.size());
+    }
+
+protected:
+    virtual void write_at_impl(uint64_t offset, const uint8_t* buffer, size_t N) = 0;
+};
+
+
+template <typename T>
+class RandomAccessReaderTemplate : public T, public RandomAccessReader {
+public:
+    template <typename... Args>
+    RandomAccessReaderTemplate(Args&&... args)
+        : T(std::forward<Args>(args)...), RandomAccessReader()
+    {}
+
+    virtual ~RandomAccessReaderTemplate() {}
+
+protected:
+    virtual void read_at_impl(uint64_t offset, uint8_t* buffer, size_t N) override {
+        T::_read_at(offset, buffer, N);
+    }
+
+    virtual size_t var_read_at_impl(uint64_t offset, uint8_t* buffer, size_t N) override {
+        return T::_var_read_at(offset, buffer, N);
+    }
+};
+
+template <typename T>
+class RandomAccessWriterTemplate : public T, public RandomAccessWriter {
+public:
+    template <typename... Args>
+    RandomAccessWriterTemplate(Args&&... args)
+        : T(std::forward<Args>(args)...), RandomAccessWriter()
+    {}
+
+    virtual ~RandomAccessWriterTemplate() {}
+
+protected:
+    virtual void write_at_impl(uint64_t offset, const uint8_t* buffer, size_t N) override {
+        T::_write_at(offset, buffer, N);
+    }
+};
+
+template <typename T>
+class RandomAccessReaderWriterTemplate : public T, public RandomAccessReader, public RandomAccessWriter {
+public:
+    template <typename... Args>
+    RandomAccessReaderWriterTemplate(Args&&... args)
+        : T(std::forward<Args>(args)...), RandomAccessReader(), RandomAccessWriter()
+    {}
+
+    virtual ~RandomAccessReaderWriterTemplate() {}
+
+protected:
+    virtual void read_at_impl(uint64_t offset, uint8_t* buffer, size_t N) override {
+        T::_read_at(offset, buffer, N);
+    }
+
+    virtual size_t var_read_at_impl(uint64_t offset, uint8_t* buffer, size_t N) override {
+        return T::_var_read_at(offset, buffer, N);
+    }
+
+    virtual void write_at_impl(uint64_t offset, const uint8_t* buffer, size_t N) override {
+        T::_write_at(offset, buffer, N);
+    }
+};
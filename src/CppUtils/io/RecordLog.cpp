@@ -0,0 +1,395 @@
+#include "RecordLog.h"
+#include "Serialization.h"
+
+#include "CppUtils/c_util/Crc32.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <limits>
+#include <thread>
+
+namespace {
+
+constexpr size_t header_size = 16;
+
+uint64_t file_size(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) == -1)
+        throw std::runtime_error("Couldn't stat record log file");
+    return static_cast<uint64_t>(st.st_size);
+}
+
+/*
+ * Returns false if the file ends before N bytes were read.
+ */
+bool pread_full(int fd, uint8_t* buffer, size_t N, uint64_t offset) {
+    size_t total = 0;
+    while (total < N) {
+        ssize_t result = ::pread(fd, buffer + total, N - total, static_cast<off_t>(offset + total));
+        if (result < 0)
+            throw std::runtime_error("Error while reading record log file");
+        if (result == 0)
+            return false;
+        total += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+void pwrite_full(int fd, const uint8_t* buffer, size_t N, uint64_t offset) {
+    size_t total = 0;
+    while (total < N) {
+        ssize_t result = ::pwrite(fd, buffer + total, N - total, static_cast<off_t>(offset + total));
+        if (result <= 0)
+            throw std::runtime_error("Error while writing record log file");
+        total += static_cast<size_t>(result);
+    }
+}
+
+void sync_file(int fd) {
+    if (fdatasync(fd) == -1)
+        throw std::runtime_error("Couldn't sync record log file");
+}
+
+uint32_t record_crc(uint64_t timestamp, const uint8_t* payload, size_t N) {
+    uint8_t bytes[sizeof(timestamp)];
+    encode(timestamp, bytes);
+    return crc32(payload, N, crc32(bytes, sizeof(bytes)));
+}
+
+}
+
+// ----- RecordIndexFile
+
+namespace detail {
+
+RecordIndexFile::RecordIndexFile()
+    : DeviceHandle()
+{}
+
+void RecordIndexFile::open(const std::string& filename, OpenMode mode) {
+    DeviceHandle::open(filename, mode);
+}
+
+size_t RecordIndexFile::size() const {
+    if (!good())
+        return 0;
+    return static_cast<size_t>(file_size(fd_) / entry_size);
+}
+
+RecordIndexEntry RecordIndexFile::get(size_t i) const {
+    uint8_t buffer[entry_size];
+    if (!pread_full(fd_, buffer, entry_size, i * entry_size))
+        throw std::runtime_error("Record log index entry out of range");
+
+    RecordIndexEntry entry;
+    const uint8_t* in = decode(entry.record, buffer);
+    in = decode(entry.timestamp, in);
+    decode(entry.offset, in);
+    return entry;
+}
+
+void RecordIndexFile::truncate(size_t n_entries) {
+    if (ftruncate(fd_, static_cast<off_t>(n_entries * entry_size)) == -1)
+        throw std::runtime_error("Couldn't truncate record log index");
+}
+
+void RecordIndexFile::append(const std::vector<RecordIndexEntry>& entries) {
+    std::vector<uint8_t> buffer(entries.size() * entry_size);
+    uint8_t* out = buffer.data();
+    for (const RecordIndexEntry& entry : entries) {
+        out = encode(entry.record, out);
+        out = encode(entry.timestamp, out);
+        out = encode(entry.offset, out);
+    }
+    pwrite_full(fd_, buffer.data(), buffer.size(), size() * entry_size);
+}
+
+void RecordIndexFile::sync() {
+    sync_file(fd_);
+}
+
+template <typename KeyFunc>
+bool RecordIndexFile::find_last_not_after(uint64_t target, KeyFunc&& key, RecordIndexEntry& entry) const {
+    // Number of entries with key <= target
+    size_t low = 0;
+    size_t high = size();
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        if (key(get(middle)) <= target)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low == 0)
+        return false;
+    entry = get(low - 1);
+    return true;
+}
+
+bool RecordIndexFile::find_record(uint64_t record, RecordIndexEntry& entry) const {
+    return find_last_not_after(record, [] (const RecordIndexEntry& e) { return e.record; }, entry);
+}
+
+bool RecordIndexFile::find_timestamp(uint64_t timestamp, RecordIndexEntry& entry) const {
+    return find_last_not_after(timestamp, [] (const RecordIndexEntry& e) { return e.timestamp; }, entry);
+}
+
+}
+
+// ----- RecordLogWriter
+
+RecordLogWriter::RecordLogWriter()
+    : DeviceHandle(), index_interval_(default_index_interval), commit_bytes_(default_commit_bytes),
+      next_record_(0), end_offset_(0)
+{}
+
+RecordLogWriter::RecordLogWriter(const std::string& filename, size_t index_interval, size_t commit_bytes)
+    : RecordLogWriter()
+{
+    open(filename, index_interval, commit_bytes);
+}
+
+RecordLogWriter::~RecordLogWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Errors are only reported by an explicit close(); uncommitted
+        // records are lost either way
+    }
+}
+
+void RecordLogWriter::open(const std::string& filename, size_t index_interval, size_t commit_bytes) {
+    DeviceHandle::open(filename, OpenMode::ReadWrite);
+    index_.open(filename + ".idx", OpenMode::ReadWrite);
+    if (!good() || !index_.good()) {
+        close();
+        throw std::runtime_error("Couldn't open record log " + filename);
+    }
+
+    index_interval_ = std::max<size_t>(index_interval, 1);
+    commit_bytes_ = commit_bytes;
+    pending_.clear();
+    pending_index_.clear();
+    recover();
+}
+
+void RecordLogWriter::close() {
+    try {
+        if (good())
+            commit();
+    } catch (...) {
+        index_.close();
+        DeviceHandle::close();
+        throw;
+    }
+    index_.close();
+    DeviceHandle::close();
+}
+
+void RecordLogWriter::recover() {
+    const uint64_t data_size = file_size(fd_);
+
+    // Drop index entries for records which didn't make it to the data file
+    size_t n_entries = index_.size();
+    detail::RecordIndexEntry last = {0, 0, 0};
+    while (n_entries > 0 && (last = index_.get(n_entries - 1)).offset >= data_size) {
+        n_entries--;
+    }
+    index_.truncate(n_entries);
+
+    uint64_t record = n_entries > 0 ? last.record : 0;
+    uint64_t offset = n_entries > 0 ? last.offset : 0;
+    std::vector<uint8_t> payload;
+    while (true) {
+        uint8_t header[header_size];
+        if (offset + header_size > data_size || !pread_full(fd_, header, header_size, offset))
+            break;
+
+        uint32_t length;
+        uint32_t crc;
+        uint64_t timestamp;
+        decode(timestamp, decode(crc, decode(length, header)));
+        if (offset + header_size + length > data_size)
+            break;
+
+        payload.resize(length);
+        if (!pread_full(fd_, payload.data(), length, offset + header_size)
+                || record_crc(timestamp, payload.data(), length) != crc)
+            break;
+
+        if (record % index_interval_ == 0 && (n_entries == 0 || record > last.record))
+            pending_index_.push_back({record, timestamp, offset});
+        record++;
+        offset += header_size + length;
+    }
+
+    if (offset < data_size && ftruncate(fd_, static_cast<off_t>(offset)) == -1)
+        throw std::runtime_error("Couldn't truncate torn record log tail");
+
+    next_record_ = record;
+    end_offset_ = offset;
+    commit();
+}
+
+uint64_t RecordLogWriter::append(uint64_t timestamp, Span<const uint8_t> payload) {
+    if (payload.size() > std::numeric_limits<uint32_t>::max())
+        throw std::runtime_error("Record is too large for the record log");
+
+    if (next_record_ % index_interval_ == 0)
+        pending_index_.push_back({next_record_, timestamp, end_offset_ + pending_.size()});
+
+    uint8_t header[header_size];
+    uint8_t* out = encode(static_cast<uint32_t>(payload.size()), header);
+    out = encode(record_crc(timestamp, payload.data(), payload.size()), out);
+    encode(timestamp, out);
+    pending_.insert(pending_.end(), header, header + header_size);
+    pending_.insert(pending_.end(), payload.begin(), payload.end());
+
+    const uint64_t record = next_record_++;
+    if (pending_.size() >= commit_bytes_)
+        commit();
+    return record;
+}
+
+uint64_t RecordLogWriter::append(Span<const uint8_t> payload) {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return append(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()), payload);
+}
+
+void RecordLogWriter::commit() {
+    // Data first, so the index never points past synced data
+    if (!pending_.empty()) {
+        pwrite_full(fd_, pending_.data(), pending_.size(), end_offset_);
+        end_offset_ += pending_.size();
+        pending_.clear();
+        sync_file(fd_);
+    }
+    if (!pending_index_.empty()) {
+        index_.append(pending_index_);
+        pending_index_.clear();
+        index_.sync();
+    }
+}
+
+// ----- RecordLogReader
+
+RecordLogReader::RecordLogReader()
+    : DeviceHandle(), next_record_(0), offset_(0)
+{}
+
+RecordLogReader::RecordLogReader(const std::string& filename)
+    : RecordLogReader()
+{
+    open(filename);
+}
+
+RecordLogReader::~RecordLogReader() {
+    close();
+}
+
+void RecordLogReader::open(const std::string& filename) {
+    DeviceHandle::open(filename, OpenMode::Read);
+    if (!good())
+        throw std::runtime_error("Couldn't open record log " + filename);
+    // A missing index only makes seeks slower
+    index_.open(filename + ".idx", OpenMode::Read);
+    next_record_ = 0;
+    offset_ = 0;
+}
+
+void RecordLogReader::close() {
+    index_.close();
+    DeviceHandle::close();
+}
+
+bool RecordLogReader::read_header(uint64_t offset, uint32_t& length, uint32_t& crc, uint64_t& timestamp) const {
+    uint8_t header[header_size];
+    if (!pread_full(fd_, header, header_size, offset))
+        return false;
+    decode(timestamp, decode(crc, decode(length, header)));
+    return true;
+}
+
+bool RecordLogReader::next(LogRecord& record) {
+    uint32_t length;
+    uint32_t crc;
+    uint64_t timestamp;
+    if (!read_header(offset_, length, crc, timestamp))
+        return false;
+
+    record.payload.resize(length);
+    if (!pread_full(fd_, record.payload.data(), length, offset_ + header_size))
+        return false;
+    if (record_crc(timestamp, record.payload.data(), length) != crc)
+        throw std::runtime_error("Record log CRC mismatch at record " + std::to_string(next_record_));
+
+    record.number = next_record_++;
+    record.timestamp = timestamp;
+    offset_ += header_size + length;
+    return true;
+}
+
+bool RecordLogReader::wait_next(LogRecord& record, std::chrono::milliseconds timeout,
+                                std::chrono::milliseconds poll_interval) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!next(record)) {
+        if (std::chrono::steady_clock::now() >= deadline)
+            return false;
+        std::this_thread::sleep_for(poll_interval);
+    }
+    return true;
+}
+
+bool RecordLogReader::skip() {
+    uint32_t length;
+    uint32_t crc;
+    uint64_t timestamp;
+    if (!read_header(offset_, length, crc, timestamp) || offset_ + header_size + length > file_size(fd_))
+        return false;
+    next_record_++;
+    offset_ += header_size + length;
+    return true;
+}
+
+bool RecordLogReader::seek_record(uint64_t n) {
+    detail::RecordIndexEntry entry;
+    if (index_.find_record(n, entry)) {
+        next_record_ = entry.record;
+        offset_ = entry.offset;
+    } else {
+        next_record_ = 0;
+        offset_ = 0;
+    }
+
+    while (next_record_ < n) {
+        if (!skip())
+            return false;
+    }
+    return true;
+}
+
+bool RecordLogReader::seek_timestamp(uint64_t timestamp) {
+    // Earlier records may share the timestamp of an index entry, so start
+    // from the last entry strictly before it
+    detail::RecordIndexEntry entry;
+    if (timestamp > 0 && index_.find_timestamp(timestamp - 1, entry)) {
+        next_record_ = entry.record;
+        offset_ = entry.offset;
+    } else {
+        next_record_ = 0;
+        offset_ = 0;
+    }
+
+    while (true) {
+        uint32_t length;
+        uint32_t crc;
+        uint64_t record_timestamp;
+        if (!read_header(offset_, length, crc, record_timestamp))
+            return false;
+        if (record_timestamp >= timestamp)
+            return true;
+        if (!skip())
+            return false;
+    }
+}
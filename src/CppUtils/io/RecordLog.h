@@ -0,0 +1,182 @@
+#pragma once
+
+#include "DeviceHandle.h"
+
+#include "CppUtils/container/Span.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * Append-only log of timestamped records.
+ *
+ * The data file is a sequence of records, each
+ *
+ *      [payload length : u32][crc32 : u32][timestamp : u64][payload]
+ *
+ * in little endian, where the CRC covers the timestamp and payload bytes.
+ * A sidecar index file, at path + ".idx", holds one fixed size entry
+ *
+ *      [record number : u64][timestamp : u64][data offset : u64]
+ *
+ * per index_interval records, so seeking to a record number or a timestamp is
+ * a binary search over the index plus a scan of at most index_interval
+ * records. Timestamps are expected to be non-decreasing.
+ */
+namespace detail {
+
+struct RecordIndexEntry {
+    uint64_t record;
+    uint64_t timestamp;
+    uint64_t offset;
+};
+
+/*
+ * The ".idx" file, read and written at explicit offsets.
+ */
+class RecordIndexFile : public DeviceHandle {
+public:
+    constexpr static size_t entry_size = 24;
+
+    RecordIndexFile();
+
+    void open(const std::string& filename, OpenMode mode);
+
+    size_t size() const;
+    RecordIndexEntry get(size_t i) const;
+    void truncate(size_t n_entries);
+    void append(const std::vector<RecordIndexEntry>& entries);
+    void sync();
+
+    /*
+     * Last entry whose record / timestamp is at most the target, if any.
+     */
+    bool find_record(uint64_t record, RecordIndexEntry& entry) const;
+    bool find_timestamp(uint64_t timestamp, RecordIndexEntry& entry) const;
+
+private:
+    template <typename KeyFunc>
+    bool find_last_not_after(uint64_t target, KeyFunc&& key, RecordIndexEntry& entry) const;
+};
+
+}
+
+struct LogRecord {
+    uint64_t number;
+    uint64_t timestamp;
+    std::vector<uint8_t> payload;
+};
+
+/*
+ * Appends records to a log, creating it if needed.
+ *
+ * Records are buffered and written out together by commit(), which then
+ * fdatasync's the data and index files, so a batch of records costs one sync
+ * (group commit). commit() runs automatically once commit_bytes are buffered,
+ * and on close. Only committed records are visible to readers and survive a
+ * crash. A failed commit throws, from close() too, which closes the files
+ * regardless; the destructor swallows the error.
+ *
+ * Opening an existing log recovers it: a torn or corrupt record at the end,
+ * left by a crash during a write, is truncated away along with index entries
+ * past it.
+ */
+class RecordLogWriter : public DeviceHandle {
+public:
+    constexpr static size_t default_index_interval = 1024;
+    constexpr static size_t default_commit_bytes = 1 << 20;
+
+    RecordLogWriter();
+    RecordLogWriter(const std::string& filename, size_t index_interval = default_index_interval,
+                    size_t commit_bytes = default_commit_bytes);
+
+    virtual ~RecordLogWriter();
+
+    void open(const std::string& filename, size_t index_interval = default_index_interval,
+              size_t commit_bytes = default_commit_bytes);
+    virtual void close() override;
+
+    /*
+     * Returns the record number.
+     */
+    uint64_t append(uint64_t timestamp, Span<const uint8_t> payload);
+
+    /*
+     * Timestamped now, in nanoseconds since the epoch.
+     */
+    uint64_t append(Span<const uint8_t> payload);
+
+    void commit();
+
+    /*
+     * Records appended, committed or not.
+     */
+    uint64_t size() const { return next_record_; }
+
+private:
+    detail::RecordIndexFile index_;
+    size_t index_interval_;
+    size_t commit_bytes_;
+
+    uint64_t next_record_;
+    uint64_t end_offset_;
+    std::vector<uint8_t> pending_;
+    std::vector<detail::RecordIndexEntry> pending_index_;
+
+    void recover();
+};
+
+/*
+ * Reads records in order, optionally tailing a log which is still being
+ * written: next() returns false at the current end, and succeeds again once
+ * the writer commits more records.
+ */
+class RecordLogReader : public DeviceHandle {
+public:
+    RecordLogReader();
+    RecordLogReader(const std::string& filename);
+
+    virtual ~RecordLogReader();
+
+    void open(const std::string& filename);
+    virtual void close() override;
+
+    /*
+     * Reads the next record. Returns false if there is no complete record
+     * yet. Throws if a complete record fails its CRC.
+     */
+    bool next(LogRecord& record);
+
+    /*
+     * Like next, polling for up to timeout for a record to be committed.
+     */
+    bool wait_next(LogRecord& record, std::chrono::milliseconds timeout,
+                   std::chrono::milliseconds poll_interval = std::chrono::milliseconds(1));
+
+    /*
+     * Positions the reader on record n. Returns false if there are not yet
+     * that many records, leaving the reader at the end.
+     */
+    bool seek_record(uint64_t n);
+
+    /*
+     * Positions the reader on the first record with a timestamp at or after
+     * timestamp. Returns false if there is none yet.
+     */
+    bool seek_timestamp(uint64_t timestamp);
+
+    /*
+     * Number of the record next() returns.
+     */
+    uint64_t position() const { return next_record_; }
+
+private:
+    detail::RecordIndexFile index_;
+    uint64_t next_record_;
+    uint64_t offset_;
+
+    bool read_header(uint64_t offset, uint32_t& length, uint32_t& crc, uint64_t& timestamp) const;
+    bool skip();
+};
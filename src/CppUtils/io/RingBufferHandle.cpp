@@ -0,0 +1,95 @@
+#include "RingBufferHandle.h"
+
+#include <stdexcept>
+#include <string>
+
+
+RingBufferHandle::RingBufferHandle()
+    : BasicHandle(), ring_(nullptr), timeout_(-1)
+{}
+
+RingBufferHandle::RingBufferHandle(SpscRingBuffer<uint8_t>& ring)
+    : RingBufferHandle()
+{
+    open(ring);
+}
+
+RingBufferHandle::~RingBufferHandle() {
+    close();
+}
+
+void RingBufferHandle::open(SpscRingBuffer<uint8_t>& ring) {
+    ring_ = &ring;
+}
+
+bool RingBufferHandle::good() const {
+    return ring_ != nullptr;
+}
+
+void RingBufferHandle::close() {
+    if (good()) {
+        ring_->close();
+        ring_ = nullptr;
+    }
+}
+
+RingBufferHandle::Clock::time_point RingBufferHandle::deadline() const {
+    if (timeout_.count() < 0)
+        return Clock::time_point::max();
+    return Clock::now() + timeout_;
+}
+
+void RingBufferHandle::_write(const uint8_t* buffer, size_t N) {
+    const Clock::time_point end = deadline();
+    size_t total = 0;
+    while (total < N) {
+        if (ring_->closed())
+            throw std::runtime_error("Ring buffer closed while writing data");
+
+        size_t n = ring_->push(buffer + total, N - total);
+        if (n == 0) {
+            if (!ring_->wait_writable(end))
+                throw std::runtime_error("Timed out writing ring buffer after " + std::to_string(total)
+                                         + " of " + std::to_string(N) + " bytes");
+            continue;
+        }
+        ring_->notify_readable();
+        total += n;
+    }
+}
+
+void RingBufferHandle::_read(uint8_t* buffer, size_t N) {
+    const Clock::time_point end = deadline();
+    size_t total = 0;
+    while (total < N) {
+        size_t n = read_some(buffer + total, N - total, end);
+        if (n == 0) {
+            if (ring_->closed())
+                throw std::runtime_error("End of stream while transferring data (incomplete)");
+            throw std::runtime_error("Timed out reading ring buffer after " + std::to_string(total)
+                                     + " of " + std::to_string(N) + " bytes");
+        }
+        total += n;
+    }
+}
+
+size_t RingBufferHandle::_var_read(uint8_t* buffer, size_t N) {
+    return read_some(buffer, N, deadline());
+}
+
+size_t RingBufferHandle::read_some(uint8_t* buffer, size_t N, Clock::time_point deadline) {
+    if (N == 0)
+        return 0;
+
+    while (true) {
+        // Check closed before popping, so data pushed just before close is not lost
+        bool closed = ring_->closed();
+        size_t n = ring_->pop(buffer, N);
+        if (n > 0) {
+            ring_->notify_writable();
+            return n;
+        }
+        if (closed || !ring_->wait_readable(deadline))
+            return 0;
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "BasicHandle.h"
+
+#include "CppUtils/container/SpscRingBuffer.h"
+
+#include <chrono>
+
+/*
+ * Handle over one end of an in-process byte ring buffer.
+ *
+ * The writer and reader run on different threads, each with its own handle
+ * over the same SpscRingBuffer. Transfers wait for space or data, spinning
+ * briefly and then sleeping until the other side notifies, so an idle side
+ * doesn't hold a core. Closing either handle closes the ring: the reader then
+ * drains what is left and sees the end of the stream, and the writer fails.
+ *
+ * Waits are bounded by the timeout, negative waits forever. var_read returns
+ * 0 on timeout, read and write throw.
+ */
+class RingBufferHandle : public BasicHandle {
+public:
+    RingBufferHandle();
+    RingBufferHandle(SpscRingBuffer<uint8_t>& ring);
+
+    virtual ~RingBufferHandle();
+
+    void open(SpscRingBuffer<uint8_t>& ring);
+    virtual bool good() const override;
+    virtual void close() override;
+
+    void set_timeout(std::chrono::milliseconds timeout) { timeout_ = timeout; }
+    std::chrono::milliseconds timeout() const { return timeout_; }
+
+protected:
+    using Clock = std::chrono::steady_clock;
+
+    SpscRingBuffer<uint8_t>* ring_;
+    std::chrono::milliseconds timeout_;
+
+    Clock::time_point deadline() const;
+
+    /*
+     * Reads what is available, waiting until the deadline if nothing is.
+     * Returns 0 at the end of the stream or on timeout.
+     */
+    size_t read_some(uint8_t* buffer, size_t N, Clock::time_point deadline);
+
+    size_t read_some(Span<uint8_t> buffer, Clock::time_point deadline) {
+        return read_some(buffer.data(), buffer.size(), deadline);
+    }
+
+    void _write(const uint8_t* buffer, size_t N);
+    void _read(uint8_t* buffer, size_t N);
+    size_t _var_read(uint8_t* buffer, size_t N);
+};
+
+using RingBufferWriter = BinaryWriterTemplate<RingBufferHandle>;
+using RingBufferReader = BinaryReaderTemplate<RingBufferHandle>;
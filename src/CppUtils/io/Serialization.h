@@ -0,0 +1,346 @@
+#pragma once
+
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
+
+#include "CppUtils/c_util/ByteArray.h"
+#include "CppUtils/container/Span.h"
+#include "CppUtils/preproc/VariadicMacros.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Declares the wire format of a struct as the listed fields, in order, with no
+ * padding, e.g.
+ *
+ *      struct Sample {
+ *          uint32_t id;
+ *          double value;
+ *          std::array<int16_t, 3> axes;
+ *      };
+ *      CPPUTILS_SERIALIZABLE(Sample, id, value, axes)
+ *
+ * Must be used in the struct's namespace, after its definition. The struct
+ * must be standard layout; fields may be arithmetic types, enums, std::array
+ * or C arrays of those, or other serializable structs.
+ */
+#define CPPUTILS_SERIALIZABLE(Type, ...) \
+    [[maybe_unused]] constexpr auto cpputils_serializable_fields(const Type*) { \
+        static_assert(std::is_standard_layout_v<Type>); \
+        return std::make_tuple(CPPUTILS_DECORATED_1_MAP(COMMA, CPPUTILS_SERIALIZABLE_FIELD, Type, __VA_ARGS__)); \
+    }
+
+#define CPPUTILS_SERIALIZABLE_FIELD(Type, field) ::detail::make_field(&Type::field, offsetof(Type, field))
+
+
+namespace detail {
+
+template <typename T, typename M>
+struct Field {
+    using Type = M;
+
+    M T::* member;
+    size_t offset;
+};
+
+template <typename T, typename M>
+constexpr Field<T, M> make_field(M T::* member, size_t offset) {
+    return Field<T, M>{member, offset};
+}
+
+template <typename T, typename = void>
+struct is_serializable_struct : std::false_type {};
+
+template <typename T>
+struct is_serializable_struct<T, std::void_t<decltype(cpputils_serializable_fields(std::declval<const T*>()))> >
+    : std::true_type {};
+
+template <typename T>
+constexpr auto fields_of() {
+    return cpputils_serializable_fields(static_cast<const T*>(nullptr));
+}
+
+template <typename T>
+struct ArrayTraits {
+    constexpr static bool is_array = false;
+};
+
+template <typename T, size_t N>
+struct ArrayTraits<T[N]> {
+    constexpr static bool is_array = true;
+    using Element = T;
+    constexpr static size_t size = N;
+};
+
+template <typename T, size_t N>
+struct ArrayTraits<std::array<T, N> > {
+    constexpr static bool is_array = true;
+    using Element = T;
+    constexpr static size_t size = N;
+};
+
+/*
+ * Scalars are byte swapped through an unsigned integer of their size, so
+ * only these sizes are supported; long double (16 bytes, partly padding)
+ * and 128-bit integers are not.
+ */
+template <typename T>
+constexpr bool is_serializable_scalar = sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8;
+
+template <size_t N>
+struct UnsignedOfSize;
+
+template <> struct UnsignedOfSize<1> { using Type = uint8_t; };
+template <> struct UnsignedOfSize<2> { using Type = uint16_t; };
+template <> struct UnsignedOfSize<4> { using Type = uint32_t; };
+template <> struct UnsignedOfSize<8> { using Type = uint64_t; };
+
+inline uint8_t byte_swap(uint8_t x) { return x; }
+inline uint16_t byte_swap(uint16_t x) { return __builtin_bswap16(x); }
+inline uint32_t byte_swap(uint32_t x) { return __builtin_bswap32(x); }
+inline uint64_t byte_swap(uint64_t x) { return __builtin_bswap64(x); }
+
+}
+
+template <typename T>
+constexpr bool is_serializable() {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+        return detail::is_serializable_scalar<T>;
+    else if constexpr (detail::ArrayTraits<T>::is_array)
+        return is_serializable<typename detail::ArrayTraits<T>::Element>();
+    else
+        return detail::is_serializable_struct<T>::value;
+}
+
+/*
+ * Size of T on the wire.
+ */
+template <typename T>
+constexpr size_t wire_size() {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+        static_assert(detail::is_serializable_scalar<T>,
+                      "Scalars must be 1, 2, 4 or 8 bytes; long double and 128-bit integers aren't serializable");
+        return sizeof(T);
+    } else if constexpr (!is_serializable<T>()) {
+        static_assert(is_serializable<T>(), "Type isn't serializable, declare it with CPPUTILS_SERIALIZABLE");
+        return 0;
+    } else if constexpr (detail::ArrayTraits<T>::is_array) {
+        return detail::ArrayTraits<T>::size * wire_size<typename detail::ArrayTraits<T>::Element>();
+    } else {
+        return std::apply([] (auto... fields) {
+            return (size_t{0} + ... + wire_size<typename decltype(fields)::Type>());
+        }, detail::fields_of<T>());
+    }
+}
+
+/*
+ * True if the in-memory representation of T is its wire representation, in
+ * which case it is encoded and decoded with memcpy: same byte order (or only
+ * single bytes), no padding, fields in declaration order. bool is excluded
+ * since not every byte is a valid bool.
+ */
+template <typename T, Endianness endian = Endianness::Little>
+constexpr bool has_wire_layout() {
+    if constexpr (std::is_same_v<T, bool>) {
+        return false;
+    } else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+        // wire_size rejects unsupported scalar sizes
+        return wire_size<T>() == 1 || endian == native_endianness;
+    } else if constexpr (detail::ArrayTraits<T>::is_array) {
+        return has_wire_layout<typename detail::ArrayTraits<T>::Element, endian>();
+    } else {
+        if (sizeof(T) != wire_size<T>())
+            return false;
+        return std::apply([] (auto... fields) {
+            size_t offset = 0;
+            bool matches = true;
+            ((matches = matches && fields.offset == offset
+                      && has_wire_layout<typename decltype(fields)::Type, endian>(),
+              offset += wire_size<typename decltype(fields)::Type>()), ...);
+            return matches;
+        }, detail::fields_of<T>());
+    }
+}
+
+/*
+ * Writes value to out, which must have room for wire_size<T>() bytes.
+ * Returns the end of the encoded data.
+ */
+template <Endianness endian = Endianness::Little, typename T>
+uint8_t* encode(const T& value, uint8_t* out) {
+    if constexpr (has_wire_layout<T, endian>()) {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    } else if constexpr (std::is_enum_v<T>) {
+        return encode<endian>(static_cast<std::underlying_type_t<T> >(value), out);
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        using Bits = typename detail::UnsignedOfSize<sizeof(T)>::Type;
+        Bits bits;
+        if constexpr (std::is_same_v<T, bool>) {
+            bits = value ? 1 : 0;
+        } else {
+            std::memcpy(&bits, &value, sizeof(T));
+        }
+        if constexpr (endian != native_endianness) {
+            bits = detail::byte_swap(bits);
+        }
+        std::memcpy(out, &bits, sizeof(T));
+        return out + sizeof(T);
+    } else if constexpr (detail::ArrayTraits<T>::is_array) {
+        for (const auto& element : value) {
+            out = encode<endian>(element, out);
+        }
+        return out;
+    } else {
+        std::apply([&value, &out] (auto... fields) {
+            ((out = encode<endian>(value.*(fields.member), out)), ...);
+        }, detail::fields_of<T>());
+        return out;
+    }
+}
+
+/*
+ * Reads value from in, which must hold wire_size<T>() bytes. Returns the end
+ * of the decoded data.
+ */
+template <Endianness endian = Endianness::Little, typename T>
+const uint8_t* decode(T& value, const uint8_t* in) {
+    if constexpr (has_wire_layout<T, endian>()) {
+        std::memcpy(&value, in, sizeof(T));
+        return in + sizeof(T);
+    } else if constexpr (std::is_enum_v<T>) {
+        std::underlying_type_t<T> underlying;
+        in = decode<endian>(underlying, in);
+        value = static_cast<T>(underlying);
+        return in;
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        using Bits = typename detail::UnsignedOfSize<sizeof(T)>::Type;
+        Bits bits;
+        std::memcpy(&bits, in, sizeof(T));
+        if constexpr (endian != native_endianness) {
+            bits = detail::byte_swap(bits);
+        }
+        if constexpr (std::is_same_v<T, bool>) {
+            value = bits != 0;
+        } else {
+            std::memcpy(&value, &bits, sizeof(T));
+        }
+        return in + sizeof(T);
+    } else if constexpr (detail::ArrayTraits<T>::is_array) {
+        for (auto& element : value) {
+            in = decode<endian>(element, in);
+        }
+        return in;
+    } else {
+        std::apply([&value, &in] (auto... fields) {
+            ((in = decode<endian>(value.*(fields.member), in)), ...);
+        }, detail::fields_of<T>());
+        return in;
+    }
+}
+
+/*
+ * Bulk versions; a single memcpy when T has the wire layout.
+ */
+template <Endianness endian = Endianness::Little, typename T>
+uint8_t* encode_array(const T* values, size_t N, uint8_t* out) {
+    if constexpr (has_wire_layout<T, endian>()) {
+        std::memcpy(out, values, N * sizeof(T));
+        return out + N * sizeof(T);
+    } else {
+        for (size_t i = 0; i < N; i++) {
+            out = encode<endian>(values[i], out);
+        }
+        return out;
+    }
+}
+
+template <Endianness endian = Endianness::Little, typename T>
+const uint8_t* decode_array(T* values, size_t N, const uint8_t* in) {
+    if constexpr (has_wire_layout<T, endian>()) {
+        std::memcpy(values, in, N * sizeof(T));
+        return in + N * sizeof(T);
+    } else {
+        for (size_t i = 0; i < N; i++) {
+            in = decode<endian>(values[i], in);
+        }
+        return in;
+    }
+}
+
+
+// ----- reader / writer helpers
+
+template <Endianness endian = Endianness::Little, typename T>
+void write_serialized(BinaryWriter& writer, const T& value) {
+    if constexpr (has_wire_layout<T, endian>()) {
+        writer.write(value);
+    } else {
+        uint8_t buffer[wire_size<T>()];
+        encode<endian>(value, buffer);
+        writer.write(buffer, sizeof(buffer));
+    }
+}
+
+template <Endianness endian = Endianness::Little, typename T>
+void read_serialized(BinaryReader& reader, T& value) {
+    if constexpr (has_wire_layout<T, endian>()) {
+        reader.read(value);
+    } else {
+        uint8_t buffer[wire_size<T>()];
+        reader.read(buffer, sizeof(buffer));
+        decode<endian>(value, buffer);
+    }
+}
+
+namespace detail {
+
+constexpr size_t serialization_chunk_size = 4096;
+
+template <typename T>
+constexpr size_t values_per_chunk() {
+    return wire_size<T>() >= serialization_chunk_size ? 1 : serialization_chunk_size / wire_size<T>();
+}
+
+}
+
+/*
+ * Writes the values back to back. Values without the wire layout are encoded
+ * through a stack buffer, a few kilobytes per write call.
+ */
+template <Endianness endian = Endianness::Little, typename T>
+void write_serialized(BinaryWriter& writer, Span<const T> values) {
+    if constexpr (has_wire_layout<T, endian>()) {
+        writer.write(values.data(), values.size());
+    } else {
+        constexpr size_t chunk = detail::values_per_chunk<T>();
+        uint8_t buffer[chunk * wire_size<T>()];
+        for (size_t i = 0; i < values.size(); i += chunk) {
+            const size_t n = std::min(chunk, values.size() - i);
+            encode_array<endian>(values.data() + i, n, buffer);
+            writer.write(buffer, n * wire_size<T>());
+        }
+    }
+}
+
+template <Endianness endian = Endianness::Little, typename T>
+void read_serialized(BinaryReader& reader, Span<T> values) {
+    if constexpr (has_wire_layout<T, endian>()) {
+        reader.read(values.data(), values.size());
+    } else {
+        constexpr size_t chunk = detail::values_per_chunk<T>();
+        uint8_t buffer[chunk * wire_size<T>()];
+        for (size_t i = 0; i < values.size(); i += chunk) {
+            const size_t n = std::min(chunk, values.size() - i);
+            reader.read(buffer, n * wire_size<T>());
+            decode_array<endian>(values.data() + i, n, buffer);
+        }
+    }
+}
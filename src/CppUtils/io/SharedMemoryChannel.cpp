@@ -0,0 +1,348 @@
+#include "SharedMemoryChannel.h"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr uint64_t channel_magic = 0x4350555348524e47; // "CPUSHRNG"
+
+// Checks of the ring before a waiting side goes to sleep
+constexpr size_t spin_count = 128;
+
+static_assert(sizeof(detail::SharedRingHeader) <= SharedMemoryChannel::data_offset);
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "Shared memory atomics must be lock free");
+
+uint32_t* futex_word(std::atomic<uint32_t>& word) {
+    return reinterpret_cast<uint32_t*>(&word);
+}
+
+// Not FUTEX_PRIVATE_FLAG: the word is shared between processes
+void futex_wait(std::atomic<uint32_t>& word, uint32_t expected, const timespec* timeout) {
+    syscall(SYS_futex, futex_word(word), FUTEX_WAIT, expected, timeout, nullptr, 0);
+}
+
+void futex_wake(std::atomic<uint32_t>& word) {
+    syscall(SYS_futex, futex_word(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+std::runtime_error system_error(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+}
+
+SharedMemoryChannel::SharedMemoryChannel()
+    : BasicHandle(), fd_(-1), mapping_(nullptr), mapping_size_(0), capacity_(0), header_(nullptr), data_(nullptr),
+      timeout_(-1), cached_read_(0), cached_write_(0)
+{}
+
+SharedMemoryChannel::SharedMemoryChannel(const std::string& name, size_t capacity)
+    : SharedMemoryChannel()
+{
+    create(name, capacity);
+}
+
+SharedMemoryChannel::SharedMemoryChannel(const std::string& name)
+    : SharedMemoryChannel()
+{
+    open(name);
+}
+
+SharedMemoryChannel::~SharedMemoryChannel() {
+    close();
+}
+
+void SharedMemoryChannel::create(const std::string& name, size_t capacity) {
+    close();
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0)
+        throw system_error("Couldn't create shared memory channel " + name);
+
+    capacity = layout::next_power_of_two(std::max<size_t>(capacity, 1));
+    if (ftruncate(fd, static_cast<off_t>(data_offset + capacity)) != 0) {
+        std::runtime_error error = system_error("Couldn't size shared memory channel " + name);
+        ::close(fd);
+        shm_unlink(name.c_str());
+        throw error;
+    }
+    map(fd, data_offset + capacity);
+
+    header_->capacity = capacity;
+    header_->closed.store(0, std::memory_order_relaxed);
+    header_->write_index.store(0, std::memory_order_relaxed);
+    header_->data_seq.store(0, std::memory_order_relaxed);
+    header_->readers_waiting.store(0, std::memory_order_relaxed);
+    header_->read_index.store(0, std::memory_order_relaxed);
+    header_->space_seq.store(0, std::memory_order_relaxed);
+    header_->writers_waiting.store(0, std::memory_order_relaxed);
+    header_->magic.store(channel_magic, std::memory_order_release);
+    capacity_ = capacity;
+}
+
+void SharedMemoryChannel::create_anonymous(size_t capacity) {
+    close();
+    int fd = memfd_create("cpputils-channel", MFD_CLOEXEC);
+    if (fd < 0)
+        throw system_error("Couldn't create anonymous shared memory channel");
+
+    capacity = layout::next_power_of_two(std::max<size_t>(capacity, 1));
+    if (ftruncate(fd, static_cast<off_t>(data_offset + capacity)) != 0) {
+        std::runtime_error error = system_error("Couldn't size anonymous shared memory channel");
+        ::close(fd);
+        throw error;
+    }
+    map(fd, data_offset + capacity);
+
+    // A fresh memfd reads as zeros, which is the initial state of every field
+    header_->capacity = capacity;
+    header_->magic.store(channel_magic, std::memory_order_release);
+    capacity_ = capacity;
+}
+
+void SharedMemoryChannel::open(const std::string& name) {
+    close();
+    int fd = shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+    if (fd < 0)
+        throw system_error("Couldn't open shared memory channel " + name);
+    open_fd(fd);
+}
+
+void SharedMemoryChannel::open_fd(int fd) {
+    if (fd == fd_) {
+        // Remapping our own descriptor, which mustn't close the channel
+        unmap();
+        fd_ = -1;
+    } else {
+        close();
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        std::runtime_error error = system_error("Couldn't stat shared memory channel");
+        ::close(fd);
+        throw error;
+    }
+    const size_t size = static_cast<size_t>(status.st_size);
+    if (size <= data_offset) {
+        ::close(fd);
+        throw std::runtime_error("Shared memory channel isn't initialized");
+    }
+    map(fd, size);
+
+    if (header_->magic.load(std::memory_order_acquire) != channel_magic
+            || header_->capacity + data_offset != size) {
+        close();
+        throw std::runtime_error("Shared memory channel isn't initialized");
+    }
+    capacity_ = header_->capacity;
+    cached_read_ = header_->read_index.load(std::memory_order_acquire);
+    cached_write_ = header_->write_index.load(std::memory_order_acquire);
+}
+
+void SharedMemoryChannel::map(int fd, size_t size) {
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        std::runtime_error error = system_error("Couldn't map shared memory channel");
+        ::close(fd);
+        throw error;
+    }
+
+    fd_ = fd;
+    mapping_ = static_cast<uint8_t*>(mapping);
+    mapping_size_ = size;
+    header_ = reinterpret_cast<detail::SharedRingHeader*>(mapping_);
+    data_ = mapping_ + data_offset;
+    cached_read_ = 0;
+    cached_write_ = 0;
+}
+
+void SharedMemoryChannel::unmap() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mapping_size_);
+        mapping_ = nullptr;
+        header_ = nullptr;
+        data_ = nullptr;
+    }
+}
+
+void SharedMemoryChannel::unlink(const std::string& name) {
+    if (shm_unlink(name.c_str()) != 0 && errno != ENOENT)
+        throw system_error("Couldn't unlink shared memory channel " + name);
+}
+
+bool SharedMemoryChannel::good() const {
+    return header_ != nullptr;
+}
+
+void SharedMemoryChannel::close() {
+    if (header_ != nullptr && header_->magic.load(std::memory_order_acquire) == channel_magic) {
+        header_->closed.store(1, std::memory_order_release);
+        header_->data_seq.fetch_add(1, std::memory_order_release);
+        header_->space_seq.fetch_add(1, std::memory_order_release);
+        futex_wake(header_->data_seq);
+        futex_wake(header_->space_seq);
+    }
+    unmap();
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+Clock::time_point SharedMemoryChannel::deadline() const {
+    if (timeout_.count() < 0)
+        return Clock::time_point::max();
+    return Clock::now() + timeout_;
+}
+
+template <typename Ready>
+bool SharedMemoryChannel::wait(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& waiting, Ready&& ready,
+                               Clock::time_point deadline) {
+    auto done = [this, &ready] {
+        return ready() || header_->closed.load(std::memory_order_acquire) != 0;
+    };
+
+    for (size_t i = 0; i < spin_count; i++) {
+        if (done())
+            return true;
+    }
+
+    while (true) {
+        // Announce the waiter before the last check; notify() checks in the
+        // opposite order, so either we see its update or it sees us
+        const uint32_t observed = seq.load(std::memory_order_acquire);
+        waiting.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (done()) {
+            waiting.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        timespec timeout;
+        const timespec* timeout_ptr = nullptr;
+        if (deadline != Clock::time_point::max()) {
+            const auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - Clock::now());
+            if (left.count() <= 0) {
+                waiting.fetch_sub(1, std::memory_order_relaxed);
+                return false;
+            }
+            timeout.tv_sec = static_cast<time_t>(left.count() / 1000000000);
+            timeout.tv_nsec = static_cast<long>(left.count() % 1000000000);
+            timeout_ptr = &timeout;
+        }
+
+        futex_wait(seq, observed, timeout_ptr);
+        waiting.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+void SharedMemoryChannel::notify(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& waiting) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed) != 0) {
+        seq.fetch_add(1, std::memory_order_release);
+        futex_wake(seq);
+    }
+}
+
+void SharedMemoryChannel::_write(const uint8_t* buffer, size_t N) {
+    const Clock::time_point end = deadline();
+    uint64_t write = header_->write_index.load(std::memory_order_relaxed);
+    size_t total = 0;
+    while (total < N) {
+        if (header_->closed.load(std::memory_order_acquire))
+            throw std::runtime_error("Shared memory channel closed while writing data");
+
+        size_t space = capacity_ - static_cast<size_t>(write - cached_read_);
+        if (space == 0) {
+            cached_read_ = header_->read_index.load(std::memory_order_acquire);
+            space = capacity_ - static_cast<size_t>(write - cached_read_);
+        }
+        if (space == 0) {
+            const uint64_t read = cached_read_;
+            if (!wait(header_->space_seq, header_->writers_waiting,
+                      [this, read] { return header_->read_index.load(std::memory_order_acquire) != read; }, end))
+                throw std::runtime_error("Timed out writing shared memory channel after " + std::to_string(total)
+                                         + " of " + std::to_string(N) + " bytes");
+            continue;
+        }
+
+        const size_t n = std::min(space, N - total);
+        const size_t offset = static_cast<size_t>(write) & (capacity_ - 1);
+        const size_t first = std::min(n, capacity_ - offset);
+        std::memcpy(data_ + offset, buffer + total, first);
+        std::memcpy(data_, buffer + total + first, n - first);
+
+        write += n;
+        total += n;
+        header_->write_index.store(write, std::memory_order_release);
+        notify(header_->data_seq, header_->readers_waiting);
+    }
+}
+
+size_t SharedMemoryChannel::read_some(uint8_t* buffer, size_t N, Clock::time_point deadline) {
+    const uint64_t read = header_->read_index.load(std::memory_order_relaxed);
+    while (true) {
+        size_t available = static_cast<size_t>(cached_write_ - read);
+        if (available == 0) {
+            // Check closed before reloading, so data written just before close is not lost
+            const bool closed = header_->closed.load(std::memory_order_acquire);
+            cached_write_ = header_->write_index.load(std::memory_order_acquire);
+            available = static_cast<size_t>(cached_write_ - read);
+            if (available == 0) {
+                if (closed)
+                    return 0;
+                if (!wait(header_->data_seq, header_->readers_waiting,
+                          [this, read] { return header_->write_index.load(std::memory_order_acquire) != read; },
+                          deadline))
+                    return 0;
+                continue;
+            }
+        }
+
+        const size_t n = std::min(available, N);
+        const size_t offset = static_cast<size_t>(read) & (capacity_ - 1);
+        const size_t first = std::min(n, capacity_ - offset);
+        std::memcpy(buffer, data_ + offset, first);
+        std::memcpy(buffer + first, data_, n - first);
+
+        header_->read_index.store(read + n, std::memory_order_release);
+        notify(header_->space_seq, header_->writers_waiting);
+        return n;
+    }
+}
+
+void SharedMemoryChannel::_read(uint8_t* buffer, size_t N) {
+    const Clock::time_point end = deadline();
+    size_t total = 0;
+    while (total < N) {
+        const size_t n = read_some(buffer + total, N - total, end);
+        if (n == 0) {
+            if (header_->closed.load(std::memory_order_acquire))
+                throw std::runtime_error("End of stream while transferring data (incomplete)");
+            throw std::runtime_error("Timed out reading shared memory channel after " + std::to_string(total)
+                                     + " of " + std::to_string(N) + " bytes");
+        }
+        total += n;
+    }
+}
+
+size_t SharedMemoryChannel::_var_read(uint8_t* buffer, size_t N) {
+    if (N == 0)
+        return 0;
+    return read_some(buffer, N, deadline());
+}
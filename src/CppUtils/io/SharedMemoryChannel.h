@@ -0,0 +1,139 @@
+#pragma once
+
+#include "BasicHandle.h"
+
+#include "CppUtils/container/Layout.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace detail {
+
+/*
+ * Control block at the start of the shared segment, followed by the data
+ * ring at SharedMemoryChannel::data_offset. Each side's index and futex word
+ * sit on their own cache line.
+ */
+struct SharedRingHeader {
+    // Set last by the creator, once the rest is initialized
+    std::atomic<uint64_t> magic;
+    uint64_t capacity;
+    std::atomic<uint32_t> closed;
+
+    // Producer side: write_index, bumped data_seq to wake readers
+    alignas(layout::cache_line_size) std::atomic<uint64_t> write_index;
+    std::atomic<uint32_t> data_seq;
+    std::atomic<uint32_t> readers_waiting;
+
+    // Consumer side: read_index, bumped space_seq to wake writers
+    alignas(layout::cache_line_size) std::atomic<uint64_t> read_index;
+    std::atomic<uint32_t> space_seq;
+    std::atomic<uint32_t> writers_waiting;
+};
+
+}
+
+/*
+ * Single-producer / single-consumer byte channel between processes, over a
+ * lock-free ring in shared memory.
+ *
+ * One process create()s the channel, under a POSIX shared memory name or
+ * anonymously with memfd_create (the fd is then handed to the other process by
+ * fork or SCM_RIGHTS), and the other open()s it. Data is copied once into the
+ * ring and once out of it, with no syscall while the ring is neither empty
+ * nor full; a side that must wait spins briefly, then sleeps on a futex which
+ * the other side only wakes when someone is waiting.
+ *
+ * As with RingBufferHandle, closing either end closes the channel: the reader
+ * drains what is left and then sees the end of the stream, the writer fails.
+ * Waits are bounded by the timeout, negative waits forever.
+ */
+class SharedMemoryChannel : public BasicHandle {
+public:
+    constexpr static size_t data_offset = 4096;
+
+    SharedMemoryChannel();
+
+    /*
+     * Creates the named channel with room for capacity bytes, rounded up to
+     * a power of two.
+     */
+    SharedMemoryChannel(const std::string& name, size_t capacity);
+
+    /*
+     * Opens a channel created by another handle.
+     */
+    SharedMemoryChannel(const std::string& name);
+
+    virtual ~SharedMemoryChannel();
+
+    void create(const std::string& name, size_t capacity);
+    void open(const std::string& name);
+
+    /*
+     * Channel backed by a memfd; fd() is then the descriptor to share.
+     */
+    void create_anonymous(size_t capacity);
+
+    /*
+     * Maps the channel behind a descriptor from create_anonymous, in this or
+     * another process. Takes ownership of fd. Given this handle's own fd(),
+     * remaps the channel without closing it.
+     */
+    void open_fd(int fd);
+
+    /*
+     * Removes the name; handles which mapped the channel keep working.
+     */
+    static void unlink(const std::string& name);
+
+    virtual bool good() const override;
+    virtual void close() override;
+
+    int fd() const { return fd_; }
+    size_t capacity() const { return capacity_; }
+
+    void set_timeout(std::chrono::milliseconds timeout) { timeout_ = timeout; }
+    std::chrono::milliseconds timeout() const { return timeout_; }
+
+protected:
+    int fd_;
+    uint8_t* mapping_;
+    size_t mapping_size_;
+    size_t capacity_;
+    detail::SharedRingHeader* header_;
+    uint8_t* data_;
+    std::chrono::milliseconds timeout_;
+
+    // Last seen index of the other side, refreshed only when the ring looks
+    // full or empty
+    uint64_t cached_read_;
+    uint64_t cached_write_;
+
+    void _write(const uint8_t* buffer, size_t N);
+    void _read(uint8_t* buffer, size_t N);
+
+    /*
+     * Returns 0 at the end of the stream or if no data arrived in time.
+     */
+    size_t _var_read(uint8_t* buffer, size_t N);
+
+private:
+    void map(int fd, size_t size);
+    void unmap();
+    size_t read_some(uint8_t* buffer, size_t N, std::chrono::steady_clock::time_point deadline);
+    std::chrono::steady_clock::time_point deadline() const;
+
+    /*
+     * Blocks until ready() or the channel is closed; false on timeout.
+     */
+    template <typename Ready>
+    bool wait(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& waiting, Ready&& ready,
+              std::chrono::steady_clock::time_point deadline);
+    static void notify(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& waiting);
+};
+
+using SharedMemoryWriter = BinaryWriterTemplate<SharedMemoryChannel>;
+using SharedMemoryReader = BinaryReaderTemplate<SharedMemoryChannel>;
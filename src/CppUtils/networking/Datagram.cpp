@@ -0,0 +1,374 @@
+#include "Datagram.h"
+
+#include "CppUtils/c_util/CUtil.h"
+
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr size_t control_size = CMSG_SPACE(sizeof(timespec)) + CMSG_SPACE(sizeof(int));
+
+void set_option(int fd, int level, int name, int value, const char* label) {
+    if (setsockopt(fd, level, name, &value, sizeof(value)) < 0)
+        throw std::runtime_error(std::string("Error setting socket option ") + label + ": " + std::strerror(errno));
+}
+
+std::runtime_error socket_error(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+/*
+ * IPv4 address as an IPv4-mapped IPv6 one (::ffff:a.b.c.d), which a
+ * dual-stack socket sends to.
+ */
+SocketAddress map_to_ipv6(const SocketAddress& address) {
+    const sockaddr_in& ipv4 = reinterpret_cast<const sockaddr_in&>(address.storage);
+    SocketAddress mapped;
+    initialize_zero(mapped.storage);
+    sockaddr_in6& ipv6 = reinterpret_cast<sockaddr_in6&>(mapped.storage);
+    ipv6.sin6_family = AF_INET6;
+    ipv6.sin6_port = ipv4.sin_port;
+    ipv6.sin6_addr.s6_addr[10] = 0xff;
+    ipv6.sin6_addr.s6_addr[11] = 0xff;
+    std::memcpy(&ipv6.sin6_addr.s6_addr[12], &ipv4.sin_addr, sizeof(ipv4.sin_addr));
+    mapped.length = sizeof(sockaddr_in6);
+    return mapped;
+}
+
+/*
+ * Turns an IPv4-mapped source, as dual-stack sockets report IPv4 senders,
+ * back into an IPv4 address.
+ */
+void unmap_ipv4(SocketAddress& address) {
+    const sockaddr_in6 ipv6 = reinterpret_cast<const sockaddr_in6&>(address.storage);
+    if (address.family() != AF_INET6 || !IN6_IS_ADDR_V4MAPPED(&ipv6.sin6_addr))
+        return;
+    initialize_zero(address.storage);
+    sockaddr_in& ipv4 = reinterpret_cast<sockaddr_in&>(address.storage);
+    ipv4.sin_family = AF_INET;
+    ipv4.sin_port = ipv6.sin6_port;
+    std::memcpy(&ipv4.sin_addr, &ipv6.sin6_addr.s6_addr[12], sizeof(ipv4.sin_addr));
+    address.length = sizeof(sockaddr_in);
+}
+
+}
+
+// ----- DatagramBatch
+
+DatagramBatch::DatagramBatch(size_t capacity, size_t max_size)
+    : max_size_(max_size), size_(0), data_(capacity * max_size), headers_(capacity), iovecs_(capacity),
+      addresses_(capacity), control_(capacity * control_size), segment_sizes_(capacity), timestamps_(capacity)
+{
+    if (capacity == 0 || max_size == 0)
+        throw std::runtime_error("Datagram batch needs at least one slot of at least one byte");
+}
+
+Datagram DatagramBatch::operator[](size_t i) const {
+    const msghdr& header = headers_[i].msg_hdr;
+    return Datagram{
+        Span<const uint8_t>(data_.data() + i * max_size_, iovecs_[i].iov_len),
+        addresses_[i],
+        timestamps_[i],
+        segment_sizes_[i],
+        (header.msg_flags & MSG_TRUNC) != 0,
+    };
+}
+
+bool DatagramBatch::add(const uint8_t* data, size_t N) {
+    if (full())
+        return false;
+    if (N > max_size_)
+        throw std::runtime_error("Datagram of " + std::to_string(N) + " bytes doesn't fit a " + std::to_string(max_size_)
+                                 + " byte slot");
+
+    const size_t i = size_++;
+    std::memcpy(slot(i), data, N);
+    iovecs_[i] = iovec{slot(i), N};
+    initialize_zero(headers_[i]);
+    headers_[i].msg_hdr.msg_iov = &iovecs_[i];
+    headers_[i].msg_hdr.msg_iovlen = 1;
+    return true;
+}
+
+bool DatagramBatch::add(const uint8_t* data, size_t N, const SocketAddress& destination) {
+    if (!add(data, N))
+        return false;
+    const size_t i = size_ - 1;
+    addresses_[i] = destination;
+    headers_[i].msg_hdr.msg_name = &addresses_[i].storage;
+    headers_[i].msg_hdr.msg_namelen = destination.length;
+    return true;
+}
+
+void DatagramBatch::prepare_receive() {
+    size_ = 0;
+    for (size_t i = 0; i < capacity(); i++) {
+        iovecs_[i] = iovec{slot(i), max_size_};
+        initialize_zero(headers_[i]);
+        msghdr& header = headers_[i].msg_hdr;
+        header.msg_iov = &iovecs_[i];
+        header.msg_iovlen = 1;
+        header.msg_name = &addresses_[i].storage;
+        header.msg_namelen = sizeof(sockaddr_storage);
+        header.msg_control = control_.data() + i * control_size;
+        header.msg_controllen = control_size;
+    }
+}
+
+void DatagramBatch::parse_control(size_t i) {
+    msghdr& header = headers_[i].msg_hdr;
+    iovecs_[i].iov_len = std::min<size_t>(headers_[i].msg_len, max_size_);
+    addresses_[i].length = header.msg_namelen;
+    unmap_ipv4(addresses_[i]);
+    timestamps_[i] = 0;
+    segment_sizes_[i] = 0;
+
+    for (cmsghdr* message = CMSG_FIRSTHDR(&header); message != nullptr; message = CMSG_NXTHDR(&header, message)) {
+        if (message->cmsg_level == SOL_SOCKET && message->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec time;
+            std::memcpy(&time, CMSG_DATA(message), sizeof(time));
+            timestamps_[i] = static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+        } else if (message->cmsg_level == SOL_UDP && message->cmsg_type == UDP_GRO) {
+            int segment_size;
+            std::memcpy(&segment_size, CMSG_DATA(message), sizeof(segment_size));
+            if (static_cast<size_t>(segment_size) < iovecs_[i].iov_len)
+                segment_sizes_[i] = static_cast<size_t>(segment_size);
+        }
+    }
+}
+
+// ----- DatagramHandle
+
+DatagramHandle::DatagramHandle()
+    : BasicHandle(), socket_fd_(-1), family_(AF_INET)
+{}
+
+DatagramHandle::~DatagramHandle() {
+    close();
+}
+
+bool DatagramHandle::good() const {
+    return socket_fd_ >= 0;
+}
+
+void DatagramHandle::close() {
+    if (good()) {
+        ::close(socket_fd_);
+        socket_fd_ = -1;
+    }
+}
+
+void DatagramHandle::open_socket(int family, const DatagramOptions& options) {
+    close();
+    socket_fd_ = socket(family, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (!good() && family == AF_INET6 && errno == EAFNOSUPPORT) {
+        // No IPv6 support
+        family = AF_INET;
+        socket_fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    }
+    if (!good())
+        throw socket_error("Error opening datagram socket");
+    family_ = family;
+
+    if (family == AF_INET6)
+        set_option(socket_fd_, IPPROTO_IPV6, IPV6_V6ONLY, 0, "IPV6_V6ONLY");
+
+    if (options.reuse_address)
+        set_option(socket_fd_, SOL_SOCKET, SO_REUSEADDR, 1, "SO_REUSEADDR");
+    if (options.reuse_port)
+        set_option(socket_fd_, SOL_SOCKET, SO_REUSEPORT, 1, "SO_REUSEPORT");
+    if (options.timestamps)
+        set_option(socket_fd_, SOL_SOCKET, SO_TIMESTAMPNS, 1, "SO_TIMESTAMPNS");
+    if (options.gro)
+        set_option(socket_fd_, SOL_UDP, UDP_GRO, 1, "UDP_GRO");
+    if (options.send_buffer > 0)
+        set_option(socket_fd_, SOL_SOCKET, SO_SNDBUF, options.send_buffer, "SO_SNDBUF");
+    if (options.receive_buffer > 0)
+        set_option(socket_fd_, SOL_SOCKET, SO_RCVBUF, options.receive_buffer, "SO_RCVBUF");
+}
+
+void DatagramHandle::open(const DatagramOptions& options) {
+    open_socket(AF_INET6, options);
+}
+
+void DatagramHandle::bind(int port, const DatagramOptions& options) {
+    open_socket(AF_INET6, options);
+
+    SocketAddress address;
+    initialize_zero(address.storage);
+    if (family_ == AF_INET6) {
+        sockaddr_in6& any = reinterpret_cast<sockaddr_in6&>(address.storage);
+        any.sin6_family = AF_INET6;
+        any.sin6_addr = in6addr_any;
+        address.length = sizeof(sockaddr_in6);
+    } else {
+        sockaddr_in& any = reinterpret_cast<sockaddr_in&>(address.storage);
+        any.sin_family = AF_INET;
+        any.sin_addr.s_addr = INADDR_ANY;
+        address.length = sizeof(sockaddr_in);
+    }
+    address.set_port(port);
+    if (::bind(socket_fd_, address.data(), address.length) < 0)
+        throw socket_error("Error binding datagram socket to port " + std::to_string(port));
+}
+
+void DatagramHandle::connect(const std::string& hostname, int port, const DatagramOptions& options) {
+    const std::vector<SocketAddress> addresses = Resolver::shared().resolve(hostname, port);
+    for (const SocketAddress& peer : addresses) {
+        open_socket(peer.family(), options);
+        const SocketAddress target = family_ == AF_INET6 && peer.family() == AF_INET ? map_to_ipv6(peer) : peer;
+        if (::connect(socket_fd_, target.data(), target.length) == 0)
+            return;
+    }
+    std::runtime_error error = socket_error("Error connecting datagram socket to " + hostname);
+    close();
+    throw error;
+}
+
+SocketAddress DatagramHandle::address(const std::string& hostname, int port) {
+    return Resolver::shared().resolve(hostname, port).front();
+}
+
+int DatagramHandle::local_port() const {
+    SocketAddress address;
+    address.length = sizeof(address.storage);
+    if (getsockname(socket_fd_, reinterpret_cast<sockaddr*>(&address.storage), &address.length) < 0)
+        throw socket_error("Error getting socket address");
+    return address.port();
+}
+
+size_t DatagramHandle::receive(DatagramBatch& batch, int flags) {
+    batch.prepare_receive();
+    int result;
+    do {
+        result = recvmmsg(socket_fd_, batch.headers_.data(), static_cast<unsigned>(batch.capacity()), flags, nullptr);
+    } while (result < 0 && errno == EINTR);
+
+    if (result < 0) {
+        if ((flags & MSG_DONTWAIT) && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return 0;
+        throw socket_error("Error receiving datagrams");
+    }
+
+    batch.size_ = static_cast<size_t>(result);
+    for (size_t i = 0; i < batch.size_; i++) {
+        batch.parse_control(i);
+    }
+    return batch.size_;
+}
+
+size_t DatagramHandle::receive(DatagramBatch& batch) {
+    return receive(batch, MSG_WAITFORONE);
+}
+
+size_t DatagramHandle::try_receive(DatagramBatch& batch) {
+    return receive(batch, MSG_DONTWAIT);
+}
+
+void DatagramHandle::send(DatagramBatch& batch) {
+    if (family_ == AF_INET6) {
+        for (size_t i = 0; i < batch.size(); i++) {
+            SocketAddress& destination = batch.addresses_[i];
+            if (batch.headers_[i].msg_hdr.msg_name != nullptr && destination.family() == AF_INET) {
+                destination = map_to_ipv6(destination);
+                batch.headers_[i].msg_hdr.msg_namelen = destination.length;
+            }
+        }
+    }
+
+    size_t sent = 0;
+    while (sent < batch.size()) {
+        int result = sendmmsg(socket_fd_, batch.headers_.data() + sent, static_cast<unsigned>(batch.size() - sent), 0);
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+            throw socket_error("Error sending datagrams");
+        }
+        sent += static_cast<size_t>(result);
+    }
+    batch.clear();
+}
+
+void DatagramHandle::send_message(const uint8_t* buffer, size_t N, uint16_t segment_size,
+                                  const SocketAddress* destination) {
+    iovec data{const_cast<uint8_t*>(buffer), N};
+    msghdr header;
+    initialize_zero(header);
+    header.msg_iov = &data;
+    header.msg_iovlen = 1;
+
+    SocketAddress mapped;
+    if (destination != nullptr) {
+        if (family_ == AF_INET6 && destination->family() == AF_INET) {
+            mapped = map_to_ipv6(*destination);
+            destination = &mapped;
+        }
+        header.msg_name = const_cast<sockaddr_storage*>(&destination->storage);
+        header.msg_namelen = destination->length;
+    }
+
+    alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(uint16_t))];
+    if (segment_size > 0) {
+        initialize_zero(control);
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+        cmsghdr* message = CMSG_FIRSTHDR(&header);
+        message->cmsg_level = SOL_UDP;
+        message->cmsg_type = UDP_SEGMENT;
+        message->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        std::memcpy(CMSG_DATA(message), &segment_size, sizeof(segment_size));
+    }
+
+    ssize_t result;
+    do {
+        result = sendmsg(socket_fd_, &header, 0);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0)
+        throw socket_error("Error sending datagram");
+}
+
+void DatagramHandle::send_to(const uint8_t* buffer, size_t N, const SocketAddress& destination) {
+    send_message(buffer, N, 0, &destination);
+}
+
+void DatagramHandle::send_segmented(const uint8_t* buffer, size_t N, uint16_t segment_size) {
+    send_message(buffer, N, segment_size, nullptr);
+}
+
+void DatagramHandle::send_segmented(const uint8_t* buffer, size_t N, uint16_t segment_size,
+                                    const SocketAddress& destination) {
+    send_message(buffer, N, segment_size, &destination);
+}
+
+void DatagramHandle::_write(const uint8_t* buffer, size_t N) {
+    send_message(buffer, N, 0, nullptr);
+}
+
+void DatagramHandle::_read(uint8_t* buffer, size_t N) {
+    ssize_t result;
+    do {
+        result = ::recv(socket_fd_, buffer, N, MSG_TRUNC);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0)
+        throw socket_error("Error receiving datagram");
+    if (static_cast<size_t>(result) != N)
+        throw std::runtime_error("Received a datagram of " + std::to_string(result) + " bytes, expected "
+                                 + std::to_string(N));
+}
+
+size_t DatagramHandle::_var_read(uint8_t* buffer, size_t N) {
+    ssize_t result;
+    do {
+        result = ::recv(socket_fd_, buffer, N, 0);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0)
+        throw socket_error("Error receiving datagram");
+    return static_cast<size_t>(result);
+}
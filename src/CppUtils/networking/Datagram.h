@@ -0,0 +1,205 @@
+#pragma once
+
+#include "Resolver.h"
+
+#include "CppUtils/container/Span.h"
+#include "CppUtils/io/BasicHandle.h"
+
+#include <sys/socket.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * UDP socket options, applied before bind / connect.
+ *
+ * reuse_port lets several sockets bind the same port, with the kernel
+ * spreading incoming datagrams between them by flow, for one receiving
+ * thread per socket. timestamps records each datagram's kernel receive time
+ * (SO_TIMESTAMPNS). gro lets the kernel hand over runs of same-sized
+ * datagrams from one sender as a single buffer (UDP_GRO); the receive
+ * buffers must then be large enough, see Datagram::segment_size. Buffer sizes
+ * of 0 keep the kernel's defaults.
+ */
+struct DatagramOptions {
+    bool reuse_address = false;
+    bool reuse_port = false;
+    bool timestamps = false;
+    bool gro = false;
+    int send_buffer = 0;
+    int receive_buffer = 0;
+};
+
+/*
+ * A received datagram; data points into the batch that received it. IPv4
+ * senders have an IPv4 source, also on dual-stack sockets.
+ */
+struct Datagram {
+    Span<const uint8_t> data;
+    SocketAddress source;
+    // Kernel receive time in ns since the epoch, 0 without timestamps
+    int64_t timestamp;
+    // With GRO, data holds several datagrams of this size (the last may be
+    // shorter); 0 if data is one datagram
+    size_t segment_size;
+    // The datagram was longer than the batch's slots and was cut
+    bool truncated;
+};
+
+/*
+ * Fixed set of datagram slots with the message headers for one
+ * recvmmsg/sendmmsg call, allocated once and reused across calls.
+ */
+class DatagramBatch {
+public:
+    /*
+     * capacity datagrams of up to max_size bytes each.
+     */
+    DatagramBatch(size_t capacity, size_t max_size = 2048);
+
+    DatagramBatch(const DatagramBatch&) = delete;
+    DatagramBatch& operator=(const DatagramBatch&) = delete;
+
+    size_t capacity() const { return headers_.size(); }
+    size_t max_size() const { return max_size_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == capacity(); }
+
+    Datagram operator[](size_t i) const;
+
+    // ----- sending
+
+    void clear() { size_ = 0; }
+
+    /*
+     * Copies a datagram into the next slot, to the connected peer or to
+     * destination. Returns false if the batch is full.
+     */
+    bool add(const uint8_t* data, size_t N);
+    bool add(const uint8_t* data, size_t N, const SocketAddress& destination);
+    bool add(Span<const uint8_t> data) { return add(data.data(), data.size()); }
+    bool add(Span<const uint8_t> data, const SocketAddress& destination) {
+        return add(data.data(), data.size(), destination);
+    }
+
+private:
+    friend class DatagramHandle;
+
+    size_t max_size_;
+    size_t size_;
+    std::vector<uint8_t> data_;
+    std::vector<mmsghdr> headers_;
+    std::vector<iovec> iovecs_;
+    std::vector<SocketAddress> addresses_;
+    std::vector<uint8_t> control_;
+    std::vector<size_t> segment_sizes_;
+    std::vector<int64_t> timestamps_;
+
+    uint8_t* slot(size_t i) { return data_.data() + i * max_size_; }
+    void prepare_receive();
+    void parse_control(size_t i);
+};
+
+/*
+ * UDP socket with batched transfers: receive() and send() move a whole
+ * DatagramBatch in one recvmmsg / sendmmsg call.
+ *
+ * As a handle, each write sends one datagram to the connected peer and each
+ * var_read receives one datagram; read fails unless the datagram is exactly
+ * the requested size.
+ *
+ * Like SocketHandle, unbound and bound sockets are dual-stack IPv6 ones where
+ * IPv6 is available, falling back to IPv4, so they send to and receive from
+ * both families. Hostnames resolve through Resolver::shared().
+ */
+class DatagramHandle : public BasicHandle {
+public:
+    DatagramHandle();
+    virtual ~DatagramHandle();
+
+    virtual bool good() const override;
+    virtual void close() override;
+
+    /*
+     * Unbound socket, for sending to explicit destinations.
+     */
+    void open(const DatagramOptions& options = DatagramOptions());
+
+    /*
+     * Receives on port on all interfaces; 0 picks a free port.
+     */
+    void bind(int port, const DatagramOptions& options = DatagramOptions());
+
+    /*
+     * Sets the default destination and only receives from it, using the
+     * first of hostname's addresses the socket can connect to.
+     */
+    void connect(const std::string& hostname, int port, const DatagramOptions& options = DatagramOptions());
+
+    int local_port() const;
+
+    /*
+     * Fills the batch with the datagrams queued on the socket, waiting for
+     * the first one. Returns the number received.
+     */
+    size_t receive(DatagramBatch& batch);
+
+    /*
+     * Like receive, without waiting; returns 0 if nothing is queued.
+     */
+    size_t try_receive(DatagramBatch& batch);
+
+    /*
+     * Sends every datagram of the batch, then clears it.
+     */
+    void send(DatagramBatch& batch);
+
+    void send_to(const uint8_t* buffer, size_t N, const SocketAddress& destination);
+
+    void send_to(Span<const uint8_t> buffer, const SocketAddress& destination) {
+        send_to(buffer.data(), buffer.size(), destination);
+    }
+
+    /*
+     * Sends buffer as datagrams of segment_size bytes (the last may be
+     * shorter) with a single call, letting the kernel or NIC split it (UDP
+     * GSO). At most 64 segments and 64KB per call.
+     */
+    void send_segmented(const uint8_t* buffer, size_t N, uint16_t segment_size);
+    void send_segmented(const uint8_t* buffer, size_t N, uint16_t segment_size, const SocketAddress& destination);
+
+    void send_segmented(Span<const uint8_t> buffer, uint16_t segment_size) {
+        send_segmented(buffer.data(), buffer.size(), segment_size);
+    }
+
+    void send_segmented(Span<const uint8_t> buffer, uint16_t segment_size, const SocketAddress& destination) {
+        send_segmented(buffer.data(), buffer.size(), segment_size, destination);
+    }
+
+    /*
+     * First address of hostname, IPv4 or IPv6, e.g. for send_to.
+     */
+    static SocketAddress address(const std::string& hostname, int port);
+
+protected:
+    int socket_fd_;
+    int family_;
+
+    void _write(const uint8_t* buffer, size_t N);
+    void _read(uint8_t* buffer, size_t N);
+    size_t _var_read(uint8_t* buffer, size_t N);
+
+private:
+    /*
+     * Opens a socket of family; an AF_INET6 one is dual-stack, and falls back
+     * to AF_INET without IPv6 support.
+     */
+    void open_socket(int family, const DatagramOptions& options);
+    size_t receive(DatagramBatch& batch, int flags);
+    void send_message(const uint8_t* buffer, size_t N, uint16_t segment_size, const SocketAddress* destination);
+};
+
+using DatagramWriter = BinaryWriterTemplate<DatagramHandle>;
+using DatagramReader = BinaryReaderTemplate<DatagramHandle>;
@@ -0,0 +1,176 @@
+#include "Resolver.h"
+
+#include "CppUtils/c_util/CUtil.h"
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+// ----- SocketAddress
+
+int SocketAddress::port() const {
+    if (family() == AF_INET6)
+        return ntohs(reinterpret_cast<const sockaddr_in6*>(&storage)->sin6_port);
+    return ntohs(reinterpret_cast<const sockaddr_in*>(&storage)->sin_port);
+}
+
+void SocketAddress::set_port(int port) {
+    if (family() == AF_INET6)
+        reinterpret_cast<sockaddr_in6*>(&storage)->sin6_port = htons(port);
+    else
+        reinterpret_cast<sockaddr_in*>(&storage)->sin_port = htons(port);
+}
+
+std::string SocketAddress::host() const {
+    char buffer[INET6_ADDRSTRLEN] = {};
+    const void* address = family() == AF_INET6
+        ? static_cast<const void*>(&reinterpret_cast<const sockaddr_in6*>(&storage)->sin6_addr)
+        : static_cast<const void*>(&reinterpret_cast<const sockaddr_in*>(&storage)->sin_addr);
+    if (inet_ntop(family(), address, buffer, sizeof(buffer)) == nullptr)
+        return std::string();
+    return buffer;
+}
+
+// ----- Resolver
+
+Resolver::Resolver(std::chrono::milliseconds ttl)
+    : state_(std::make_shared<State>())
+{
+    state_->ttl = ttl;
+    state_->hits = 0;
+    state_->misses = 0;
+    state_->next_id = 0;
+}
+
+Resolver& Resolver::shared() {
+    static Resolver resolver;
+    return resolver;
+}
+
+std::vector<SocketAddress> Resolver::lookup(const std::string& hostname) {
+    addrinfo hints;
+    initialize_zero(hints);
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_ADDRCONFIG;
+
+    addrinfo* results = nullptr;
+    int error = getaddrinfo(hostname.c_str(), nullptr, &hints, &results);
+    if (error != 0)
+        throw std::runtime_error("Error finding hostname " + hostname + ": " + gai_strerror(error));
+
+    std::vector<SocketAddress> addresses;
+    for (addrinfo* result = results; result != nullptr; result = result->ai_next) {
+        if (result->ai_family != AF_INET && result->ai_family != AF_INET6)
+            continue;
+        SocketAddress address;
+        initialize_zero(address.storage);
+        std::memcpy(&address.storage, result->ai_addr, result->ai_addrlen);
+        address.length = result->ai_addrlen;
+        addresses.push_back(address);
+    }
+    freeaddrinfo(results);
+
+    if (addresses.empty())
+        throw std::runtime_error("Error finding hostname " + hostname + ": no IPv4 or IPv6 address");
+    return addresses;
+}
+
+std::vector<SocketAddress> Resolver::resolve(const std::string& hostname, int port) {
+    return resolve(hostname, port, Clock::time_point::max());
+}
+
+std::vector<SocketAddress> Resolver::resolve(const std::string& hostname, int port, Clock::time_point deadline) {
+    std::shared_future<Addresses> addresses;
+    std::promise<Addresses> promise;
+    bool owner = false;
+    uint64_t id = 0;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        auto entry = state_->entries.find(hostname);
+        if (entry != state_->entries.end() && Clock::now() < entry->second.expiry) {
+            state_->hits++;
+            addresses = entry->second.addresses;
+        } else {
+            state_->misses++;
+            owner = true;
+            id = state_->next_id++;
+            addresses = promise.get_future().share();
+            // The expiry is set once the lookup is done; until then others wait on it
+            state_->entries[hostname] = Entry{addresses, Clock::time_point::max(), id};
+        }
+    }
+
+    if (owner) {
+        if (deadline == Clock::time_point::max()) {
+            complete(*state_, hostname, id, promise);
+        } else {
+            // Shared with the thread, so it's still ours if the thread can't start
+            std::shared_ptr<std::promise<Addresses> > shared_promise;
+            try {
+                shared_promise = std::make_shared<std::promise<Addresses> >(std::move(promise));
+                std::thread([state = state_, hostname, id, shared_promise] () {
+                    complete(*state, hostname, id, *shared_promise);
+                }).detach();
+            } catch (...) {
+                // Look up here instead, which still fulfils the entry's promise
+                complete(*state_, hostname, id, shared_promise ? *shared_promise : promise);
+            }
+        }
+    }
+
+    if (deadline != Clock::time_point::max() && addresses.wait_until(deadline) != std::future_status::ready)
+        throw std::runtime_error("Timed out finding hostname " + hostname);
+
+    Addresses result = addresses.get();
+    for (SocketAddress& address : result) {
+        address.set_port(port);
+    }
+    return result;
+}
+
+void Resolver::complete(State& state, const std::string& hostname, uint64_t id, std::promise<Addresses>& promise) {
+    Addresses addresses;
+    std::exception_ptr error;
+    try {
+        addresses = lookup(hostname);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    if (error)
+        promise.set_exception(error);
+    else
+        promise.set_value(std::move(addresses));
+
+    // Failures aren't cached, successes expire after the TTL
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto entry = state.entries.find(hostname);
+    if (entry != state.entries.end() && entry->second.id == id) {
+        if (error)
+            state.entries.erase(entry);
+        else
+            entry->second.expiry = Clock::now() + state.ttl;
+    }
+}
+
+void Resolver::clear() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->entries.clear();
+}
+
+uint64_t Resolver::hits() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->hits;
+}
+
+uint64_t Resolver::misses() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->misses;
+}
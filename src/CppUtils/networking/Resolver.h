@@ -0,0 +1,103 @@
+#pragma once
+
+#include <sys/socket.h>
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * IPv4 or IPv6 socket address.
+ */
+struct SocketAddress {
+    sockaddr_storage storage;
+    socklen_t length;
+
+    int family() const { return storage.ss_family; }
+    const sockaddr* data() const { return reinterpret_cast<const sockaddr*>(&storage); }
+
+    int port() const;
+    void set_port(int port);
+
+    /*
+     * Numeric host, e.g. "127.0.0.1" or "::1".
+     */
+    std::string host() const;
+};
+
+/*
+ * Thread-safe getaddrinfo front end with a cache.
+ *
+ * Results are kept for ttl (getaddrinfo doesn't report record TTLs).
+ * Concurrent lookups of one host share a single getaddrinfo call, while
+ * lookups of different hosts run in parallel; failures aren't cached.
+ * Addresses of both families are returned, in getaddrinfo's order of
+ * preference (RFC 6724).
+ */
+class Resolver {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit Resolver(std::chrono::milliseconds ttl = std::chrono::seconds(30));
+
+    Resolver(const Resolver&) = delete;
+    Resolver& operator=(const Resolver&) = delete;
+
+    /*
+     * Throws if the host doesn't resolve.
+     */
+    std::vector<SocketAddress> resolve(const std::string& hostname, int port);
+
+    /*
+     * Like resolve, throwing if the deadline passes first. getaddrinfo can't
+     * be interrupted, so a lookup started here runs on its own thread and
+     * still fills the cache when it completes late.
+     */
+    std::vector<SocketAddress> resolve(const std::string& hostname, int port, Clock::time_point deadline);
+
+    void clear();
+
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+    /*
+     * Process-wide resolver used by SocketHandle::connect.
+     */
+    static Resolver& shared();
+
+private:
+    using Addresses = std::vector<SocketAddress>;
+
+    struct Entry {
+        std::shared_future<Addresses> addresses;
+        Clock::time_point expiry;
+        // Tells apart the entry a lookup was started for from later ones
+        uint64_t id;
+    };
+
+    /*
+     * Shared with background lookups, which may outlive the resolver.
+     */
+    struct State {
+        std::chrono::milliseconds ttl;
+        std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t next_id;
+    };
+
+    static Addresses lookup(const std::string& hostname);
+
+    /*
+     * Runs the lookup for the entry with the given id and publishes it.
+     */
+    static void complete(State& state, const std::string& hostname, uint64_t id, std::promise<Addresses>& promise);
+
+    std::shared_ptr<State> state_;
+};
@@ -7,11 +7,72 @@
 #include <cstring>
 #include <sys/types.h>
 #include <netdb.h>
+#include <netinet/tcp.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <algorithm>
+#include <cerrno>
 #include <stdexcept>
 
+namespace {
+
+void set_option(int fd, int level, int name, int value, const char* label) {
+    if (setsockopt(fd, level, name, &value, sizeof(value)) < 0)
+        throw std::runtime_error(std::string("Error setting socket option ") + label + ": " + std::strerror(errno));
+}
+
+template <typename T>
+void set_option(int fd, int level, int name, const std::optional<T>& value, const char* label) {
+    if (value)
+        set_option(fd, level, name, static_cast<int>(*value), label);
+}
+
+void apply_options(int fd, const SocketOptions& options) {
+    set_option(fd, SOL_SOCKET, SO_REUSEADDR, options.reuse_address, "SO_REUSEADDR");
+    set_option(fd, SOL_SOCKET, SO_SNDBUF, options.send_buffer, "SO_SNDBUF");
+    set_option(fd, SOL_SOCKET, SO_RCVBUF, options.receive_buffer, "SO_RCVBUF");
+    set_option(fd, SOL_SOCKET, SO_BUSY_POLL, options.busy_poll, "SO_BUSY_POLL");
+    set_option(fd, SOL_SOCKET, SO_KEEPALIVE, options.keep_alive, "SO_KEEPALIVE");
+    set_option(fd, IPPROTO_TCP, TCP_KEEPIDLE, options.keep_alive_idle, "TCP_KEEPIDLE");
+    set_option(fd, IPPROTO_TCP, TCP_KEEPINTVL, options.keep_alive_interval, "TCP_KEEPINTVL");
+    set_option(fd, IPPROTO_TCP, TCP_KEEPCNT, options.keep_alive_count, "TCP_KEEPCNT");
+    set_option(fd, IPPROTO_TCP, TCP_NODELAY, options.no_delay, "TCP_NODELAY");
+    set_option(fd, IPPROTO_TCP, TCP_CORK, options.cork, "TCP_CORK");
+    set_option(fd, IPPROTO_TCP, TCP_QUICKACK, options.quick_ack, "TCP_QUICKACK");
+}
+
+/*
+ * Alternates address families, keeping the resolver's preference within each
+ * and starting with the family of the first address.
+ */
+std::vector<SocketAddress> interleave_families(const std::vector<SocketAddress>& addresses) {
+    std::vector<SocketAddress> preferred;
+    std::vector<SocketAddress> other;
+    for (const SocketAddress& address : addresses) {
+        (address.family() == addresses.front().family() ? preferred : other).push_back(address);
+    }
+
+    std::vector<SocketAddress> result;
+    for (size_t i = 0; i < std::max(preferred.size(), other.size()); i++) {
+        if (i < preferred.size()) result.push_back(preferred[i]);
+        if (i < other.size()) result.push_back(other[i]);
+    }
+    return result;
+}
+
+int get_option(int fd, int level, int name, const char* label) {
+    int value = 0;
+    socklen_t length = sizeof(value);
+    if (getsockopt(fd, level, name, &value, &length) < 0)
+        throw std::runtime_error(std::string("Error getting socket option ") + label + ": " + std::strerror(errno));
+    return value;
+}
+
+}
+
 
 SocketHandle::SocketHandle()
-    : socket_fd_(-1)
+    : socket_fd_(-1), quick_ack_(false)
 {
     initialize_zero(address_);
 }
@@ -29,45 +90,191 @@ void SocketHandle::close() {
         ::close(socket_fd_);
         socket_fd_ = -1;
     }
+    quick_ack_ = false;
 }
 
-void SocketHandle::listen(int port) {
-    socket_fd_ = socket(AF_INET, SOCK_STREAM, 0);
-    if (!good())
-        throw std::runtime_error("Error opening server socket");
+void SocketHandle::listen(int port, const SocketOptions& options) {
+    close();
+    initialize_zero(address_);
 
-    address_.sin_family = AF_INET;
-    address_.sin_port = htons(port);
-    address_.sin_addr.s_addr = INADDR_ANY;
+    socket_fd_ = socket(AF_INET6, SOCK_STREAM, 0);
+    if (good()) {
+        set_option(socket_fd_, IPPROTO_IPV6, IPV6_V6ONLY, 0, "IPV6_V6ONLY");
+        sockaddr_in6& address = reinterpret_cast<sockaddr_in6&>(address_.storage);
+        address.sin6_family = AF_INET6;
+        address.sin6_addr = in6addr_any;
+        address_.length = sizeof(sockaddr_in6);
+    } else {
+        // No IPv6 support
+        socket_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        if (!good())
+            throw std::runtime_error("Error opening server socket");
+        sockaddr_in& address = reinterpret_cast<sockaddr_in&>(address_.storage);
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = INADDR_ANY;
+        address_.length = sizeof(sockaddr_in);
+    }
+    address_.set_port(port);
+    set_options(options);
 
-    if (bind(socket_fd_, (struct sockaddr*) &address_, sizeof(address_)) < 0)
+    if (bind(socket_fd_, address_.data(), address_.length) < 0)
         throw std::runtime_error("Error on binding");
 
     ::listen(socket_fd_, 5);
 }
 
-void SocketHandle::connect(const std::string& hostname, int port) {
-    socket_fd_ = socket(AF_INET, SOCK_STREAM, 0);
-    if (!good())
-        throw std::runtime_error("Error opening client socket");
+void SocketHandle::connect(const std::string& hostname, int port, const SocketOptions& options) {
+    connect(hostname, port, std::chrono::milliseconds(-1), options);
+}
+
+void SocketHandle::connect(const std::string& hostname, int port, std::chrono::milliseconds timeout,
+                           const SocketOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    constexpr std::chrono::milliseconds attempt_delay(250);
+
+    close();
+    const Clock::time_point deadline = timeout.count() < 0 ? Clock::time_point::max() : Clock::now() + timeout;
+    const std::vector<SocketAddress> addresses = interleave_families(Resolver::shared().resolve(hostname, port, deadline));
+
+    // In flight attempts, and the address each one is for
+    std::vector<pollfd> pending;
+    std::vector<size_t> targets;
+    auto abandon = [&pending] {
+        for (const pollfd& attempt : pending) {
+            ::close(attempt.fd);
+        }
+    };
+
+    size_t next = 0;
+    Clock::time_point next_attempt = Clock::now();
+    int last_error = 0;
+    int winner = -1;
+    size_t winner_target = 0;
+
+    try {
+        while (winner < 0) {
+            Clock::time_point now = Clock::now();
+            if (next < addresses.size() && (pending.empty() || now >= next_attempt)) {
+                const SocketAddress& address = addresses[next];
+                int fd = socket(address.family(), SOCK_STREAM | SOCK_NONBLOCK, 0);
+                if (fd < 0) {
+                    last_error = errno;
+                    next++;
+                    continue;
+                }
+                try {
+                    apply_options(fd, options);
+                } catch (...) {
+                    ::close(fd);
+                    throw;
+                }
+
+                if (::connect(fd, address.data(), address.length) == 0) {
+                    winner = fd;
+                    winner_target = next;
+                } else if (errno == EINPROGRESS) {
+                    pending.push_back(pollfd{fd, POLLOUT, 0});
+                    targets.push_back(next);
+                    next_attempt = now + attempt_delay;
+                } else {
+                    last_error = errno;
+                    ::close(fd);
+                }
+                next++;
+                continue;
+            }
 
-    struct hostent* hostentry = gethostbyname(hostname.c_str());
-    if (!hostentry)
-        throw std::runtime_error("Error finding hostname " + hostname);
+            if (pending.empty())
+                throw std::runtime_error("Error on connecting to " + hostname + ": " + std::strerror(last_error));
+            if (now >= deadline)
+                throw std::runtime_error("Timed out connecting to " + hostname);
 
-    address_.sin_family = AF_INET;
-    address_.sin_port = htons(port);
-    copy_raw_buffer(&address_.sin_addr.s_addr, hostentry->h_addr, hostentry->h_length);
+            Clock::time_point wake = deadline;
+            if (next < addresses.size())
+                wake = std::min(wake, next_attempt);
+            const auto wait = std::chrono::ceil<std::chrono::milliseconds>(wake - now);
+            const int wait_ms = wake == Clock::time_point::max() ? -1 : static_cast<int>(std::max<int64_t>(wait.count(), 0));
+            if (::poll(pending.data(), pending.size(), wait_ms) < 0 && errno != EINTR)
+                throw std::runtime_error("Error waiting for connections: " + std::string(std::strerror(errno)));
 
-    if (::connect(socket_fd_, (struct sockaddr*) &address_, sizeof(address_)) < 0)
-        throw std::runtime_error("Error on connecting");
+            for (size_t i = 0; i < pending.size() && winner < 0;) {
+                if (pending[i].revents == 0) {
+                    i++;
+                    continue;
+                }
+                int error = 0;
+                socklen_t length = sizeof(error);
+                getsockopt(pending[i].fd, SOL_SOCKET, SO_ERROR, &error, &length);
+                if (error == 0) {
+                    winner = pending[i].fd;
+                    winner_target = targets[i];
+                } else {
+                    // Failed, so don't hold back the next attempt
+                    last_error = error;
+                    next_attempt = now;
+                    ::close(pending[i].fd);
+                }
+                pending.erase(pending.begin() + i);
+                targets.erase(targets.begin() + i);
+            }
+        }
+    } catch (...) {
+        abandon();
+        throw;
+    }
+    abandon();
+
+    fcntl(winner, F_SETFL, fcntl(winner, F_GETFL) & ~O_NONBLOCK);
+    socket_fd_ = winner;
+    address_ = addresses[winner_target];
+    if (options.quick_ack)
+        quick_ack_ = *options.quick_ack;
 }
 
-void SocketHandle::accept(const SocketHandle& server) {
+void SocketHandle::accept(const SocketHandle& server, const SocketOptions& options) {
     // Not currently using client address...
     socket_fd_ = ::accept(server.socket_fd_, nullptr, nullptr);
     if (!good())
         throw std::runtime_error("Error opening client socket");
+    quick_ack_ = server.quick_ack_;
+    set_options(options);
+}
+
+void SocketHandle::adopt(int fd) {
+    if (fd != socket_fd_)
+        close();
+    socket_fd_ = fd;
+}
+
+void SocketHandle::set_options(const SocketOptions& options) {
+    apply_options(socket_fd_, options);
+    if (options.quick_ack)
+        quick_ack_ = *options.quick_ack;
+}
+
+SocketOptions SocketHandle::options() const {
+    SocketOptions options;
+    options.reuse_address = get_option(socket_fd_, SOL_SOCKET, SO_REUSEADDR, "SO_REUSEADDR") != 0;
+    options.send_buffer = get_option(socket_fd_, SOL_SOCKET, SO_SNDBUF, "SO_SNDBUF");
+    options.receive_buffer = get_option(socket_fd_, SOL_SOCKET, SO_RCVBUF, "SO_RCVBUF");
+    options.busy_poll = get_option(socket_fd_, SOL_SOCKET, SO_BUSY_POLL, "SO_BUSY_POLL");
+    options.keep_alive = get_option(socket_fd_, SOL_SOCKET, SO_KEEPALIVE, "SO_KEEPALIVE") != 0;
+    options.keep_alive_idle = get_option(socket_fd_, IPPROTO_TCP, TCP_KEEPIDLE, "TCP_KEEPIDLE");
+    options.keep_alive_interval = get_option(socket_fd_, IPPROTO_TCP, TCP_KEEPINTVL, "TCP_KEEPINTVL");
+    options.keep_alive_count = get_option(socket_fd_, IPPROTO_TCP, TCP_KEEPCNT, "TCP_KEEPCNT");
+    options.no_delay = get_option(socket_fd_, IPPROTO_TCP, TCP_NODELAY, "TCP_NODELAY") != 0;
+    options.cork = get_option(socket_fd_, IPPROTO_TCP, TCP_CORK, "TCP_CORK") != 0;
+    // Reads back the kernel's current state, which it may have cleared
+    options.quick_ack = get_option(socket_fd_, IPPROTO_TCP, TCP_QUICKACK, "TCP_QUICKACK") != 0;
+    return options;
+}
+
+int SocketHandle::local_port() const {
+    SocketAddress address;
+    address.length = sizeof(address.storage);
+    if (getsockname(socket_fd_, reinterpret_cast<sockaddr*>(&address.storage), &address.length) < 0)
+        throw std::runtime_error("Error getting socket address");
+    return address.port();
 }
 
 void SocketHandle::_write(const uint8_t* buffer, size_t N) {
@@ -92,6 +299,7 @@ size_t SocketHandle::_var_read(uint8_t* buffer, size_t N) {
     int result = ::recv(socket_fd_, buffer, N, 0);
     if (result < 0)
         throw std::runtime_error("Error while reading data from socket");
-    else
-        return static_cast<size_t>(result);
+    if (quick_ack_)
+        set_option(socket_fd_, IPPROTO_TCP, TCP_QUICKACK, 1, "TCP_QUICKACK");
+    return static_cast<size_t>(result);
 }
@@ -1,10 +1,41 @@
 #pragma once
 
+#include "Resolver.h"
+
 #include "CppUtils/io/BasicHandle.h"
 
 #include <sys/socket.h>
 #include <netinet/in.h>
 
+#include <optional>
+
+/*
+ * Socket options; unset ones keep the kernel's value.
+ *
+ * no_delay disables Nagle's algorithm, so small writes go out immediately.
+ * cork holds partial frames until uncorked or full, for sending a header and
+ * body as one segment. send_buffer and receive_buffer are in bytes; the
+ * kernel doubles the requested value for its bookkeeping and caps it by
+ * net.core.wmem_max / rmem_max. busy_poll is the time in microseconds a
+ * blocking receive busy-polls the device queue before sleeping; raising it
+ * above net.core.busy_read needs CAP_NET_ADMIN. quick_ack disables delayed
+ * ACKs. keep_alive_idle, keep_alive_interval (seconds) and keep_alive_count
+ * tune keep_alive's probes.
+ */
+struct SocketOptions {
+    std::optional<bool> no_delay;
+    std::optional<bool> cork;
+    std::optional<int> send_buffer;
+    std::optional<int> receive_buffer;
+    std::optional<int> busy_poll;
+    std::optional<bool> quick_ack;
+    std::optional<bool> keep_alive;
+    std::optional<int> keep_alive_idle;
+    std::optional<int> keep_alive_interval;
+    std::optional<int> keep_alive_count;
+    std::optional<bool> reuse_address;
+};
+
 class SocketHandle : public BasicHandle {
 public:
     SocketHandle();
@@ -13,9 +44,54 @@ public:
     virtual bool good() const override;
     virtual void close() override;
 
-    void listen(int port);
-    void connect(const std::string& hostname, int port);
-    void accept(const SocketHandle& server);
+    /*
+     * Options are applied before bind / connect, so buffer sizes take part in
+     * the window negotiation; sockets accepted from a listener inherit its
+     * options, then get accept's.
+     */
+
+    /*
+     * Listens on all interfaces, over IPv6 and IPv4 where IPv6 is available.
+     */
+    void listen(int port, const SocketOptions& options = SocketOptions());
+
+    /*
+     * Connects to hostname, resolved through Resolver::shared(), trying its
+     * addresses "happy eyeballs" style (RFC 8305): families alternate, and a
+     * new attempt starts whenever the previous one fails or has not finished
+     * within 250ms, while earlier ones continue. The first to connect wins.
+     *
+     * With a non-negative timeout, gives up once it has passed.
+     */
+    void connect(const std::string& hostname, int port, const SocketOptions& options = SocketOptions());
+    void connect(const std::string& hostname, int port, std::chrono::milliseconds timeout,
+                 const SocketOptions& options = SocketOptions());
+
+    void accept(const SocketHandle& server, const SocketOptions& options = SocketOptions());
+
+    /*
+     * Applies the options which are set. Throws naming the first option the
+     * kernel rejected.
+     */
+    void set_options(const SocketOptions& options);
+
+    /*
+     * Effective values of every option, as reported by the kernel.
+     */
+    SocketOptions options() const;
+
+    /*
+     * Port the socket is bound to, e.g. after listen(0).
+     */
+    int local_port() const;
+
+    int fd() const { return socket_fd_; }
+
+    /*
+     * Takes ownership of a connected socket, e.g. one accepted elsewhere;
+     * closes the current one.
+     */
+    void adopt(int fd);
 
 protected:
     virtual void _write(const uint8_t* buffer, size_t N);
@@ -23,7 +99,11 @@ protected:
     virtual size_t _var_read(uint8_t* buffer, size_t N);
 
     int socket_fd_;
-    struct sockaddr_in address_;
+    SocketAddress address_;
+
+    // The kernel clears TCP_QUICKACK as it goes, so it is set again after
+    // every receive while this is on
+    bool quick_ack_;
 };
 
 using SocketWriter = BinaryWriterTemplate<SocketHandle>;
@@ -0,0 +1,296 @@
+#include "UnixSocket.h"
+
+#include "CppUtils/c_util/CUtil.h"
+#include "CppUtils/io/IOUtils.h"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+std::runtime_error socket_error(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+int socket_type(UnixSocketType type) {
+    return type == UnixSocketType::SeqPacket ? SOCK_SEQPACKET : SOCK_STREAM;
+}
+
+bool is_abstract(const std::string& path) {
+    return !path.empty() && path[0] == '@';
+}
+
+socklen_t make_address(const std::string& path, sockaddr_un& address) {
+    initialize_zero(address);
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("Invalid unix socket path \"" + path + "\"");
+
+    std::memcpy(address.sun_path, path.data(), path.size());
+    if (is_abstract(path)) {
+        address.sun_path[0] = '\0';
+        return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + path.size());
+    }
+    return static_cast<socklen_t>(sizeof(address));
+}
+
+/*
+ * Removes the socket file at path if nothing listens on it any more. Throws
+ * if path is something other than a socket, or a live server's socket.
+ */
+void remove_stale_socket(const std::string& path, const sockaddr_un& address, socklen_t length, int type) {
+    struct stat status;
+    if (::lstat(path.c_str(), &status) < 0) {
+        if (errno == ENOENT)
+            return;
+        throw socket_error("Error checking unix socket path " + path);
+    }
+    if (!S_ISSOCK(status.st_mode))
+        throw std::runtime_error("Won't replace " + path + ": not a socket");
+
+    const int probe = socket(AF_UNIX, type | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (probe < 0)
+        throw socket_error("Error opening unix socket");
+    const int result = ::connect(probe, (const struct sockaddr*) &address, length);
+    const int error = errno;
+    ::close(probe);
+
+    if (result == 0 || error != ECONNREFUSED) {
+        errno = result == 0 ? EADDRINUSE : error;
+        throw socket_error("Won't replace unix socket " + path);
+    }
+    if (::unlink(path.c_str()) < 0 && errno != ENOENT)
+        throw socket_error("Error removing stale unix socket " + path);
+}
+
+}
+
+UnixSocketHandle::UnixSocketHandle()
+    : BasicHandle(), socket_fd_(-1), type_(UnixSocketType::Stream)
+{}
+
+UnixSocketHandle::~UnixSocketHandle() {
+    close();
+}
+
+bool UnixSocketHandle::good() const {
+    return socket_fd_ >= 0;
+}
+
+void UnixSocketHandle::close() {
+    if (good()) {
+        ::close(socket_fd_);
+        socket_fd_ = -1;
+    }
+    if (!bound_path_.empty()) {
+        ::unlink(bound_path_.c_str());
+        bound_path_.clear();
+    }
+}
+
+void UnixSocketHandle::open_socket(UnixSocketType type) {
+    close();
+    socket_fd_ = socket(AF_UNIX, socket_type(type) | SOCK_CLOEXEC, 0);
+    if (!good())
+        throw socket_error("Error opening unix socket");
+    type_ = type;
+}
+
+void UnixSocketHandle::listen(const std::string& path, UnixSocketType type) {
+    sockaddr_un address;
+    const socklen_t length = make_address(path, address);
+    open_socket(type);
+
+    if (!is_abstract(path))
+        remove_stale_socket(path, address, length, socket_type(type));
+    if (bind(socket_fd_, (struct sockaddr*) &address, length) < 0)
+        throw socket_error("Error binding unix socket " + path);
+    if (!is_abstract(path))
+        bound_path_ = path;
+
+    if (::listen(socket_fd_, SOMAXCONN) < 0)
+        throw socket_error("Error listening on unix socket " + path);
+}
+
+void UnixSocketHandle::connect(const std::string& path, UnixSocketType type) {
+    sockaddr_un address;
+    const socklen_t length = make_address(path, address);
+    open_socket(type);
+
+    if (::connect(socket_fd_, (struct sockaddr*) &address, length) < 0)
+        throw socket_error("Error connecting to unix socket " + path);
+}
+
+void UnixSocketHandle::accept(const UnixSocketHandle& server) {
+    close();
+    socket_fd_ = ::accept4(server.socket_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (!good())
+        throw socket_error("Error accepting unix socket connection");
+    type_ = server.type_;
+}
+
+void UnixSocketHandle::pair(UnixSocketHandle& other, UnixSocketType type) {
+    close();
+    other.close();
+
+    int fds[2];
+    if (socketpair(AF_UNIX, socket_type(type) | SOCK_CLOEXEC, 0, fds) < 0)
+        throw socket_error("Error creating unix socket pair");
+    socket_fd_ = fds[0];
+    other.socket_fd_ = fds[1];
+    type_ = type;
+    other.type_ = type;
+}
+
+void UnixSocketHandle::send_fds(const int* fds, size_t N_fds, const uint8_t* buffer, size_t N) {
+    if (N_fds > max_fds)
+        throw std::runtime_error("Can't pass more than " + std::to_string(max_fds) + " descriptors at once");
+    if (N == 0)
+        throw std::runtime_error("Descriptors must be sent with at least one byte of data");
+
+    iovec data{const_cast<uint8_t*>(buffer), N};
+    msghdr header;
+    initialize_zero(header);
+    header.msg_iov = &data;
+    header.msg_iovlen = 1;
+
+    std::vector<uint8_t> control(CMSG_SPACE(N_fds * sizeof(int)));
+    if (N_fds > 0) {
+        header.msg_control = control.data();
+        header.msg_controllen = control.size();
+        cmsghdr* message = CMSG_FIRSTHDR(&header);
+        message->cmsg_level = SOL_SOCKET;
+        message->cmsg_type = SCM_RIGHTS;
+        message->cmsg_len = CMSG_LEN(N_fds * sizeof(int));
+        std::memcpy(CMSG_DATA(message), fds, N_fds * sizeof(int));
+    }
+
+    ssize_t result;
+    do {
+        result = sendmsg(socket_fd_, &header, MSG_NOSIGNAL);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0)
+        throw socket_error("Error sending descriptors");
+
+    // The descriptors went with the first byte; the rest is plain data
+    const size_t sent = static_cast<size_t>(result);
+    if (sent < N)
+        _write(buffer + sent, N - sent);
+}
+
+size_t UnixSocketHandle::receive_fds(int* fds, size_t capacity, size_t& N_fds, uint8_t* buffer, size_t N) {
+    iovec data{buffer, N};
+    msghdr header;
+    initialize_zero(header);
+    header.msg_iov = &data;
+    header.msg_iovlen = 1;
+
+    std::vector<uint8_t> control(CMSG_SPACE(max_fds * sizeof(int)));
+    header.msg_control = control.data();
+    header.msg_controllen = control.size();
+
+    ssize_t result;
+    do {
+        result = recvmsg(socket_fd_, &header, MSG_CMSG_CLOEXEC);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0)
+        throw socket_error("Error receiving descriptors");
+
+    N_fds = 0;
+    size_t dropped = 0;
+    for (cmsghdr* message = CMSG_FIRSTHDR(&header); message != nullptr; message = CMSG_NXTHDR(&header, message)) {
+        if (message->cmsg_level != SOL_SOCKET || message->cmsg_type != SCM_RIGHTS)
+            continue;
+        const size_t count = (message->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        const uint8_t* received = CMSG_DATA(message);
+        for (size_t i = 0; i < count; i++) {
+            int fd;
+            std::memcpy(&fd, received + i * sizeof(int), sizeof(int));
+            if (N_fds < capacity) {
+                fds[N_fds++] = fd;
+            } else {
+                ::close(fd);
+                dropped++;
+            }
+        }
+    }
+
+    if (dropped > 0 || (header.msg_flags & MSG_CTRUNC)) {
+        for (size_t i = 0; i < N_fds; i++) {
+            ::close(fds[i]);
+        }
+        N_fds = 0;
+        throw std::runtime_error("Received more descriptors than there was room for");
+    }
+    return static_cast<size_t>(result);
+}
+
+void UnixSocketHandle::send_fd(int fd) {
+    const uint8_t marker = 0;
+    send_fds(&fd, 1, &marker, 1);
+}
+
+int UnixSocketHandle::receive_fd() {
+    int fd = -1;
+    size_t N_fds = 0;
+    uint8_t marker;
+    if (receive_fds(&fd, 1, N_fds, &marker, 1) == 0)
+        throw std::runtime_error("End of stream while waiting for a descriptor");
+    if (N_fds != 1)
+        throw std::runtime_error("Expected a descriptor but got plain data");
+    return fd;
+}
+
+void UnixSocketHandle::_write(const uint8_t* buffer, size_t N) {
+    detail::staggered_io(
+            [this] (const uint8_t* xs, size_t n) {
+                ssize_t result;
+                do {
+                    result = ::send(socket_fd_, xs, n, MSG_NOSIGNAL);
+                } while (result < 0 && errno == EINTR);
+                return result;
+            },
+            buffer, N);
+}
+
+void UnixSocketHandle::_read(uint8_t* buffer, size_t N) {
+    if (type_ == UnixSocketType::Stream) {
+        detail::staggered_io(
+                [this] (uint8_t* xs, size_t n) {
+                    return this->_var_read(xs, n);
+                },
+                buffer, N);
+        return;
+    }
+
+    // A message can't be read in parts, the rest of it would be dropped
+    ssize_t result;
+    do {
+        result = ::recv(socket_fd_, buffer, N, MSG_TRUNC);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0)
+        throw socket_error("Error reading unix socket");
+    if (result == 0 && N > 0)
+        throw std::runtime_error("End of stream while transferring data (incomplete)");
+    if (static_cast<size_t>(result) != N)
+        throw std::runtime_error("Received a message of " + std::to_string(result) + " bytes, expected "
+                                 + std::to_string(N));
+}
+
+size_t UnixSocketHandle::_var_read(uint8_t* buffer, size_t N) {
+    ssize_t result;
+    do {
+        result = ::recv(socket_fd_, buffer, N, 0);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0)
+        throw socket_error("Error reading unix socket");
+    return static_cast<size_t>(result);
+}
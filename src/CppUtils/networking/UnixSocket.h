@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CppUtils/container/Span.h"
+#include "CppUtils/io/BasicHandle.h"
+
+#include <string>
+
+enum class UnixSocketType {
+    // Byte stream, like TCP
+    Stream,
+    // Reliable, ordered messages with boundaries kept: each write is one
+    // message and each var_read returns at most one
+    SeqPacket,
+};
+
+/*
+ * AF_UNIX socket, for processes on the same machine.
+ *
+ * Paths starting with '@' are in the abstract namespace: nothing is created
+ * in the filesystem and the name goes away with the last socket. Otherwise
+ * listen replaces a stale socket file at path, one nothing listens on any
+ * more. It throws rather than remove anything else there, including a live
+ * server's socket.
+ *
+ * send_fds passes open descriptors (SCM_RIGHTS), e.g. of a DeviceHandle,
+ * FileHandle or SharedMemoryChannel, so the receiver uses the same open file
+ * without any data being copied.
+ */
+class UnixSocketHandle : public BasicHandle {
+public:
+    // Descriptors per send_fds call (SCM_MAX_FD)
+    constexpr static size_t max_fds = 253;
+
+    UnixSocketHandle();
+    virtual ~UnixSocketHandle();
+
+    virtual bool good() const override;
+    virtual void close() override;
+
+    void listen(const std::string& path, UnixSocketType type = UnixSocketType::Stream);
+    void connect(const std::string& path, UnixSocketType type = UnixSocketType::Stream);
+    void accept(const UnixSocketHandle& server);
+
+    /*
+     * Connects this handle and other to each other (socketpair), e.g. before
+     * forking a worker.
+     */
+    void pair(UnixSocketHandle& other, UnixSocketType type = UnixSocketType::Stream);
+
+    int fd() const { return socket_fd_; }
+    UnixSocketType type() const { return type_; }
+
+    /*
+     * Sends N bytes of data together with the descriptors, which stay open
+     * here. At least one byte must be sent for the descriptors to go along.
+     */
+    void send_fds(const int* fds, size_t N_fds, const uint8_t* buffer, size_t N);
+
+    void send_fds(Span<const int> fds, Span<const uint8_t> buffer) {
+        send_fds(fds.data(), fds.size(), buffer.data(), buffer.size());
+    }
+
+    /*
+     * Receives data and any descriptors sent with it, which the caller then
+     * owns (opened close-on-exec). Returns the number of bytes read, 0 at the
+     * end of the stream; N_fds is set to the number of descriptors.
+     * Descriptors beyond capacity are closed and make this throw.
+     */
+    size_t receive_fds(int* fds, size_t capacity, size_t& N_fds, uint8_t* buffer, size_t N);
+
+    size_t receive_fds(Span<int> fds, size_t& N_fds, Span<uint8_t> buffer) {
+        return receive_fds(fds.data(), fds.size(), N_fds, buffer.data(), buffer.size());
+    }
+
+    /*
+     * Single descriptor with a one byte message.
+     */
+    void send_fd(int fd);
+    int receive_fd();
+
+protected:
+    int socket_fd_;
+    UnixSocketType type_;
+    // Filesystem socket created by listen, removed on close
+    std::string bound_path_;
+
+    void _write(const uint8_t* buffer, size_t N);
+    void _read(uint8_t* buffer, size_t N);
+    size_t _var_read(uint8_t* buffer, size_t N);
+
+private:
+    void open_socket(UnixSocketType type);
+};
+
+using UnixSocketWriter = BinaryWriterTemplate<UnixSocketHandle>;
+using UnixSocketReader = BinaryReaderTemplate<UnixSocketHandle>;
+using UnixSocket = BinaryReaderWriterTemplate<UnixSocketHandle>;
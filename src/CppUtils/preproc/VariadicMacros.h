@@ -1,5 +1,11 @@
 #pragma once
 
+// Generated by cmake/GenerateVariadicMacros.cmake, do not edit by hand.
+//
+// Maps accept between 1 and CPPUTILS_MAX_ARGS arguments.
+
+#define CPPUTILS_MAX_ARGS 1024
+
 #define SEP_COMMA ,
 #define SEP_SEMICOLON ;
 
@@ -9,154 +15,1468 @@
 #define CPPUTILS_NARGS(...) CPPUTILS_NARGS_(__VA_ARGS__, CPPUTILS_RSEQ_N())
 #define CPPUTILS_NARGS_(...) CPPUTILS_ARGN(__VA_ARGS__)
 #define CPPUTILS_ARGN( \
-         _1,  _2,  _3,  _4,  _5,  _6,  _7,  _8,  _9, _10, \
+        _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
         _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, \
         _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, \
         _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, \
         _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, \
         _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, \
-        _61, _62, _63, N, ...) N
+        _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, \
+        _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, \
+        _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, \
+        _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, \
+        _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, \
+        _111, _112, _113, _114, _115, _116, _117, _118, _119, _120, \
+        _121, _122, _123, _124, _125, _126, _127, _128, _129, _130, \
+        _131, _132, _133, _134, _135, _136, _137, _138, _139, _140, \
+        _141, _142, _143, _144, _145, _146, _147, _148, _149, _150, \
+        _151, _152, _153, _154, _155, _156, _157, _158, _159, _160, \
+        _161, _162, _163, _164, _165, _166, _167, _168, _169, _170, \
+        _171, _172, _173, _174, _175, _176, _177, _178, _179, _180, \
+        _181, _182, _183, _184, _185, _186, _187, _188, _189, _190, \
+        _191, _192, _193, _194, _195, _196, _197, _198, _199, _200, \
+        _201, _202, _203, _204, _205, _206, _207, _208, _209, _210, \
+        _211, _212, _213, _214, _215, _216, _217, _218, _219, _220, \
+        _221, _222, _223, _224, _225, _226, _227, _228, _229, _230, \
+        _231, _232, _233, _234, _235, _236, _237, _238, _239, _240, \
+        _241, _242, _243, _244, _245, _246, _247, _248, _249, _250, \
+        _251, _252, _253, _254, _255, _256, _257, _258, _259, _260, \
+        _261, _262, _263, _264, _265, _266, _267, _268, _269, _270, \
+        _271, _272, _273, _274, _275, _276, _277, _278, _279, _280, \
+        _281, _282, _283, _284, _285, _286, _287, _288, _289, _290, \
+        _291, _292, _293, _294, _295, _296, _297, _298, _299, _300, \
+        _301, _302, _303, _304, _305, _306, _307, _308, _309, _310, \
+        _311, _312, _313, _314, _315, _316, _317, _318, _319, _320, \
+        _321, _322, _323, _324, _325, _326, _327, _328, _329, _330, \
+        _331, _332, _333, _334, _335, _336, _337, _338, _339, _340, \
+        _341, _342, _343, _344, _345, _346, _347, _348, _349, _350, \
+        _351, _352, _353, _354, _355, _356, _357, _358, _359, _360, \
+        _361, _362, _363, _364, _365, _366, _367, _368, _369, _370, \
+        _371, _372, _373, _374, _375, _376, _377, _378, _379, _380, \
+        _381, _382, _383, _384, _385, _386, _387, _388, _389, _390, \
+        _391, _392, _393, _394, _395, _396, _397, _398, _399, _400, \
+        _401, _402, _403, _404, _405, _406, _407, _408, _409, _410, \
+        _411, _412, _413, _414, _415, _416, _417, _418, _419, _420, \
+        _421, _422, _423, _424, _425, _426, _427, _428, _429, _430, \
+        _431, _432, _433, _434, _435, _436, _437, _438, _439, _440, \
+        _441, _442, _443, _444, _445, _446, _447, _448, _449, _450, \
+        _451, _452, _453, _454, _455, _456, _457, _458, _459, _460, \
+        _461, _462, _463, _464, _465, _466, _467, _468, _469, _470, \
+        _471, _472, _473, _474, _475, _476, _477, _478, _479, _480, \
+        _481, _482, _483, _484, _485, _486, _487, _488, _489, _490, \
+        _491, _492, _493, _494, _495, _496, _497, _498, _499, _500, \
+        _501, _502, _503, _504, _505, _506, _507, _508, _509, _510, \
+        _511, _512, _513, _514, _515, _516, _517, _518, _519, _520, \
+        _521, _522, _523, _524, _525, _526, _527, _528, _529, _530, \
+        _531, _532, _533, _534, _535, _536, _537, _538, _539, _540, \
+        _541, _542, _543, _544, _545, _546, _547, _548, _549, _550, \
+        _551, _552, _553, _554, _555, _556, _557, _558, _559, _560, \
+        _561, _562, _563, _564, _565, _566, _567, _568, _569, _570, \
+        _571, _572, _573, _574, _575, _576, _577, _578, _579, _580, \
+        _581, _582, _583, _584, _585, _586, _587, _588, _589, _590, \
+        _591, _592, _593, _594, _595, _596, _597, _598, _599, _600, \
+        _601, _602, _603, _604, _605, _606, _607, _608, _609, _610, \
+        _611, _612, _613, _614, _615, _616, _617, _618, _619, _620, \
+        _621, _622, _623, _624, _625, _626, _627, _628, _629, _630, \
+        _631, _632, _633, _634, _635, _636, _637, _638, _639, _640, \
+        _641, _642, _643, _644, _645, _646, _647, _648, _649, _650, \
+        _651, _652, _653, _654, _655, _656, _657, _658, _659, _660, \
+        _661, _662, _663, _664, _665, _666, _667, _668, _669, _670, \
+        _671, _672, _673, _674, _675, _676, _677, _678, _679, _680, \
+        _681, _682, _683, _684, _685, _686, _687, _688, _689, _690, \
+        _691, _692, _693, _694, _695, _696, _697, _698, _699, _700, \
+        _701, _702, _703, _704, _705, _706, _707, _708, _709, _710, \
+        _711, _712, _713, _714, _715, _716, _717, _718, _719, _720, \
+        _721, _722, _723, _724, _725, _726, _727, _728, _729, _730, \
+        _731, _732, _733, _734, _735, _736, _737, _738, _739, _740, \
+        _741, _742, _743, _744, _745, _746, _747, _748, _749, _750, \
+        _751, _752, _753, _754, _755, _756, _757, _758, _759, _760, \
+        _761, _762, _763, _764, _765, _766, _767, _768, _769, _770, \
+        _771, _772, _773, _774, _775, _776, _777, _778, _779, _780, \
+        _781, _782, _783, _784, _785, _786, _787, _788, _789, _790, \
+        _791, _792, _793, _794, _795, _796, _797, _798, _799, _800, \
+        _801, _802, _803, _804, _805, _806, _807, _808, _809, _810, \
+        _811, _812, _813, _814, _815, _816, _817, _818, _819, _820, \
+        _821, _822, _823, _824, _825, _826, _827, _828, _829, _830, \
+        _831, _832, _833, _834, _835, _836, _837, _838, _839, _840, \
+        _841, _842, _843, _844, _845, _846, _847, _848, _849, _850, \
+        _851, _852, _853, _854, _855, _856, _857, _858, _859, _860, \
+        _861, _862, _863, _864, _865, _866, _867, _868, _869, _870, \
+        _871, _872, _873, _874, _875, _876, _877, _878, _879, _880, \
+        _881, _882, _883, _884, _885, _886, _887, _888, _889, _890, \
+        _891, _892, _893, _894, _895, _896, _897, _898, _899, _900, \
+        _901, _902, _903, _904, _905, _906, _907, _908, _909, _910, \
+        _911, _912, _913, _914, _915, _916, _917, _918, _919, _920, \
+        _921, _922, _923, _924, _925, _926, _927, _928, _929, _930, \
+        _931, _932, _933, _934, _935, _936, _937, _938, _939, _940, \
+        _941, _942, _943, _944, _945, _946, _947, _948, _949, _950, \
+        _951, _952, _953, _954, _955, _956, _957, _958, _959, _960, \
+        _961, _962, _963, _964, _965, _966, _967, _968, _969, _970, \
+        _971, _972, _973, _974, _975, _976, _977, _978, _979, _980, \
+        _981, _982, _983, _984, _985, _986, _987, _988, _989, _990, \
+        _991, _992, _993, _994, _995, _996, _997, _998, _999, _1000, \
+        _1001, _1002, _1003, _1004, _1005, _1006, _1007, _1008, _1009, _1010, \
+        _1011, _1012, _1013, _1014, _1015, _1016, _1017, _1018, _1019, _1020, \
+        _1021, _1022, _1023, _1024, N, ...) N
 #define CPPUTILS_RSEQ_N() \
-        63, 62, 61, 60, \
-        59, 58, 57, 56, 55, 54, 53, 52, 51, 50, \
-        49, 48, 47, 46, 45, 44, 43, 42, 41, 40, \
-        39, 38, 37, 36, 35, 34, 33, 32, 31, 30, \
-        29, 28, 27, 26, 25, 24, 23, 22, 21, 20, \
-        19, 18, 17, 16, 15, 14, 13, 12, 11, 10, \
-         9,  8,  7,  6,  5,  4,  3,  2,  1
-
-
-
-
-#define CPPUTILS_0_MAP1(m, t, ...) m(t)
-#define CPPUTILS_0_MAP2(m, t, ...) m(t) CPPUTILS_MAP1(m, __VA_ARGS__)
-#define CPPUTILS_0_MAP3(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP2(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP4(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP3(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP5(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP4(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP6(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP5(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP7(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP6(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP8(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP7(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP9(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP8(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP10(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP9(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP11(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP10(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP12(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP11(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP13(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP12(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP14(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP13(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP15(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP14(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP16(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP15(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP17(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP16(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP18(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP17(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP19(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP18(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP20(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP19(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP21(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP20(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP22(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP21(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP23(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP22(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP24(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP23(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP25(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP24(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP26(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP25(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP27(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP26(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP28(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP27(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP29(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP28(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP30(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP29(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP31(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP30(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP32(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP31(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP33(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP32(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP34(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP33(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP35(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP34(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP36(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP35(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP37(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP36(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP38(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP37(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP39(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP38(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP40(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP39(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP41(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP40(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP42(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP41(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP43(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP42(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP44(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP43(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP45(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP44(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP46(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP45(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP47(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP46(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP48(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP47(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP49(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP48(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP50(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP49(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP51(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP50(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP52(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP51(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP53(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP52(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP54(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP53(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP55(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP54(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP56(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP55(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP57(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP56(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP58(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP57(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP59(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP58(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP60(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP59(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP61(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP60(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP62(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP61(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP63(sep, m, t, ...) m(t) SEP_##sep CPPUTILS_0_MAP62(sep, m, __VA_ARGS__)
-#define CPPUTILS_0_MAP(n, m, ...) CPPUTILS_0_MAP##n(m, __VA_ARGS__)
-
-#define CPPUTILS_1_MAP1(sep, m, a, t, ...) m(a, t)
-#define CPPUTILS_1_MAP2(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP1(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP3(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP2(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP4(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP3(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP5(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP4(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP6(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP5(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP7(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP6(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP8(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP7(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP9(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP8(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP10(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP9(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP11(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP10(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP12(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP11(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP13(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP12(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP14(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP13(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP15(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP14(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP16(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP15(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP17(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP16(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP18(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP17(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP19(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP18(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP20(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP19(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP21(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP20(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP22(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP21(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP23(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP22(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP24(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP23(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP25(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP24(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP26(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP25(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP27(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP26(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP28(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP27(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP29(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP28(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP30(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP29(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP31(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP30(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP32(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP31(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP33(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP32(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP34(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP33(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP35(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP34(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP36(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP35(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP37(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP36(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP38(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP37(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP39(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP38(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP40(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP39(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP41(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP40(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP42(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP41(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP43(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP42(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP44(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP43(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP45(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP44(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP46(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP45(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP47(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP46(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP48(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP47(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP49(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP48(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP50(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP49(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP51(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP50(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP52(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP51(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP53(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP52(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP54(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP53(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP55(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP54(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP56(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP55(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP57(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP56(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP58(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP57(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP59(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP58(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP60(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP59(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP61(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP60(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP62(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP61(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP63(sep, m, a, t, ...) m(a, t) SEP_##sep CPPUTILS_1_MAP62(sep, m, a, __VA_ARGS__)
-#define CPPUTILS_1_MAP(n, sep, m, a, ...) CPPUTILS_1_MAP##n(sep, m, a, __VA_ARGS__)
+        1024, 1023, 1022, 1021, 1020, 1019, 1018, 1017, 1016, 1015, \
+        1014, 1013, 1012, 1011, 1010, 1009, 1008, 1007, 1006, 1005, \
+        1004, 1003, 1002, 1001, 1000, 999, 998, 997, 996, 995, \
+        994, 993, 992, 991, 990, 989, 988, 987, 986, 985, \
+        984, 983, 982, 981, 980, 979, 978, 977, 976, 975, \
+        974, 973, 972, 971, 970, 969, 968, 967, 966, 965, \
+        964, 963, 962, 961, 960, 959, 958, 957, 956, 955, \
+        954, 953, 952, 951, 950, 949, 948, 947, 946, 945, \
+        944, 943, 942, 941, 940, 939, 938, 937, 936, 935, \
+        934, 933, 932, 931, 930, 929, 928, 927, 926, 925, \
+        924, 923, 922, 921, 920, 919, 918, 917, 916, 915, \
+        914, 913, 912, 911, 910, 909, 908, 907, 906, 905, \
+        904, 903, 902, 901, 900, 899, 898, 897, 896, 895, \
+        894, 893, 892, 891, 890, 889, 888, 887, 886, 885, \
+        884, 883, 882, 881, 880, 879, 878, 877, 876, 875, \
+        874, 873, 872, 871, 870, 869, 868, 867, 866, 865, \
+        864, 863, 862, 861, 860, 859, 858, 857, 856, 855, \
+        854, 853, 852, 851, 850, 849, 848, 847, 846, 845, \
+        844, 843, 842, 841, 840, 839, 838, 837, 836, 835, \
+        834, 833, 832, 831, 830, 829, 828, 827, 826, 825, \
+        824, 823, 822, 821, 820, 819, 818, 817, 816, 815, \
+        814, 813, 812, 811, 810, 809, 808, 807, 806, 805, \
+        804, 803, 802, 801, 800, 799, 798, 797, 796, 795, \
+        794, 793, 792, 791, 790, 789, 788, 787, 786, 785, \
+        784, 783, 782, 781, 780, 779, 778, 777, 776, 775, \
+        774, 773, 772, 771, 770, 769, 768, 767, 766, 765, \
+        764, 763, 762, 761, 760, 759, 758, 757, 756, 755, \
+        754, 753, 752, 751, 750, 749, 748, 747, 746, 745, \
+        744, 743, 742, 741, 740, 739, 738, 737, 736, 735, \
+        734, 733, 732, 731, 730, 729, 728, 727, 726, 725, \
+        724, 723, 722, 721, 720, 719, 718, 717, 716, 715, \
+        714, 713, 712, 711, 710, 709, 708, 707, 706, 705, \
+        704, 703, 702, 701, 700, 699, 698, 697, 696, 695, \
+        694, 693, 692, 691, 690, 689, 688, 687, 686, 685, \
+        684, 683, 682, 681, 680, 679, 678, 677, 676, 675, \
+        674, 673, 672, 671, 670, 669, 668, 667, 666, 665, \
+        664, 663, 662, 661, 660, 659, 658, 657, 656, 655, \
+        654, 653, 652, 651, 650, 649, 648, 647, 646, 645, \
+        644, 643, 642, 641, 640, 639, 638, 637, 636, 635, \
+        634, 633, 632, 631, 630, 629, 628, 627, 626, 625, \
+        624, 623, 622, 621, 620, 619, 618, 617, 616, 615, \
+        614, 613, 612, 611, 610, 609, 608, 607, 606, 605, \
+        604, 603, 602, 601, 600, 599, 598, 597, 596, 595, \
+        594, 593, 592, 591, 590, 589, 588, 587, 586, 585, \
+        584, 583, 582, 581, 580, 579, 578, 577, 576, 575, \
+        574, 573, 572, 571, 570, 569, 568, 567, 566, 565, \
+        564, 563, 562, 561, 560, 559, 558, 557, 556, 555, \
+        554, 553, 552, 551, 550, 549, 548, 547, 546, 545, \
+        544, 543, 542, 541, 540, 539, 538, 537, 536, 535, \
+        534, 533, 532, 531, 530, 529, 528, 527, 526, 525, \
+        524, 523, 522, 521, 520, 519, 518, 517, 516, 515, \
+        514, 513, 512, 511, 510, 509, 508, 507, 506, 505, \
+        504, 503, 502, 501, 500, 499, 498, 497, 496, 495, \
+        494, 493, 492, 491, 490, 489, 488, 487, 486, 485, \
+        484, 483, 482, 481, 480, 479, 478, 477, 476, 475, \
+        474, 473, 472, 471, 470, 469, 468, 467, 466, 465, \
+        464, 463, 462, 461, 460, 459, 458, 457, 456, 455, \
+        454, 453, 452, 451, 450, 449, 448, 447, 446, 445, \
+        444, 443, 442, 441, 440, 439, 438, 437, 436, 435, \
+        434, 433, 432, 431, 430, 429, 428, 427, 426, 425, \
+        424, 423, 422, 421, 420, 419, 418, 417, 416, 415, \
+        414, 413, 412, 411, 410, 409, 408, 407, 406, 405, \
+        404, 403, 402, 401, 400, 399, 398, 397, 396, 395, \
+        394, 393, 392, 391, 390, 389, 388, 387, 386, 385, \
+        384, 383, 382, 381, 380, 379, 378, 377, 376, 375, \
+        374, 373, 372, 371, 370, 369, 368, 367, 366, 365, \
+        364, 363, 362, 361, 360, 359, 358, 357, 356, 355, \
+        354, 353, 352, 351, 350, 349, 348, 347, 346, 345, \
+        344, 343, 342, 341, 340, 339, 338, 337, 336, 335, \
+        334, 333, 332, 331, 330, 329, 328, 327, 326, 325, \
+        324, 323, 322, 321, 320, 319, 318, 317, 316, 315, \
+        314, 313, 312, 311, 310, 309, 308, 307, 306, 305, \
+        304, 303, 302, 301, 300, 299, 298, 297, 296, 295, \
+        294, 293, 292, 291, 290, 289, 288, 287, 286, 285, \
+        284, 283, 282, 281, 280, 279, 278, 277, 276, 275, \
+        274, 273, 272, 271, 270, 269, 268, 267, 266, 265, \
+        264, 263, 262, 261, 260, 259, 258, 257, 256, 255, \
+        254, 253, 252, 251, 250, 249, 248, 247, 246, 245, \
+        244, 243, 242, 241, 240, 239, 238, 237, 236, 235, \
+        234, 233, 232, 231, 230, 229, 228, 227, 226, 225, \
+        224, 223, 222, 221, 220, 219, 218, 217, 216, 215, \
+        214, 213, 212, 211, 210, 209, 208, 207, 206, 205, \
+        204, 203, 202, 201, 200, 199, 198, 197, 196, 195, \
+        194, 193, 192, 191, 190, 189, 188, 187, 186, 185, \
+        184, 183, 182, 181, 180, 179, 178, 177, 176, 175, \
+        174, 173, 172, 171, 170, 169, 168, 167, 166, 165, \
+        164, 163, 162, 161, 160, 159, 158, 157, 156, 155, \
+        154, 153, 152, 151, 150, 149, 148, 147, 146, 145, \
+        144, 143, 142, 141, 140, 139, 138, 137, 136, 135, \
+        134, 133, 132, 131, 130, 129, 128, 127, 126, 125, \
+        124, 123, 122, 121, 120, 119, 118, 117, 116, 115, \
+        114, 113, 112, 111, 110, 109, 108, 107, 106, 105, \
+        104, 103, 102, 101, 100, 99, 98, 97, 96, 95, \
+        94, 93, 92, 91, 90, 89, 88, 87, 86, 85, \
+        84, 83, 82, 81, 80, 79, 78, 77, 76, 75, \
+        74, 73, 72, 71, 70, 69, 68, 67, 66, 65, \
+        64, 63, 62, 61, 60, 59, 58, 57, 56, 55, \
+        54, 53, 52, 51, 50, 49, 48, 47, 46, 45, \
+        44, 43, 42, 41, 40, 39, 38, 37, 36, 35, \
+        34, 33, 32, 31, 30, 29, 28, 27, 26, 25, \
+        24, 23, 22, 21, 20, 19, 18, 17, 16, 15, \
+        14, 13, 12, 11, 10, 9, 8, 7, 6, 5, \
+        4, 3, 2, 1
+
+// Splits n into a chunk count q and a remainder r in [1, 16]
+#define CPPUTILS_DIVMOD_1 0, 1
+#define CPPUTILS_DIVMOD_2 0, 2
+#define CPPUTILS_DIVMOD_3 0, 3
+#define CPPUTILS_DIVMOD_4 0, 4
+#define CPPUTILS_DIVMOD_5 0, 5
+#define CPPUTILS_DIVMOD_6 0, 6
+#define CPPUTILS_DIVMOD_7 0, 7
+#define CPPUTILS_DIVMOD_8 0, 8
+#define CPPUTILS_DIVMOD_9 0, 9
+#define CPPUTILS_DIVMOD_10 0, 10
+#define CPPUTILS_DIVMOD_11 0, 11
+#define CPPUTILS_DIVMOD_12 0, 12
+#define CPPUTILS_DIVMOD_13 0, 13
+#define CPPUTILS_DIVMOD_14 0, 14
+#define CPPUTILS_DIVMOD_15 0, 15
+#define CPPUTILS_DIVMOD_16 0, 16
+#define CPPUTILS_DIVMOD_17 1, 1
+#define CPPUTILS_DIVMOD_18 1, 2
+#define CPPUTILS_DIVMOD_19 1, 3
+#define CPPUTILS_DIVMOD_20 1, 4
+#define CPPUTILS_DIVMOD_21 1, 5
+#define CPPUTILS_DIVMOD_22 1, 6
+#define CPPUTILS_DIVMOD_23 1, 7
+#define CPPUTILS_DIVMOD_24 1, 8
+#define CPPUTILS_DIVMOD_25 1, 9
+#define CPPUTILS_DIVMOD_26 1, 10
+#define CPPUTILS_DIVMOD_27 1, 11
+#define CPPUTILS_DIVMOD_28 1, 12
+#define CPPUTILS_DIVMOD_29 1, 13
+#define CPPUTILS_DIVMOD_30 1, 14
+#define CPPUTILS_DIVMOD_31 1, 15
+#define CPPUTILS_DIVMOD_32 1, 16
+#define CPPUTILS_DIVMOD_33 2, 1
+#define CPPUTILS_DIVMOD_34 2, 2
+#define CPPUTILS_DIVMOD_35 2, 3
+#define CPPUTILS_DIVMOD_36 2, 4
+#define CPPUTILS_DIVMOD_37 2, 5
+#define CPPUTILS_DIVMOD_38 2, 6
+#define CPPUTILS_DIVMOD_39 2, 7
+#define CPPUTILS_DIVMOD_40 2, 8
+#define CPPUTILS_DIVMOD_41 2, 9
+#define CPPUTILS_DIVMOD_42 2, 10
+#define CPPUTILS_DIVMOD_43 2, 11
+#define CPPUTILS_DIVMOD_44 2, 12
+#define CPPUTILS_DIVMOD_45 2, 13
+#define CPPUTILS_DIVMOD_46 2, 14
+#define CPPUTILS_DIVMOD_47 2, 15
+#define CPPUTILS_DIVMOD_48 2, 16
+#define CPPUTILS_DIVMOD_49 3, 1
+#define CPPUTILS_DIVMOD_50 3, 2
+#define CPPUTILS_DIVMOD_51 3, 3
+#define CPPUTILS_DIVMOD_52 3, 4
+#define CPPUTILS_DIVMOD_53 3, 5
+#define CPPUTILS_DIVMOD_54 3, 6
+#define CPPUTILS_DIVMOD_55 3, 7
+#define CPPUTILS_DIVMOD_56 3, 8
+#define CPPUTILS_DIVMOD_57 3, 9
+#define CPPUTILS_DIVMOD_58 3, 10
+#define CPPUTILS_DIVMOD_59 3, 11
+#define CPPUTILS_DIVMOD_60 3, 12
+#define CPPUTILS_DIVMOD_61 3, 13
+#define CPPUTILS_DIVMOD_62 3, 14
+#define CPPUTILS_DIVMOD_63 3, 15
+#define CPPUTILS_DIVMOD_64 3, 16
+#define CPPUTILS_DIVMOD_65 4, 1
+#define CPPUTILS_DIVMOD_66 4, 2
+#define CPPUTILS_DIVMOD_67 4, 3
+#define CPPUTILS_DIVMOD_68 4, 4
+#define CPPUTILS_DIVMOD_69 4, 5
+#define CPPUTILS_DIVMOD_70 4, 6
+#define CPPUTILS_DIVMOD_71 4, 7
+#define CPPUTILS_DIVMOD_72 4, 8
+#define CPPUTILS_DIVMOD_73 4, 9
+#define CPPUTILS_DIVMOD_74 4, 10
+#define CPPUTILS_DIVMOD_75 4, 11
+#define CPPUTILS_DIVMOD_76 4, 12
+#define CPPUTILS_DIVMOD_77 4, 13
+#define CPPUTILS_DIVMOD_78 4, 14
+#define CPPUTILS_DIVMOD_79 4, 15
+#define CPPUTILS_DIVMOD_80 4, 16
+#define CPPUTILS_DIVMOD_81 5, 1
+#define CPPUTILS_DIVMOD_82 5, 2
+#define CPPUTILS_DIVMOD_83 5, 3
+#define CPPUTILS_DIVMOD_84 5, 4
+#define CPPUTILS_DIVMOD_85 5, 5
+#define CPPUTILS_DIVMOD_86 5, 6
+#define CPPUTILS_DIVMOD_87 5, 7
+#define CPPUTILS_DIVMOD_88 5, 8
+#define CPPUTILS_DIVMOD_89 5, 9
+#define CPPUTILS_DIVMOD_90 5, 10
+#define CPPUTILS_DIVMOD_91 5, 11
+#define CPPUTILS_DIVMOD_92 5, 12
+#define CPPUTILS_DIVMOD_93 5, 13
+#define CPPUTILS_DIVMOD_94 5, 14
+#define CPPUTILS_DIVMOD_95 5, 15
+#define CPPUTILS_DIVMOD_96 5, 16
+#define CPPUTILS_DIVMOD_97 6, 1
+#define CPPUTILS_DIVMOD_98 6, 2
+#define CPPUTILS_DIVMOD_99 6, 3
+#define CPPUTILS_DIVMOD_100 6, 4
+#define CPPUTILS_DIVMOD_101 6, 5
+#define CPPUTILS_DIVMOD_102 6, 6
+#define CPPUTILS_DIVMOD_103 6, 7
+#define CPPUTILS_DIVMOD_104 6, 8
+#define CPPUTILS_DIVMOD_105 6, 9
+#define CPPUTILS_DIVMOD_106 6, 10
+#define CPPUTILS_DIVMOD_107 6, 11
+#define CPPUTILS_DIVMOD_108 6, 12
+#define CPPUTILS_DIVMOD_109 6, 13
+#define CPPUTILS_DIVMOD_110 6, 14
+#define CPPUTILS_DIVMOD_111 6, 15
+#define CPPUTILS_DIVMOD_112 6, 16
+#define CPPUTILS_DIVMOD_113 7, 1
+#define CPPUTILS_DIVMOD_114 7, 2
+#define CPPUTILS_DIVMOD_115 7, 3
+#define CPPUTILS_DIVMOD_116 7, 4
+#define CPPUTILS_DIVMOD_117 7, 5
+#define CPPUTILS_DIVMOD_118 7, 6
+#define CPPUTILS_DIVMOD_119 7, 7
+#define CPPUTILS_DIVMOD_120 7, 8
+#define CPPUTILS_DIVMOD_121 7, 9
+#define CPPUTILS_DIVMOD_122 7, 10
+#define CPPUTILS_DIVMOD_123 7, 11
+#define CPPUTILS_DIVMOD_124 7, 12
+#define CPPUTILS_DIVMOD_125 7, 13
+#define CPPUTILS_DIVMOD_126 7, 14
+#define CPPUTILS_DIVMOD_127 7, 15
+#define CPPUTILS_DIVMOD_128 7, 16
+#define CPPUTILS_DIVMOD_129 8, 1
+#define CPPUTILS_DIVMOD_130 8, 2
+#define CPPUTILS_DIVMOD_131 8, 3
+#define CPPUTILS_DIVMOD_132 8, 4
+#define CPPUTILS_DIVMOD_133 8, 5
+#define CPPUTILS_DIVMOD_134 8, 6
+#define CPPUTILS_DIVMOD_135 8, 7
+#define CPPUTILS_DIVMOD_136 8, 8
+#define CPPUTILS_DIVMOD_137 8, 9
+#define CPPUTILS_DIVMOD_138 8, 10
+#define CPPUTILS_DIVMOD_139 8, 11
+#define CPPUTILS_DIVMOD_140 8, 12
+#define CPPUTILS_DIVMOD_141 8, 13
+#define CPPUTILS_DIVMOD_142 8, 14
+#define CPPUTILS_DIVMOD_143 8, 15
+#define CPPUTILS_DIVMOD_144 8, 16
+#define CPPUTILS_DIVMOD_145 9, 1
+#define CPPUTILS_DIVMOD_146 9, 2
+#define CPPUTILS_DIVMOD_147 9, 3
+#define CPPUTILS_DIVMOD_148 9, 4
+#define CPPUTILS_DIVMOD_149 9, 5
+#define CPPUTILS_DIVMOD_150 9, 6
+#define CPPUTILS_DIVMOD_151 9, 7
+#define CPPUTILS_DIVMOD_152 9, 8
+#define CPPUTILS_DIVMOD_153 9, 9
+#define CPPUTILS_DIVMOD_154 9, 10
+#define CPPUTILS_DIVMOD_155 9, 11
+#define CPPUTILS_DIVMOD_156 9, 12
+#define CPPUTILS_DIVMOD_157 9, 13
+#define CPPUTILS_DIVMOD_158 9, 14
+#define CPPUTILS_DIVMOD_159 9, 15
+#define CPPUTILS_DIVMOD_160 9, 16
+#define CPPUTILS_DIVMOD_161 10, 1
+#define CPPUTILS_DIVMOD_162 10, 2
+#define CPPUTILS_DIVMOD_163 10, 3
+#define CPPUTILS_DIVMOD_164 10, 4
+#define CPPUTILS_DIVMOD_165 10, 5
+#define CPPUTILS_DIVMOD_166 10, 6
+#define CPPUTILS_DIVMOD_167 10, 7
+#define CPPUTILS_DIVMOD_168 10, 8
+#define CPPUTILS_DIVMOD_169 10, 9
+#define CPPUTILS_DIVMOD_170 10, 10
+#define CPPUTILS_DIVMOD_171 10, 11
+#define CPPUTILS_DIVMOD_172 10, 12
+#define CPPUTILS_DIVMOD_173 10, 13
+#define CPPUTILS_DIVMOD_174 10, 14
+#define CPPUTILS_DIVMOD_175 10, 15
+#define CPPUTILS_DIVMOD_176 10, 16
+#define CPPUTILS_DIVMOD_177 11, 1
+#define CPPUTILS_DIVMOD_178 11, 2
+#define CPPUTILS_DIVMOD_179 11, 3
+#define CPPUTILS_DIVMOD_180 11, 4
+#define CPPUTILS_DIVMOD_181 11, 5
+#define CPPUTILS_DIVMOD_182 11, 6
+#define CPPUTILS_DIVMOD_183 11, 7
+#define CPPUTILS_DIVMOD_184 11, 8
+#define CPPUTILS_DIVMOD_185 11, 9
+#define CPPUTILS_DIVMOD_186 11, 10
+#define CPPUTILS_DIVMOD_187 11, 11
+#define CPPUTILS_DIVMOD_188 11, 12
+#define CPPUTILS_DIVMOD_189 11, 13
+#define CPPUTILS_DIVMOD_190 11, 14
+#define CPPUTILS_DIVMOD_191 11, 15
+#define CPPUTILS_DIVMOD_192 11, 16
+#define CPPUTILS_DIVMOD_193 12, 1
+#define CPPUTILS_DIVMOD_194 12, 2
+#define CPPUTILS_DIVMOD_195 12, 3
+#define CPPUTILS_DIVMOD_196 12, 4
+#define CPPUTILS_DIVMOD_197 12, 5
+#define CPPUTILS_DIVMOD_198 12, 6
+#define CPPUTILS_DIVMOD_199 12, 7
+#define CPPUTILS_DIVMOD_200 12, 8
+#define CPPUTILS_DIVMOD_201 12, 9
+#define CPPUTILS_DIVMOD_202 12, 10
+#define CPPUTILS_DIVMOD_203 12, 11
+#define CPPUTILS_DIVMOD_204 12, 12
+#define CPPUTILS_DIVMOD_205 12, 13
+#define CPPUTILS_DIVMOD_206 12, 14
+#define CPPUTILS_DIVMOD_207 12, 15
+#define CPPUTILS_DIVMOD_208 12, 16
+#define CPPUTILS_DIVMOD_209 13, 1
+#define CPPUTILS_DIVMOD_210 13, 2
+#define CPPUTILS_DIVMOD_211 13, 3
+#define CPPUTILS_DIVMOD_212 13, 4
+#define CPPUTILS_DIVMOD_213 13, 5
+#define CPPUTILS_DIVMOD_214 13, 6
+#define CPPUTILS_DIVMOD_215 13, 7
+#define CPPUTILS_DIVMOD_216 13, 8
+#define CPPUTILS_DIVMOD_217 13, 9
+#define CPPUTILS_DIVMOD_218 13, 10
+#define CPPUTILS_DIVMOD_219 13, 11
+#define CPPUTILS_DIVMOD_220 13, 12
+#define CPPUTILS_DIVMOD_221 13, 13
+#define CPPUTILS_DIVMOD_222 13, 14
+#define CPPUTILS_DIVMOD_223 13, 15
+#define CPPUTILS_DIVMOD_224 13, 16
+#define CPPUTILS_DIVMOD_225 14, 1
+#define CPPUTILS_DIVMOD_226 14, 2
+#define CPPUTILS_DIVMOD_227 14, 3
+#define CPPUTILS_DIVMOD_228 14, 4
+#define CPPUTILS_DIVMOD_229 14, 5
+#define CPPUTILS_DIVMOD_230 14, 6
+#define CPPUTILS_DIVMOD_231 14, 7
+#define CPPUTILS_DIVMOD_232 14, 8
+#define CPPUTILS_DIVMOD_233 14, 9
+#define CPPUTILS_DIVMOD_234 14, 10
+#define CPPUTILS_DIVMOD_235 14, 11
+#define CPPUTILS_DIVMOD_236 14, 12
+#define CPPUTILS_DIVMOD_237 14, 13
+#define CPPUTILS_DIVMOD_238 14, 14
+#define CPPUTILS_DIVMOD_239 14, 15
+#define CPPUTILS_DIVMOD_240 14, 16
+#define CPPUTILS_DIVMOD_241 15, 1
+#define CPPUTILS_DIVMOD_242 15, 2
+#define CPPUTILS_DIVMOD_243 15, 3
+#define CPPUTILS_DIVMOD_244 15, 4
+#define CPPUTILS_DIVMOD_245 15, 5
+#define CPPUTILS_DIVMOD_246 15, 6
+#define CPPUTILS_DIVMOD_247 15, 7
+#define CPPUTILS_DIVMOD_248 15, 8
+#define CPPUTILS_DIVMOD_249 15, 9
+#define CPPUTILS_DIVMOD_250 15, 10
+#define CPPUTILS_DIVMOD_251 15, 11
+#define CPPUTILS_DIVMOD_252 15, 12
+#define CPPUTILS_DIVMOD_253 15, 13
+#define CPPUTILS_DIVMOD_254 15, 14
+#define CPPUTILS_DIVMOD_255 15, 15
+#define CPPUTILS_DIVMOD_256 15, 16
+#define CPPUTILS_DIVMOD_257 16, 1
+#define CPPUTILS_DIVMOD_258 16, 2
+#define CPPUTILS_DIVMOD_259 16, 3
+#define CPPUTILS_DIVMOD_260 16, 4
+#define CPPUTILS_DIVMOD_261 16, 5
+#define CPPUTILS_DIVMOD_262 16, 6
+#define CPPUTILS_DIVMOD_263 16, 7
+#define CPPUTILS_DIVMOD_264 16, 8
+#define CPPUTILS_DIVMOD_265 16, 9
+#define CPPUTILS_DIVMOD_266 16, 10
+#define CPPUTILS_DIVMOD_267 16, 11
+#define CPPUTILS_DIVMOD_268 16, 12
+#define CPPUTILS_DIVMOD_269 16, 13
+#define CPPUTILS_DIVMOD_270 16, 14
+#define CPPUTILS_DIVMOD_271 16, 15
+#define CPPUTILS_DIVMOD_272 16, 16
+#define CPPUTILS_DIVMOD_273 17, 1
+#define CPPUTILS_DIVMOD_274 17, 2
+#define CPPUTILS_DIVMOD_275 17, 3
+#define CPPUTILS_DIVMOD_276 17, 4
+#define CPPUTILS_DIVMOD_277 17, 5
+#define CPPUTILS_DIVMOD_278 17, 6
+#define CPPUTILS_DIVMOD_279 17, 7
+#define CPPUTILS_DIVMOD_280 17, 8
+#define CPPUTILS_DIVMOD_281 17, 9
+#define CPPUTILS_DIVMOD_282 17, 10
+#define CPPUTILS_DIVMOD_283 17, 11
+#define CPPUTILS_DIVMOD_284 17, 12
+#define CPPUTILS_DIVMOD_285 17, 13
+#define CPPUTILS_DIVMOD_286 17, 14
+#define CPPUTILS_DIVMOD_287 17, 15
+#define CPPUTILS_DIVMOD_288 17, 16
+#define CPPUTILS_DIVMOD_289 18, 1
+#define CPPUTILS_DIVMOD_290 18, 2
+#define CPPUTILS_DIVMOD_291 18, 3
+#define CPPUTILS_DIVMOD_292 18, 4
+#define CPPUTILS_DIVMOD_293 18, 5
+#define CPPUTILS_DIVMOD_294 18, 6
+#define CPPUTILS_DIVMOD_295 18, 7
+#define CPPUTILS_DIVMOD_296 18, 8
+#define CPPUTILS_DIVMOD_297 18, 9
+#define CPPUTILS_DIVMOD_298 18, 10
+#define CPPUTILS_DIVMOD_299 18, 11
+#define CPPUTILS_DIVMOD_300 18, 12
+#define CPPUTILS_DIVMOD_301 18, 13
+#define CPPUTILS_DIVMOD_302 18, 14
+#define CPPUTILS_DIVMOD_303 18, 15
+#define CPPUTILS_DIVMOD_304 18, 16
+#define CPPUTILS_DIVMOD_305 19, 1
+#define CPPUTILS_DIVMOD_306 19, 2
+#define CPPUTILS_DIVMOD_307 19, 3
+#define CPPUTILS_DIVMOD_308 19, 4
+#define CPPUTILS_DIVMOD_309 19, 5
+#define CPPUTILS_DIVMOD_310 19, 6
+#define CPPUTILS_DIVMOD_311 19, 7
+#define CPPUTILS_DIVMOD_312 19, 8
+#define CPPUTILS_DIVMOD_313 19, 9
+#define CPPUTILS_DIVMOD_314 19, 10
+#define CPPUTILS_DIVMOD_315 19, 11
+#define CPPUTILS_DIVMOD_316 19, 12
+#define CPPUTILS_DIVMOD_317 19, 13
+#define CPPUTILS_DIVMOD_318 19, 14
+#define CPPUTILS_DIVMOD_319 19, 15
+#define CPPUTILS_DIVMOD_320 19, 16
+#define CPPUTILS_DIVMOD_321 20, 1
+#define CPPUTILS_DIVMOD_322 20, 2
+#define CPPUTILS_DIVMOD_323 20, 3
+#define CPPUTILS_DIVMOD_324 20, 4
+#define CPPUTILS_DIVMOD_325 20, 5
+#define CPPUTILS_DIVMOD_326 20, 6
+#define CPPUTILS_DIVMOD_327 20, 7
+#define CPPUTILS_DIVMOD_328 20, 8
+#define CPPUTILS_DIVMOD_329 20, 9
+#define CPPUTILS_DIVMOD_330 20, 10
+#define CPPUTILS_DIVMOD_331 20, 11
+#define CPPUTILS_DIVMOD_332 20, 12
+#define CPPUTILS_DIVMOD_333 20, 13
+#define CPPUTILS_DIVMOD_334 20, 14
+#define CPPUTILS_DIVMOD_335 20, 15
+#define CPPUTILS_DIVMOD_336 20, 16
+#define CPPUTILS_DIVMOD_337 21, 1
+#define CPPUTILS_DIVMOD_338 21, 2
+#define CPPUTILS_DIVMOD_339 21, 3
+#define CPPUTILS_DIVMOD_340 21, 4
+#define CPPUTILS_DIVMOD_341 21, 5
+#define CPPUTILS_DIVMOD_342 21, 6
+#define CPPUTILS_DIVMOD_343 21, 7
+#define CPPUTILS_DIVMOD_344 21, 8
+#define CPPUTILS_DIVMOD_345 21, 9
+#define CPPUTILS_DIVMOD_346 21, 10
+#define CPPUTILS_DIVMOD_347 21, 11
+#define CPPUTILS_DIVMOD_348 21, 12
+#define CPPUTILS_DIVMOD_349 21, 13
+#define CPPUTILS_DIVMOD_350 21, 14
+#define CPPUTILS_DIVMOD_351 21, 15
+#define CPPUTILS_DIVMOD_352 21, 16
+#define CPPUTILS_DIVMOD_353 22, 1
+#define CPPUTILS_DIVMOD_354 22, 2
+#define CPPUTILS_DIVMOD_355 22, 3
+#define CPPUTILS_DIVMOD_356 22, 4
+#define CPPUTILS_DIVMOD_357 22, 5
+#define CPPUTILS_DIVMOD_358 22, 6
+#define CPPUTILS_DIVMOD_359 22, 7
+#define CPPUTILS_DIVMOD_360 22, 8
+#define CPPUTILS_DIVMOD_361 22, 9
+#define CPPUTILS_DIVMOD_362 22, 10
+#define CPPUTILS_DIVMOD_363 22, 11
+#define CPPUTILS_DIVMOD_364 22, 12
+#define CPPUTILS_DIVMOD_365 22, 13
+#define CPPUTILS_DIVMOD_366 22, 14
+#define CPPUTILS_DIVMOD_367 22, 15
+#define CPPUTILS_DIVMOD_368 22, 16
+#define CPPUTILS_DIVMOD_369 23, 1
+#define CPPUTILS_DIVMOD_370 23, 2
+#define CPPUTILS_DIVMOD_371 23, 3
+#define CPPUTILS_DIVMOD_372 23, 4
+#define CPPUTILS_DIVMOD_373 23, 5
+#define CPPUTILS_DIVMOD_374 23, 6
+#define CPPUTILS_DIVMOD_375 23, 7
+#define CPPUTILS_DIVMOD_376 23, 8
+#define CPPUTILS_DIVMOD_377 23, 9
+#define CPPUTILS_DIVMOD_378 23, 10
+#define CPPUTILS_DIVMOD_379 23, 11
+#define CPPUTILS_DIVMOD_380 23, 12
+#define CPPUTILS_DIVMOD_381 23, 13
+#define CPPUTILS_DIVMOD_382 23, 14
+#define CPPUTILS_DIVMOD_383 23, 15
+#define CPPUTILS_DIVMOD_384 23, 16
+#define CPPUTILS_DIVMOD_385 24, 1
+#define CPPUTILS_DIVMOD_386 24, 2
+#define CPPUTILS_DIVMOD_387 24, 3
+#define CPPUTILS_DIVMOD_388 24, 4
+#define CPPUTILS_DIVMOD_389 24, 5
+#define CPPUTILS_DIVMOD_390 24, 6
+#define CPPUTILS_DIVMOD_391 24, 7
+#define CPPUTILS_DIVMOD_392 24, 8
+#define CPPUTILS_DIVMOD_393 24, 9
+#define CPPUTILS_DIVMOD_394 24, 10
+#define CPPUTILS_DIVMOD_395 24, 11
+#define CPPUTILS_DIVMOD_396 24, 12
+#define CPPUTILS_DIVMOD_397 24, 13
+#define CPPUTILS_DIVMOD_398 24, 14
+#define CPPUTILS_DIVMOD_399 24, 15
+#define CPPUTILS_DIVMOD_400 24, 16
+#define CPPUTILS_DIVMOD_401 25, 1
+#define CPPUTILS_DIVMOD_402 25, 2
+#define CPPUTILS_DIVMOD_403 25, 3
+#define CPPUTILS_DIVMOD_404 25, 4
+#define CPPUTILS_DIVMOD_405 25, 5
+#define CPPUTILS_DIVMOD_406 25, 6
+#define CPPUTILS_DIVMOD_407 25, 7
+#define CPPUTILS_DIVMOD_408 25, 8
+#define CPPUTILS_DIVMOD_409 25, 9
+#define CPPUTILS_DIVMOD_410 25, 10
+#define CPPUTILS_DIVMOD_411 25, 11
+#define CPPUTILS_DIVMOD_412 25, 12
+#define CPPUTILS_DIVMOD_413 25, 13
+#define CPPUTILS_DIVMOD_414 25, 14
+#define CPPUTILS_DIVMOD_415 25, 15
+#define CPPUTILS_DIVMOD_416 25, 16
+#define CPPUTILS_DIVMOD_417 26, 1
+#define CPPUTILS_DIVMOD_418 26, 2
+#define CPPUTILS_DIVMOD_419 26, 3
+#define CPPUTILS_DIVMOD_420 26, 4
+#define CPPUTILS_DIVMOD_421 26, 5
+#define CPPUTILS_DIVMOD_422 26, 6
+#define CPPUTILS_DIVMOD_423 26, 7
+#define CPPUTILS_DIVMOD_424 26, 8
+#define CPPUTILS_DIVMOD_425 26, 9
+#define CPPUTILS_DIVMOD_426 26, 10
+#define CPPUTILS_DIVMOD_427 26, 11
+#define CPPUTILS_DIVMOD_428 26, 12
+#define CPPUTILS_DIVMOD_429 26, 13
+#define CPPUTILS_DIVMOD_430 26, 14
+#define CPPUTILS_DIVMOD_431 26, 15
+#define CPPUTILS_DIVMOD_432 26, 16
+#define CPPUTILS_DIVMOD_433 27, 1
+#define CPPUTILS_DIVMOD_434 27, 2
+#define CPPUTILS_DIVMOD_435 27, 3
+#define CPPUTILS_DIVMOD_436 27, 4
+#define CPPUTILS_DIVMOD_437 27, 5
+#define CPPUTILS_DIVMOD_438 27, 6
+#define CPPUTILS_DIVMOD_439 27, 7
+#define CPPUTILS_DIVMOD_440 27, 8
+#define CPPUTILS_DIVMOD_441 27, 9
+#define CPPUTILS_DIVMOD_442 27, 10
+#define CPPUTILS_DIVMOD_443 27, 11
+#define CPPUTILS_DIVMOD_444 27, 12
+#define CPPUTILS_DIVMOD_445 27, 13
+#define CPPUTILS_DIVMOD_446 27, 14
+#define CPPUTILS_DIVMOD_447 27, 15
+#define CPPUTILS_DIVMOD_448 27, 16
+#define CPPUTILS_DIVMOD_449 28, 1
+#define CPPUTILS_DIVMOD_450 28, 2
+#define CPPUTILS_DIVMOD_451 28, 3
+#define CPPUTILS_DIVMOD_452 28, 4
+#define CPPUTILS_DIVMOD_453 28, 5
+#define CPPUTILS_DIVMOD_454 28, 6
+#define CPPUTILS_DIVMOD_455 28, 7
+#define CPPUTILS_DIVMOD_456 28, 8
+#define CPPUTILS_DIVMOD_457 28, 9
+#define CPPUTILS_DIVMOD_458 28, 10
+#define CPPUTILS_DIVMOD_459 28, 11
+#define CPPUTILS_DIVMOD_460 28, 12
+#define CPPUTILS_DIVMOD_461 28, 13
+#define CPPUTILS_DIVMOD_462 28, 14
+#define CPPUTILS_DIVMOD_463 28, 15
+#define CPPUTILS_DIVMOD_464 28, 16
+#define CPPUTILS_DIVMOD_465 29, 1
+#define CPPUTILS_DIVMOD_466 29, 2
+#define CPPUTILS_DIVMOD_467 29, 3
+#define CPPUTILS_DIVMOD_468 29, 4
+#define CPPUTILS_DIVMOD_469 29, 5
+#define CPPUTILS_DIVMOD_470 29, 6
+#define CPPUTILS_DIVMOD_471 29, 7
+#define CPPUTILS_DIVMOD_472 29, 8
+#define CPPUTILS_DIVMOD_473 29, 9
+#define CPPUTILS_DIVMOD_474 29, 10
+#define CPPUTILS_DIVMOD_475 29, 11
+#define CPPUTILS_DIVMOD_476 29, 12
+#define CPPUTILS_DIVMOD_477 29, 13
+#define CPPUTILS_DIVMOD_478 29, 14
+#define CPPUTILS_DIVMOD_479 29, 15
+#define CPPUTILS_DIVMOD_480 29, 16
+#define CPPUTILS_DIVMOD_481 30, 1
+#define CPPUTILS_DIVMOD_482 30, 2
+#define CPPUTILS_DIVMOD_483 30, 3
+#define CPPUTILS_DIVMOD_484 30, 4
+#define CPPUTILS_DIVMOD_485 30, 5
+#define CPPUTILS_DIVMOD_486 30, 6
+#define CPPUTILS_DIVMOD_487 30, 7
+#define CPPUTILS_DIVMOD_488 30, 8
+#define CPPUTILS_DIVMOD_489 30, 9
+#define CPPUTILS_DIVMOD_490 30, 10
+#define CPPUTILS_DIVMOD_491 30, 11
+#define CPPUTILS_DIVMOD_492 30, 12
+#define CPPUTILS_DIVMOD_493 30, 13
+#define CPPUTILS_DIVMOD_494 30, 14
+#define CPPUTILS_DIVMOD_495 30, 15
+#define CPPUTILS_DIVMOD_496 30, 16
+#define CPPUTILS_DIVMOD_497 31, 1
+#define CPPUTILS_DIVMOD_498 31, 2
+#define CPPUTILS_DIVMOD_499 31, 3
+#define CPPUTILS_DIVMOD_500 31, 4
+#define CPPUTILS_DIVMOD_501 31, 5
+#define CPPUTILS_DIVMOD_502 31, 6
+#define CPPUTILS_DIVMOD_503 31, 7
+#define CPPUTILS_DIVMOD_504 31, 8
+#define CPPUTILS_DIVMOD_505 31, 9
+#define CPPUTILS_DIVMOD_506 31, 10
+#define CPPUTILS_DIVMOD_507 31, 11
+#define CPPUTILS_DIVMOD_508 31, 12
+#define CPPUTILS_DIVMOD_509 31, 13
+#define CPPUTILS_DIVMOD_510 31, 14
+#define CPPUTILS_DIVMOD_511 31, 15
+#define CPPUTILS_DIVMOD_512 31, 16
+#define CPPUTILS_DIVMOD_513 32, 1
+#define CPPUTILS_DIVMOD_514 32, 2
+#define CPPUTILS_DIVMOD_515 32, 3
+#define CPPUTILS_DIVMOD_516 32, 4
+#define CPPUTILS_DIVMOD_517 32, 5
+#define CPPUTILS_DIVMOD_518 32, 6
+#define CPPUTILS_DIVMOD_519 32, 7
+#define CPPUTILS_DIVMOD_520 32, 8
+#define CPPUTILS_DIVMOD_521 32, 9
+#define CPPUTILS_DIVMOD_522 32, 10
+#define CPPUTILS_DIVMOD_523 32, 11
+#define CPPUTILS_DIVMOD_524 32, 12
+#define CPPUTILS_DIVMOD_525 32, 13
+#define CPPUTILS_DIVMOD_526 32, 14
+#define CPPUTILS_DIVMOD_527 32, 15
+#define CPPUTILS_DIVMOD_528 32, 16
+#define CPPUTILS_DIVMOD_529 33, 1
+#define CPPUTILS_DIVMOD_530 33, 2
+#define CPPUTILS_DIVMOD_531 33, 3
+#define CPPUTILS_DIVMOD_532 33, 4
+#define CPPUTILS_DIVMOD_533 33, 5
+#define CPPUTILS_DIVMOD_534 33, 6
+#define CPPUTILS_DIVMOD_535 33, 7
+#define CPPUTILS_DIVMOD_536 33, 8
+#define CPPUTILS_DIVMOD_537 33, 9
+#define CPPUTILS_DIVMOD_538 33, 10
+#define CPPUTILS_DIVMOD_539 33, 11
+#define CPPUTILS_DIVMOD_540 33, 12
+#define CPPUTILS_DIVMOD_541 33, 13
+#define CPPUTILS_DIVMOD_542 33, 14
+#define CPPUTILS_DIVMOD_543 33, 15
+#define CPPUTILS_DIVMOD_544 33, 16
+#define CPPUTILS_DIVMOD_545 34, 1
+#define CPPUTILS_DIVMOD_546 34, 2
+#define CPPUTILS_DIVMOD_547 34, 3
+#define CPPUTILS_DIVMOD_548 34, 4
+#define CPPUTILS_DIVMOD_549 34, 5
+#define CPPUTILS_DIVMOD_550 34, 6
+#define CPPUTILS_DIVMOD_551 34, 7
+#define CPPUTILS_DIVMOD_552 34, 8
+#define CPPUTILS_DIVMOD_553 34, 9
+#define CPPUTILS_DIVMOD_554 34, 10
+#define CPPUTILS_DIVMOD_555 34, 11
+#define CPPUTILS_DIVMOD_556 34, 12
+#define CPPUTILS_DIVMOD_557 34, 13
+#define CPPUTILS_DIVMOD_558 34, 14
+#define CPPUTILS_DIVMOD_559 34, 15
+#define CPPUTILS_DIVMOD_560 34, 16
+#define CPPUTILS_DIVMOD_561 35, 1
+#define CPPUTILS_DIVMOD_562 35, 2
+#define CPPUTILS_DIVMOD_563 35, 3
+#define CPPUTILS_DIVMOD_564 35, 4
+#define CPPUTILS_DIVMOD_565 35, 5
+#define CPPUTILS_DIVMOD_566 35, 6
+#define CPPUTILS_DIVMOD_567 35, 7
+#define CPPUTILS_DIVMOD_568 35, 8
+#define CPPUTILS_DIVMOD_569 35, 9
+#define CPPUTILS_DIVMOD_570 35, 10
+#define CPPUTILS_DIVMOD_571 35, 11
+#define CPPUTILS_DIVMOD_572 35, 12
+#define CPPUTILS_DIVMOD_573 35, 13
+#define CPPUTILS_DIVMOD_574 35, 14
+#define CPPUTILS_DIVMOD_575 35, 15
+#define CPPUTILS_DIVMOD_576 35, 16
+#define CPPUTILS_DIVMOD_577 36, 1
+#define CPPUTILS_DIVMOD_578 36, 2
+#define CPPUTILS_DIVMOD_579 36, 3
+#define CPPUTILS_DIVMOD_580 36, 4
+#define CPPUTILS_DIVMOD_581 36, 5
+#define CPPUTILS_DIVMOD_582 36, 6
+#define CPPUTILS_DIVMOD_583 36, 7
+#define CPPUTILS_DIVMOD_584 36, 8
+#define CPPUTILS_DIVMOD_585 36, 9
+#define CPPUTILS_DIVMOD_586 36, 10
+#define CPPUTILS_DIVMOD_587 36, 11
+#define CPPUTILS_DIVMOD_588 36, 12
+#define CPPUTILS_DIVMOD_589 36, 13
+#define CPPUTILS_DIVMOD_590 36, 14
+#define CPPUTILS_DIVMOD_591 36, 15
+#define CPPUTILS_DIVMOD_592 36, 16
+#define CPPUTILS_DIVMOD_593 37, 1
+#define CPPUTILS_DIVMOD_594 37, 2
+#define CPPUTILS_DIVMOD_595 37, 3
+#define CPPUTILS_DIVMOD_596 37, 4
+#define CPPUTILS_DIVMOD_597 37, 5
+#define CPPUTILS_DIVMOD_598 37, 6
+#define CPPUTILS_DIVMOD_599 37, 7
+#define CPPUTILS_DIVMOD_600 37, 8
+#define CPPUTILS_DIVMOD_601 37, 9
+#define CPPUTILS_DIVMOD_602 37, 10
+#define CPPUTILS_DIVMOD_603 37, 11
+#define CPPUTILS_DIVMOD_604 37, 12
+#define CPPUTILS_DIVMOD_605 37, 13
+#define CPPUTILS_DIVMOD_606 37, 14
+#define CPPUTILS_DIVMOD_607 37, 15
+#define CPPUTILS_DIVMOD_608 37, 16
+#define CPPUTILS_DIVMOD_609 38, 1
+#define CPPUTILS_DIVMOD_610 38, 2
+#define CPPUTILS_DIVMOD_611 38, 3
+#define CPPUTILS_DIVMOD_612 38, 4
+#define CPPUTILS_DIVMOD_613 38, 5
+#define CPPUTILS_DIVMOD_614 38, 6
+#define CPPUTILS_DIVMOD_615 38, 7
+#define CPPUTILS_DIVMOD_616 38, 8
+#define CPPUTILS_DIVMOD_617 38, 9
+#define CPPUTILS_DIVMOD_618 38, 10
+#define CPPUTILS_DIVMOD_619 38, 11
+#define CPPUTILS_DIVMOD_620 38, 12
+#define CPPUTILS_DIVMOD_621 38, 13
+#define CPPUTILS_DIVMOD_622 38, 14
+#define CPPUTILS_DIVMOD_623 38, 15
+#define CPPUTILS_DIVMOD_624 38, 16
+#define CPPUTILS_DIVMOD_625 39, 1
+#define CPPUTILS_DIVMOD_626 39, 2
+#define CPPUTILS_DIVMOD_627 39, 3
+#define CPPUTILS_DIVMOD_628 39, 4
+#define CPPUTILS_DIVMOD_629 39, 5
+#define CPPUTILS_DIVMOD_630 39, 6
+#define CPPUTILS_DIVMOD_631 39, 7
+#define CPPUTILS_DIVMOD_632 39, 8
+#define CPPUTILS_DIVMOD_633 39, 9
+#define CPPUTILS_DIVMOD_634 39, 10
+#define CPPUTILS_DIVMOD_635 39, 11
+#define CPPUTILS_DIVMOD_636 39, 12
+#define CPPUTILS_DIVMOD_637 39, 13
+#define CPPUTILS_DIVMOD_638 39, 14
+#define CPPUTILS_DIVMOD_639 39, 15
+#define CPPUTILS_DIVMOD_640 39, 16
+#define CPPUTILS_DIVMOD_641 40, 1
+#define CPPUTILS_DIVMOD_642 40, 2
+#define CPPUTILS_DIVMOD_643 40, 3
+#define CPPUTILS_DIVMOD_644 40, 4
+#define CPPUTILS_DIVMOD_645 40, 5
+#define CPPUTILS_DIVMOD_646 40, 6
+#define CPPUTILS_DIVMOD_647 40, 7
+#define CPPUTILS_DIVMOD_648 40, 8
+#define CPPUTILS_DIVMOD_649 40, 9
+#define CPPUTILS_DIVMOD_650 40, 10
+#define CPPUTILS_DIVMOD_651 40, 11
+#define CPPUTILS_DIVMOD_652 40, 12
+#define CPPUTILS_DIVMOD_653 40, 13
+#define CPPUTILS_DIVMOD_654 40, 14
+#define CPPUTILS_DIVMOD_655 40, 15
+#define CPPUTILS_DIVMOD_656 40, 16
+#define CPPUTILS_DIVMOD_657 41, 1
+#define CPPUTILS_DIVMOD_658 41, 2
+#define CPPUTILS_DIVMOD_659 41, 3
+#define CPPUTILS_DIVMOD_660 41, 4
+#define CPPUTILS_DIVMOD_661 41, 5
+#define CPPUTILS_DIVMOD_662 41, 6
+#define CPPUTILS_DIVMOD_663 41, 7
+#define CPPUTILS_DIVMOD_664 41, 8
+#define CPPUTILS_DIVMOD_665 41, 9
+#define CPPUTILS_DIVMOD_666 41, 10
+#define CPPUTILS_DIVMOD_667 41, 11
+#define CPPUTILS_DIVMOD_668 41, 12
+#define CPPUTILS_DIVMOD_669 41, 13
+#define CPPUTILS_DIVMOD_670 41, 14
+#define CPPUTILS_DIVMOD_671 41, 15
+#define CPPUTILS_DIVMOD_672 41, 16
+#define CPPUTILS_DIVMOD_673 42, 1
+#define CPPUTILS_DIVMOD_674 42, 2
+#define CPPUTILS_DIVMOD_675 42, 3
+#define CPPUTILS_DIVMOD_676 42, 4
+#define CPPUTILS_DIVMOD_677 42, 5
+#define CPPUTILS_DIVMOD_678 42, 6
+#define CPPUTILS_DIVMOD_679 42, 7
+#define CPPUTILS_DIVMOD_680 42, 8
+#define CPPUTILS_DIVMOD_681 42, 9
+#define CPPUTILS_DIVMOD_682 42, 10
+#define CPPUTILS_DIVMOD_683 42, 11
+#define CPPUTILS_DIVMOD_684 42, 12
+#define CPPUTILS_DIVMOD_685 42, 13
+#define CPPUTILS_DIVMOD_686 42, 14
+#define CPPUTILS_DIVMOD_687 42, 15
+#define CPPUTILS_DIVMOD_688 42, 16
+#define CPPUTILS_DIVMOD_689 43, 1
+#define CPPUTILS_DIVMOD_690 43, 2
+#define CPPUTILS_DIVMOD_691 43, 3
+#define CPPUTILS_DIVMOD_692 43, 4
+#define CPPUTILS_DIVMOD_693 43, 5
+#define CPPUTILS_DIVMOD_694 43, 6
+#define CPPUTILS_DIVMOD_695 43, 7
+#define CPPUTILS_DIVMOD_696 43, 8
+#define CPPUTILS_DIVMOD_697 43, 9
+#define CPPUTILS_DIVMOD_698 43, 10
+#define CPPUTILS_DIVMOD_699 43, 11
+#define CPPUTILS_DIVMOD_700 43, 12
+#define CPPUTILS_DIVMOD_701 43, 13
+#define CPPUTILS_DIVMOD_702 43, 14
+#define CPPUTILS_DIVMOD_703 43, 15
+#define CPPUTILS_DIVMOD_704 43, 16
+#define CPPUTILS_DIVMOD_705 44, 1
+#define CPPUTILS_DIVMOD_706 44, 2
+#define CPPUTILS_DIVMOD_707 44, 3
+#define CPPUTILS_DIVMOD_708 44, 4
+#define CPPUTILS_DIVMOD_709 44, 5
+#define CPPUTILS_DIVMOD_710 44, 6
+#define CPPUTILS_DIVMOD_711 44, 7
+#define CPPUTILS_DIVMOD_712 44, 8
+#define CPPUTILS_DIVMOD_713 44, 9
+#define CPPUTILS_DIVMOD_714 44, 10
+#define CPPUTILS_DIVMOD_715 44, 11
+#define CPPUTILS_DIVMOD_716 44, 12
+#define CPPUTILS_DIVMOD_717 44, 13
+#define CPPUTILS_DIVMOD_718 44, 14
+#define CPPUTILS_DIVMOD_719 44, 15
+#define CPPUTILS_DIVMOD_720 44, 16
+#define CPPUTILS_DIVMOD_721 45, 1
+#define CPPUTILS_DIVMOD_722 45, 2
+#define CPPUTILS_DIVMOD_723 45, 3
+#define CPPUTILS_DIVMOD_724 45, 4
+#define CPPUTILS_DIVMOD_725 45, 5
+#define CPPUTILS_DIVMOD_726 45, 6
+#define CPPUTILS_DIVMOD_727 45, 7
+#define CPPUTILS_DIVMOD_728 45, 8
+#define CPPUTILS_DIVMOD_729 45, 9
+#define CPPUTILS_DIVMOD_730 45, 10
+#define CPPUTILS_DIVMOD_731 45, 11
+#define CPPUTILS_DIVMOD_732 45, 12
+#define CPPUTILS_DIVMOD_733 45, 13
+#define CPPUTILS_DIVMOD_734 45, 14
+#define CPPUTILS_DIVMOD_735 45, 15
+#define CPPUTILS_DIVMOD_736 45, 16
+#define CPPUTILS_DIVMOD_737 46, 1
+#define CPPUTILS_DIVMOD_738 46, 2
+#define CPPUTILS_DIVMOD_739 46, 3
+#define CPPUTILS_DIVMOD_740 46, 4
+#define CPPUTILS_DIVMOD_741 46, 5
+#define CPPUTILS_DIVMOD_742 46, 6
+#define CPPUTILS_DIVMOD_743 46, 7
+#define CPPUTILS_DIVMOD_744 46, 8
+#define CPPUTILS_DIVMOD_745 46, 9
+#define CPPUTILS_DIVMOD_746 46, 10
+#define CPPUTILS_DIVMOD_747 46, 11
+#define CPPUTILS_DIVMOD_748 46, 12
+#define CPPUTILS_DIVMOD_749 46, 13
+#define CPPUTILS_DIVMOD_750 46, 14
+#define CPPUTILS_DIVMOD_751 46, 15
+#define CPPUTILS_DIVMOD_752 46, 16
+#define CPPUTILS_DIVMOD_753 47, 1
+#define CPPUTILS_DIVMOD_754 47, 2
+#define CPPUTILS_DIVMOD_755 47, 3
+#define CPPUTILS_DIVMOD_756 47, 4
+#define CPPUTILS_DIVMOD_757 47, 5
+#define CPPUTILS_DIVMOD_758 47, 6
+#define CPPUTILS_DIVMOD_759 47, 7
+#define CPPUTILS_DIVMOD_760 47, 8
+#define CPPUTILS_DIVMOD_761 47, 9
+#define CPPUTILS_DIVMOD_762 47, 10
+#define CPPUTILS_DIVMOD_763 47, 11
+#define CPPUTILS_DIVMOD_764 47, 12
+#define CPPUTILS_DIVMOD_765 47, 13
+#define CPPUTILS_DIVMOD_766 47, 14
+#define CPPUTILS_DIVMOD_767 47, 15
+#define CPPUTILS_DIVMOD_768 47, 16
+#define CPPUTILS_DIVMOD_769 48, 1
+#define CPPUTILS_DIVMOD_770 48, 2
+#define CPPUTILS_DIVMOD_771 48, 3
+#define CPPUTILS_DIVMOD_772 48, 4
+#define CPPUTILS_DIVMOD_773 48, 5
+#define CPPUTILS_DIVMOD_774 48, 6
+#define CPPUTILS_DIVMOD_775 48, 7
+#define CPPUTILS_DIVMOD_776 48, 8
+#define CPPUTILS_DIVMOD_777 48, 9
+#define CPPUTILS_DIVMOD_778 48, 10
+#define CPPUTILS_DIVMOD_779 48, 11
+#define CPPUTILS_DIVMOD_780 48, 12
+#define CPPUTILS_DIVMOD_781 48, 13
+#define CPPUTILS_DIVMOD_782 48, 14
+#define CPPUTILS_DIVMOD_783 48, 15
+#define CPPUTILS_DIVMOD_784 48, 16
+#define CPPUTILS_DIVMOD_785 49, 1
+#define CPPUTILS_DIVMOD_786 49, 2
+#define CPPUTILS_DIVMOD_787 49, 3
+#define CPPUTILS_DIVMOD_788 49, 4
+#define CPPUTILS_DIVMOD_789 49, 5
+#define CPPUTILS_DIVMOD_790 49, 6
+#define CPPUTILS_DIVMOD_791 49, 7
+#define CPPUTILS_DIVMOD_792 49, 8
+#define CPPUTILS_DIVMOD_793 49, 9
+#define CPPUTILS_DIVMOD_794 49, 10
+#define CPPUTILS_DIVMOD_795 49, 11
+#define CPPUTILS_DIVMOD_796 49, 12
+#define CPPUTILS_DIVMOD_797 49, 13
+#define CPPUTILS_DIVMOD_798 49, 14
+#define CPPUTILS_DIVMOD_799 49, 15
+#define CPPUTILS_DIVMOD_800 49, 16
+#define CPPUTILS_DIVMOD_801 50, 1
+#define CPPUTILS_DIVMOD_802 50, 2
+#define CPPUTILS_DIVMOD_803 50, 3
+#define CPPUTILS_DIVMOD_804 50, 4
+#define CPPUTILS_DIVMOD_805 50, 5
+#define CPPUTILS_DIVMOD_806 50, 6
+#define CPPUTILS_DIVMOD_807 50, 7
+#define CPPUTILS_DIVMOD_808 50, 8
+#define CPPUTILS_DIVMOD_809 50, 9
+#define CPPUTILS_DIVMOD_810 50, 10
+#define CPPUTILS_DIVMOD_811 50, 11
+#define CPPUTILS_DIVMOD_812 50, 12
+#define CPPUTILS_DIVMOD_813 50, 13
+#define CPPUTILS_DIVMOD_814 50, 14
+#define CPPUTILS_DIVMOD_815 50, 15
+#define CPPUTILS_DIVMOD_816 50, 16
+#define CPPUTILS_DIVMOD_817 51, 1
+#define CPPUTILS_DIVMOD_818 51, 2
+#define CPPUTILS_DIVMOD_819 51, 3
+#define CPPUTILS_DIVMOD_820 51, 4
+#define CPPUTILS_DIVMOD_821 51, 5
+#define CPPUTILS_DIVMOD_822 51, 6
+#define CPPUTILS_DIVMOD_823 51, 7
+#define CPPUTILS_DIVMOD_824 51, 8
+#define CPPUTILS_DIVMOD_825 51, 9
+#define CPPUTILS_DIVMOD_826 51, 10
+#define CPPUTILS_DIVMOD_827 51, 11
+#define CPPUTILS_DIVMOD_828 51, 12
+#define CPPUTILS_DIVMOD_829 51, 13
+#define CPPUTILS_DIVMOD_830 51, 14
+#define CPPUTILS_DIVMOD_831 51, 15
+#define CPPUTILS_DIVMOD_832 51, 16
+#define CPPUTILS_DIVMOD_833 52, 1
+#define CPPUTILS_DIVMOD_834 52, 2
+#define CPPUTILS_DIVMOD_835 52, 3
+#define CPPUTILS_DIVMOD_836 52, 4
+#define CPPUTILS_DIVMOD_837 52, 5
+#define CPPUTILS_DIVMOD_838 52, 6
+#define CPPUTILS_DIVMOD_839 52, 7
+#define CPPUTILS_DIVMOD_840 52, 8
+#define CPPUTILS_DIVMOD_841 52, 9
+#define CPPUTILS_DIVMOD_842 52, 10
+#define CPPUTILS_DIVMOD_843 52, 11
+#define CPPUTILS_DIVMOD_844 52, 12
+#define CPPUTILS_DIVMOD_845 52, 13
+#define CPPUTILS_DIVMOD_846 52, 14
+#define CPPUTILS_DIVMOD_847 52, 15
+#define CPPUTILS_DIVMOD_848 52, 16
+#define CPPUTILS_DIVMOD_849 53, 1
+#define CPPUTILS_DIVMOD_850 53, 2
+#define CPPUTILS_DIVMOD_851 53, 3
+#define CPPUTILS_DIVMOD_852 53, 4
+#define CPPUTILS_DIVMOD_853 53, 5
+#define CPPUTILS_DIVMOD_854 53, 6
+#define CPPUTILS_DIVMOD_855 53, 7
+#define CPPUTILS_DIVMOD_856 53, 8
+#define CPPUTILS_DIVMOD_857 53, 9
+#define CPPUTILS_DIVMOD_858 53, 10
+#define CPPUTILS_DIVMOD_859 53, 11
+#define CPPUTILS_DIVMOD_860 53, 12
+#define CPPUTILS_DIVMOD_861 53, 13
+#define CPPUTILS_DIVMOD_862 53, 14
+#define CPPUTILS_DIVMOD_863 53, 15
+#define CPPUTILS_DIVMOD_864 53, 16
+#define CPPUTILS_DIVMOD_865 54, 1
+#define CPPUTILS_DIVMOD_866 54, 2
+#define CPPUTILS_DIVMOD_867 54, 3
+#define CPPUTILS_DIVMOD_868 54, 4
+#define CPPUTILS_DIVMOD_869 54, 5
+#define CPPUTILS_DIVMOD_870 54, 6
+#define CPPUTILS_DIVMOD_871 54, 7
+#define CPPUTILS_DIVMOD_872 54, 8
+#define CPPUTILS_DIVMOD_873 54, 9
+#define CPPUTILS_DIVMOD_874 54, 10
+#define CPPUTILS_DIVMOD_875 54, 11
+#define CPPUTILS_DIVMOD_876 54, 12
+#define CPPUTILS_DIVMOD_877 54, 13
+#define CPPUTILS_DIVMOD_878 54, 14
+#define CPPUTILS_DIVMOD_879 54, 15
+#define CPPUTILS_DIVMOD_880 54, 16
+#define CPPUTILS_DIVMOD_881 55, 1
+#define CPPUTILS_DIVMOD_882 55, 2
+#define CPPUTILS_DIVMOD_883 55, 3
+#define CPPUTILS_DIVMOD_884 55, 4
+#define CPPUTILS_DIVMOD_885 55, 5
+#define CPPUTILS_DIVMOD_886 55, 6
+#define CPPUTILS_DIVMOD_887 55, 7
+#define CPPUTILS_DIVMOD_888 55, 8
+#define CPPUTILS_DIVMOD_889 55, 9
+#define CPPUTILS_DIVMOD_890 55, 10
+#define CPPUTILS_DIVMOD_891 55, 11
+#define CPPUTILS_DIVMOD_892 55, 12
+#define CPPUTILS_DIVMOD_893 55, 13
+#define CPPUTILS_DIVMOD_894 55, 14
+#define CPPUTILS_DIVMOD_895 55, 15
+#define CPPUTILS_DIVMOD_896 55, 16
+#define CPPUTILS_DIVMOD_897 56, 1
+#define CPPUTILS_DIVMOD_898 56, 2
+#define CPPUTILS_DIVMOD_899 56, 3
+#define CPPUTILS_DIVMOD_900 56, 4
+#define CPPUTILS_DIVMOD_901 56, 5
+#define CPPUTILS_DIVMOD_902 56, 6
+#define CPPUTILS_DIVMOD_903 56, 7
+#define CPPUTILS_DIVMOD_904 56, 8
+#define CPPUTILS_DIVMOD_905 56, 9
+#define CPPUTILS_DIVMOD_906 56, 10
+#define CPPUTILS_DIVMOD_907 56, 11
+#define CPPUTILS_DIVMOD_908 56, 12
+#define CPPUTILS_DIVMOD_909 56, 13
+#define CPPUTILS_DIVMOD_910 56, 14
+#define CPPUTILS_DIVMOD_911 56, 15
+#define CPPUTILS_DIVMOD_912 56, 16
+#define CPPUTILS_DIVMOD_913 57, 1
+#define CPPUTILS_DIVMOD_914 57, 2
+#define CPPUTILS_DIVMOD_915 57, 3
+#define CPPUTILS_DIVMOD_916 57, 4
+#define CPPUTILS_DIVMOD_917 57, 5
+#define CPPUTILS_DIVMOD_918 57, 6
+#define CPPUTILS_DIVMOD_919 57, 7
+#define CPPUTILS_DIVMOD_920 57, 8
+#define CPPUTILS_DIVMOD_921 57, 9
+#define CPPUTILS_DIVMOD_922 57, 10
+#define CPPUTILS_DIVMOD_923 57, 11
+#define CPPUTILS_DIVMOD_924 57, 12
+#define CPPUTILS_DIVMOD_925 57, 13
+#define CPPUTILS_DIVMOD_926 57, 14
+#define CPPUTILS_DIVMOD_927 57, 15
+#define CPPUTILS_DIVMOD_928 57, 16
+#define CPPUTILS_DIVMOD_929 58, 1
+#define CPPUTILS_DIVMOD_930 58, 2
+#define CPPUTILS_DIVMOD_931 58, 3
+#define CPPUTILS_DIVMOD_932 58, 4
+#define CPPUTILS_DIVMOD_933 58, 5
+#define CPPUTILS_DIVMOD_934 58, 6
+#define CPPUTILS_DIVMOD_935 58, 7
+#define CPPUTILS_DIVMOD_936 58, 8
+#define CPPUTILS_DIVMOD_937 58, 9
+#define CPPUTILS_DIVMOD_938 58, 10
+#define CPPUTILS_DIVMOD_939 58, 11
+#define CPPUTILS_DIVMOD_940 58, 12
+#define CPPUTILS_DIVMOD_941 58, 13
+#define CPPUTILS_DIVMOD_942 58, 14
+#define CPPUTILS_DIVMOD_943 58, 15
+#define CPPUTILS_DIVMOD_944 58, 16
+#define CPPUTILS_DIVMOD_945 59, 1
+#define CPPUTILS_DIVMOD_946 59, 2
+#define CPPUTILS_DIVMOD_947 59, 3
+#define CPPUTILS_DIVMOD_948 59, 4
+#define CPPUTILS_DIVMOD_949 59, 5
+#define CPPUTILS_DIVMOD_950 59, 6
+#define CPPUTILS_DIVMOD_951 59, 7
+#define CPPUTILS_DIVMOD_952 59, 8
+#define CPPUTILS_DIVMOD_953 59, 9
+#define CPPUTILS_DIVMOD_954 59, 10
+#define CPPUTILS_DIVMOD_955 59, 11
+#define CPPUTILS_DIVMOD_956 59, 12
+#define CPPUTILS_DIVMOD_957 59, 13
+#define CPPUTILS_DIVMOD_958 59, 14
+#define CPPUTILS_DIVMOD_959 59, 15
+#define CPPUTILS_DIVMOD_960 59, 16
+#define CPPUTILS_DIVMOD_961 60, 1
+#define CPPUTILS_DIVMOD_962 60, 2
+#define CPPUTILS_DIVMOD_963 60, 3
+#define CPPUTILS_DIVMOD_964 60, 4
+#define CPPUTILS_DIVMOD_965 60, 5
+#define CPPUTILS_DIVMOD_966 60, 6
+#define CPPUTILS_DIVMOD_967 60, 7
+#define CPPUTILS_DIVMOD_968 60, 8
+#define CPPUTILS_DIVMOD_969 60, 9
+#define CPPUTILS_DIVMOD_970 60, 10
+#define CPPUTILS_DIVMOD_971 60, 11
+#define CPPUTILS_DIVMOD_972 60, 12
+#define CPPUTILS_DIVMOD_973 60, 13
+#define CPPUTILS_DIVMOD_974 60, 14
+#define CPPUTILS_DIVMOD_975 60, 15
+#define CPPUTILS_DIVMOD_976 60, 16
+#define CPPUTILS_DIVMOD_977 61, 1
+#define CPPUTILS_DIVMOD_978 61, 2
+#define CPPUTILS_DIVMOD_979 61, 3
+#define CPPUTILS_DIVMOD_980 61, 4
+#define CPPUTILS_DIVMOD_981 61, 5
+#define CPPUTILS_DIVMOD_982 61, 6
+#define CPPUTILS_DIVMOD_983 61, 7
+#define CPPUTILS_DIVMOD_984 61, 8
+#define CPPUTILS_DIVMOD_985 61, 9
+#define CPPUTILS_DIVMOD_986 61, 10
+#define CPPUTILS_DIVMOD_987 61, 11
+#define CPPUTILS_DIVMOD_988 61, 12
+#define CPPUTILS_DIVMOD_989 61, 13
+#define CPPUTILS_DIVMOD_990 61, 14
+#define CPPUTILS_DIVMOD_991 61, 15
+#define CPPUTILS_DIVMOD_992 61, 16
+#define CPPUTILS_DIVMOD_993 62, 1
+#define CPPUTILS_DIVMOD_994 62, 2
+#define CPPUTILS_DIVMOD_995 62, 3
+#define CPPUTILS_DIVMOD_996 62, 4
+#define CPPUTILS_DIVMOD_997 62, 5
+#define CPPUTILS_DIVMOD_998 62, 6
+#define CPPUTILS_DIVMOD_999 62, 7
+#define CPPUTILS_DIVMOD_1000 62, 8
+#define CPPUTILS_DIVMOD_1001 62, 9
+#define CPPUTILS_DIVMOD_1002 62, 10
+#define CPPUTILS_DIVMOD_1003 62, 11
+#define CPPUTILS_DIVMOD_1004 62, 12
+#define CPPUTILS_DIVMOD_1005 62, 13
+#define CPPUTILS_DIVMOD_1006 62, 14
+#define CPPUTILS_DIVMOD_1007 62, 15
+#define CPPUTILS_DIVMOD_1008 62, 16
+#define CPPUTILS_DIVMOD_1009 63, 1
+#define CPPUTILS_DIVMOD_1010 63, 2
+#define CPPUTILS_DIVMOD_1011 63, 3
+#define CPPUTILS_DIVMOD_1012 63, 4
+#define CPPUTILS_DIVMOD_1013 63, 5
+#define CPPUTILS_DIVMOD_1014 63, 6
+#define CPPUTILS_DIVMOD_1015 63, 7
+#define CPPUTILS_DIVMOD_1016 63, 8
+#define CPPUTILS_DIVMOD_1017 63, 9
+#define CPPUTILS_DIVMOD_1018 63, 10
+#define CPPUTILS_DIVMOD_1019 63, 11
+#define CPPUTILS_DIVMOD_1020 63, 12
+#define CPPUTILS_DIVMOD_1021 63, 13
+#define CPPUTILS_DIVMOD_1022 63, 14
+#define CPPUTILS_DIVMOD_1023 63, 15
+#define CPPUTILS_DIVMOD_1024 63, 16
+
+#define CPPUTILS_DROP_CHUNK(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12, _13, _14, _15, _16, ...) __VA_ARGS__
+
+#define CPPUTILS_0_MAP1(sep, m, _1) \
+        m(_1)
+#define CPPUTILS_0_MAP2(sep, m, _1, _2) \
+        m(_1) SEP_##sep m(_2)
+#define CPPUTILS_0_MAP3(sep, m, _1, _2, _3) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3)
+#define CPPUTILS_0_MAP4(sep, m, _1, _2, _3, _4) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4)
+#define CPPUTILS_0_MAP5(sep, m, _1, _2, _3, _4, _5) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5)
+#define CPPUTILS_0_MAP6(sep, m, _1, _2, _3, _4, _5, _6) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5) SEP_##sep m(_6)
+#define CPPUTILS_0_MAP7(sep, m, _1, _2, _3, _4, _5, _6, _7) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5) SEP_##sep m(_6) SEP_##sep m(_7)
+#define CPPUTILS_0_MAP8(sep, m, _1, _2, _3, _4, _5, _6, _7, _8) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5) SEP_##sep m(_6) SEP_##sep m(_7) SEP_##sep m(_8)
+#define CPPUTILS_0_MAP9(sep, m, _1, _2, _3, _4, _5, _6, _7, _8, _9) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5) SEP_##sep m(_6) SEP_##sep m(_7) SEP_##sep m(_8) SEP_##sep m(_9)
+#define CPPUTILS_0_MAP10(sep, m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5) SEP_##sep m(_6) SEP_##sep m(_7) SEP_##sep m(_8) SEP_##sep m(_9) SEP_##sep m(_10)
+#define CPPUTILS_0_MAP11(sep, m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5) SEP_##sep m(_6) SEP_##sep m(_7) SEP_##sep m(_8) SEP_##sep m(_9) SEP_##sep m(_10) SEP_##sep m(_11)
+#define CPPUTILS_0_MAP12(sep, m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5) SEP_##sep m(_6) SEP_##sep m(_7) SEP_##sep m(_8) SEP_##sep m(_9) SEP_##sep m(_10) SEP_##sep m(_11) SEP_##sep m(_12)
+#define CPPUTILS_0_MAP13(sep, m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12, _13) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5) SEP_##sep m(_6) SEP_##sep m(_7) SEP_##sep m(_8) SEP_##sep m(_9) SEP_##sep m(_10) SEP_##sep m(_11) SEP_##sep m(_12) SEP_##sep m(_13)
+#define CPPUTILS_0_MAP14(sep, m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12, _13, _14) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5) SEP_##sep m(_6) SEP_##sep m(_7) SEP_##sep m(_8) SEP_##sep m(_9) SEP_##sep m(_10) SEP_##sep m(_11) SEP_##sep m(_12) SEP_##sep m(_13) SEP_##sep m(_14)
+#define CPPUTILS_0_MAP15(sep, m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12, _13, _14, _15) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5) SEP_##sep m(_6) SEP_##sep m(_7) SEP_##sep m(_8) SEP_##sep m(_9) SEP_##sep m(_10) SEP_##sep m(_11) SEP_##sep m(_12) SEP_##sep m(_13) SEP_##sep m(_14) SEP_##sep m(_15)
+#define CPPUTILS_0_MAP16(sep, m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12, _13, _14, _15, _16) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5) SEP_##sep m(_6) SEP_##sep m(_7) SEP_##sep m(_8) SEP_##sep m(_9) SEP_##sep m(_10) SEP_##sep m(_11) SEP_##sep m(_12) SEP_##sep m(_13) SEP_##sep m(_14) SEP_##sep m(_15) SEP_##sep m(_16)
+
+#define CPPUTILS_0_MAP_CHUNK(sep, m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12, _13, _14, _15, _16, ...) \
+        m(_1) SEP_##sep m(_2) SEP_##sep m(_3) SEP_##sep m(_4) SEP_##sep m(_5) SEP_##sep m(_6) SEP_##sep m(_7) SEP_##sep m(_8) SEP_##sep m(_9) SEP_##sep m(_10) SEP_##sep m(_11) SEP_##sep m(_12) SEP_##sep m(_13) SEP_##sep m(_14) SEP_##sep m(_15) SEP_##sep m(_16)
+
+#define CPPUTILS_0_MAPQ0(r, sep, m, ...) CPPUTILS_0_MAP_R(r, sep, m, __VA_ARGS__)
+#define CPPUTILS_0_MAPQ1(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ0(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ2(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ1(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ3(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ2(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ4(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ3(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ5(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ4(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ6(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ5(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ7(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ6(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ8(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ7(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ9(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ8(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ10(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ9(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ11(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ10(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ12(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ11(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ13(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ12(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ14(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ13(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ15(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ14(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ16(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ15(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ17(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ16(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ18(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ17(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ19(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ18(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ20(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ19(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ21(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ20(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ22(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ21(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ23(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ22(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ24(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ23(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ25(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ24(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ26(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ25(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ27(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ26(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ28(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ27(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ29(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ28(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ30(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ29(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ31(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ30(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ32(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ31(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ33(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ32(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ34(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ33(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ35(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ34(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ36(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ35(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ37(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ36(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ38(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ37(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ39(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ38(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ40(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ39(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ41(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ40(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ42(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ41(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ43(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ42(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ44(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ43(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ45(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ44(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ46(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ45(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ47(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ46(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ48(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ47(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ49(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ48(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ50(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ49(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ51(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ50(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ52(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ51(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ53(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ52(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ54(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ53(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ55(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ54(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ56(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ55(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ57(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ56(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ58(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ57(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ59(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ58(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ60(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ59(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ61(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ60(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ62(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ61(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAPQ63(r, sep, m, ...) CPPUTILS_0_MAP_CHUNK(sep, m, __VA_ARGS__) SEP_##sep CPPUTILS_0_MAPQ62(r, sep, m, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_0_MAP_R(r, sep, m, ...) CPPUTILS_0_MAP##r(sep, m, __VA_ARGS__)
+
+#define CPPUTILS_0_MAP(n, sep, m, ...) CPPUTILS_0_MAP_QR(CPPUTILS_DIVMOD_##n, sep, m, __VA_ARGS__)
+#define CPPUTILS_0_MAP_QR(qr, ...) CPPUTILS_0_MAP_QR_(qr, __VA_ARGS__)
+#define CPPUTILS_0_MAP_QR_(q, r, sep, m, ...) CPPUTILS_0_MAPQ##q(r, sep, m, __VA_ARGS__)
+
+#define CPPUTILS_1_MAP1(sep, m, a, _1) \
+        m(a, _1)
+#define CPPUTILS_1_MAP2(sep, m, a, _1, _2) \
+        m(a, _1) SEP_##sep m(a, _2)
+#define CPPUTILS_1_MAP3(sep, m, a, _1, _2, _3) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3)
+#define CPPUTILS_1_MAP4(sep, m, a, _1, _2, _3, _4) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4)
+#define CPPUTILS_1_MAP5(sep, m, a, _1, _2, _3, _4, _5) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5)
+#define CPPUTILS_1_MAP6(sep, m, a, _1, _2, _3, _4, _5, _6) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5) SEP_##sep m(a, _6)
+#define CPPUTILS_1_MAP7(sep, m, a, _1, _2, _3, _4, _5, _6, _7) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5) SEP_##sep m(a, _6) SEP_##sep m(a, _7)
+#define CPPUTILS_1_MAP8(sep, m, a, _1, _2, _3, _4, _5, _6, _7, _8) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5) SEP_##sep m(a, _6) SEP_##sep m(a, _7) SEP_##sep m(a, _8)
+#define CPPUTILS_1_MAP9(sep, m, a, _1, _2, _3, _4, _5, _6, _7, _8, _9) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5) SEP_##sep m(a, _6) SEP_##sep m(a, _7) SEP_##sep m(a, _8) SEP_##sep m(a, _9)
+#define CPPUTILS_1_MAP10(sep, m, a, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5) SEP_##sep m(a, _6) SEP_##sep m(a, _7) SEP_##sep m(a, _8) SEP_##sep m(a, _9) SEP_##sep m(a, _10)
+#define CPPUTILS_1_MAP11(sep, m, a, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5) SEP_##sep m(a, _6) SEP_##sep m(a, _7) SEP_##sep m(a, _8) SEP_##sep m(a, _9) SEP_##sep m(a, _10) SEP_##sep m(a, _11)
+#define CPPUTILS_1_MAP12(sep, m, a, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5) SEP_##sep m(a, _6) SEP_##sep m(a, _7) SEP_##sep m(a, _8) SEP_##sep m(a, _9) SEP_##sep m(a, _10) SEP_##sep m(a, _11) SEP_##sep m(a, _12)
+#define CPPUTILS_1_MAP13(sep, m, a, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12, _13) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5) SEP_##sep m(a, _6) SEP_##sep m(a, _7) SEP_##sep m(a, _8) SEP_##sep m(a, _9) SEP_##sep m(a, _10) SEP_##sep m(a, _11) SEP_##sep m(a, _12) SEP_##sep m(a, _13)
+#define CPPUTILS_1_MAP14(sep, m, a, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12, _13, _14) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5) SEP_##sep m(a, _6) SEP_##sep m(a, _7) SEP_##sep m(a, _8) SEP_##sep m(a, _9) SEP_##sep m(a, _10) SEP_##sep m(a, _11) SEP_##sep m(a, _12) SEP_##sep m(a, _13) SEP_##sep m(a, _14)
+#define CPPUTILS_1_MAP15(sep, m, a, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12, _13, _14, _15) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5) SEP_##sep m(a, _6) SEP_##sep m(a, _7) SEP_##sep m(a, _8) SEP_##sep m(a, _9) SEP_##sep m(a, _10) SEP_##sep m(a, _11) SEP_##sep m(a, _12) SEP_##sep m(a, _13) SEP_##sep m(a, _14) SEP_##sep m(a, _15)
+#define CPPUTILS_1_MAP16(sep, m, a, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12, _13, _14, _15, _16) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5) SEP_##sep m(a, _6) SEP_##sep m(a, _7) SEP_##sep m(a, _8) SEP_##sep m(a, _9) SEP_##sep m(a, _10) SEP_##sep m(a, _11) SEP_##sep m(a, _12) SEP_##sep m(a, _13) SEP_##sep m(a, _14) SEP_##sep m(a, _15) SEP_##sep m(a, _16)
+
+#define CPPUTILS_1_MAP_CHUNK(sep, m, a, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, \
+        _11, _12, _13, _14, _15, _16, ...) \
+        m(a, _1) SEP_##sep m(a, _2) SEP_##sep m(a, _3) SEP_##sep m(a, _4) SEP_##sep m(a, _5) SEP_##sep m(a, _6) SEP_##sep m(a, _7) SEP_##sep m(a, _8) SEP_##sep m(a, _9) SEP_##sep m(a, _10) SEP_##sep m(a, _11) SEP_##sep m(a, _12) SEP_##sep m(a, _13) SEP_##sep m(a, _14) SEP_##sep m(a, _15) SEP_##sep m(a, _16)
+
+#define CPPUTILS_1_MAPQ0(r, sep, m, a, ...) CPPUTILS_1_MAP_R(r, sep, m, a, __VA_ARGS__)
+#define CPPUTILS_1_MAPQ1(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ0(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ2(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ1(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ3(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ2(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ4(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ3(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ5(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ4(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ6(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ5(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ7(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ6(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ8(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ7(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ9(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ8(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ10(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ9(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ11(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ10(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ12(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ11(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ13(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ12(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ14(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ13(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ15(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ14(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ16(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ15(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ17(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ16(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ18(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ17(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ19(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ18(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ20(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ19(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ21(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ20(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ22(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ21(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ23(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ22(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ24(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ23(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ25(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ24(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ26(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ25(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ27(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ26(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ28(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ27(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ29(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ28(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ30(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ29(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ31(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ30(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ32(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ31(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ33(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ32(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ34(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ33(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ35(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ34(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ36(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ35(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ37(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ36(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ38(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ37(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ39(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ38(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ40(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ39(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ41(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ40(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ42(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ41(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ43(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ42(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ44(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ43(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ45(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ44(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ46(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ45(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ47(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ46(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ48(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ47(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ49(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ48(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ50(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ49(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ51(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ50(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ52(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ51(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ53(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ52(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ54(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ53(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ55(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ54(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ56(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ55(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ57(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ56(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ58(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ57(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ59(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ58(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ60(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ59(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ61(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ60(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ62(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ61(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAPQ63(r, sep, m, a, ...) CPPUTILS_1_MAP_CHUNK(sep, m, a, __VA_ARGS__) SEP_##sep CPPUTILS_1_MAPQ62(r, sep, m, a, CPPUTILS_DROP_CHUNK(__VA_ARGS__))
+#define CPPUTILS_1_MAP_R(r, sep, m, a, ...) CPPUTILS_1_MAP##r(sep, m, a, __VA_ARGS__)
+
+#define CPPUTILS_1_MAP(n, sep, m, a, ...) CPPUTILS_1_MAP_QR(CPPUTILS_DIVMOD_##n, sep, m, a, __VA_ARGS__)
+#define CPPUTILS_1_MAP_QR(qr, ...) CPPUTILS_1_MAP_QR_(qr, __VA_ARGS__)
+#define CPPUTILS_1_MAP_QR_(q, r, sep, m, a, ...) CPPUTILS_1_MAPQ##q(r, sep, m, a, __VA_ARGS__)
 
 // Need to defer the map call one level to let CPPUTILS_NARGS evaluate
 #define CPPUTILS_DECORATED_0_MAP(sep, decorator,    ...) CPPUTILS_DECORATED_0_MAP_DEFER(CPPUTILS_NARGS(__VA_ARGS__), sep, decorator,    __VA_ARGS__)
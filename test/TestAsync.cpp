@@ -0,0 +1,152 @@
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#include "CppUtils/async/AsyncIO.h"
+#include "CppUtils/async/Reactor.h"
+#include "CppUtils/async/Task.h"
+#include "CppUtils/io/PipeHandle.h"
+#include "CppUtils/networking/Socket.h"
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+Task<int64_t> add(int64_t a, int64_t b) {
+    co_return a + b;
+}
+
+Task<int64_t> sum_to(int n) {
+    int64_t total = 0;
+    for (int i = 1; i <= n; i++) {
+        total = co_await add(total, i);
+    }
+    co_return total;
+}
+
+Task<void> fail() {
+    throw std::runtime_error("failed");
+    co_return;
+}
+
+}
+
+TEST_CASE("Coroutine Tasks") {
+    Reactor reactor;
+    // Deep chains resume by symmetric transfer, without growing the stack
+    REQUIRE(reactor.run(sum_to(100000)) == int64_t{100000} * 100001 / 2);
+    REQUIRE_THROWS_AS(reactor.run(fail()), std::runtime_error);
+    REQUIRE(reactor.active_tasks() == 0);
+}
+
+TEST_CASE("Async Sockets") {
+    // Clients connect blocking, so stay within the listen backlog
+    constexpr int n_clients = 5;
+    constexpr int n_messages = 200;
+
+    Reactor reactor;
+    SocketHandle server;
+    server.listen(0);
+    const int port = server.local_port();
+    REQUIRE_THROWS_AS(reactor.run([] (Reactor& reactor, SocketHandle& server) -> Task<void> {
+        SocketHandle client;
+        co_await async_accept(reactor, server, client);
+    }(reactor, server)), std::runtime_error);
+    set_nonblocking(server.fd());
+
+    // Echo server: one session per connection, all on this thread
+    reactor.spawn([] (Reactor& reactor, SocketHandle& server, int n_clients) -> Task<void> {
+        for (int i = 0; i < n_clients; i++) {
+            auto connection = std::make_unique<SocketHandle>();
+            co_await async_accept(reactor, server, *connection);
+            reactor.spawn([] (Reactor& reactor, std::unique_ptr<SocketHandle> connection) -> Task<void> {
+                AsyncStream stream(reactor, *connection);
+                uint32_t x;
+                for (int j = 0; j < n_messages; j++) {
+                    co_await stream.read(x);
+                    co_await stream.write<uint32_t>(x * 2);
+                }
+            }(reactor, std::move(connection)));
+        }
+    }(reactor, server, n_clients));
+
+    int correct = 0;
+    for (int i = 0; i < n_clients; i++) {
+        reactor.spawn([] (Reactor& reactor, int port, int id, int& correct) -> Task<void> {
+            SocketHandle socket;
+            socket.connect("127.0.0.1", port);
+            AsyncStream stream(reactor, socket);
+            for (int j = 0; j < n_messages; j++) {
+                const uint32_t x = static_cast<uint32_t>(id * 1000 + j);
+                co_await stream.write(x);
+                uint32_t y;
+                co_await stream.read(y);
+                correct += y == 2 * x;
+            }
+        }(reactor, port, i, correct));
+    }
+
+    reactor.run();
+    REQUIRE(correct == n_clients * n_messages);
+    REQUIRE(reactor.active_tasks() == 0);
+
+    // Writing to a closed peer throws rather than killing the process
+    reactor.spawn([] (Reactor& reactor, SocketHandle& server, int port) -> Task<void> {
+        SocketHandle socket;
+        socket.connect("127.0.0.1", port);
+        SocketHandle peer;
+        co_await async_accept(reactor, server, peer);
+        peer.close();
+        AsyncStream stream(reactor, socket);
+        std::vector<uint8_t> block(1 << 16);
+        for (int i = 0; i < 100; i++) {
+            co_await stream.write(block.data(), block.size());
+        }
+    }(reactor, server, port));
+    REQUIRE_THROWS_AS(reactor.run(), std::runtime_error);
+}
+
+TEST_CASE("Async Pipes") {
+    const std::string path = "/tmp/cpputils_test_async_pipe_" + std::to_string(getpid());
+    ::unlink(path.c_str());
+
+    InputPipeHandle input(path);
+    OutputPipeHandle output(path);
+    REQUIRE(output.good());
+
+    // Far more than the pipe holds, so both sides suspend on each other
+    std::vector<uint64_t> values(200000);
+    for (size_t i = 0; i < values.size(); i++) values[i] = i * 3;
+    std::vector<uint64_t> received(values.size());
+
+    Reactor reactor;
+    reactor.spawn([] (Reactor& reactor, OutputPipeHandle& output, const std::vector<uint64_t>& values) -> Task<void> {
+        AsyncStream stream(reactor, output);
+        for (size_t i = 0; i < values.size(); i += 1000) {
+            co_await stream.write(values.data() + i, 1000);
+        }
+        output.close();
+    }(reactor, output, values));
+
+    size_t total = 0;
+    reactor.spawn([] (Reactor& reactor, InputPipeHandle& input, std::vector<uint64_t>& received,
+                      size_t& total) -> Task<void> {
+        AsyncStream stream(reactor, input);
+        uint8_t* buffer = reinterpret_cast<uint8_t*>(received.data());
+        const size_t size = received.size() * sizeof(uint64_t);
+        while (size_t n = co_await stream.var_read(buffer + total, size - total)) {
+            total += n;
+        }
+    }(reactor, input, received, total));
+
+    reactor.run();
+    REQUIRE(total == values.size() * sizeof(uint64_t));
+    REQUIRE(received == values);
+    ::unlink(path.c_str());
+}
@@ -3,6 +3,7 @@
 #include <catch2/catch.hpp>
 
 #include "CppUtils/c_util/CUtil.h"
+#include "CppUtils/c_util/Crc32.h"
 
 #include <iostream>
 
@@ -36,3 +37,21 @@ TEST_CASE("Narrowing check") {
     z = 0b1111'0000'0000'0000;
     REQUIRE(!narrowed_type_fits<12>(z));
 }
+
+TEST_CASE("CRC32") {
+    const char* check = "123456789";
+    REQUIRE(crc32(reinterpret_cast<const uint8_t*>(check), 9) == 0xcbf43926u);
+    REQUIRE(crc32(nullptr, 0) == 0);
+
+    // Split at every point, across the 8 byte fast path
+    uint8_t data[100];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<uint8_t>(i * 37);
+    }
+    const uint32_t whole = crc32(data, sizeof(data));
+    bool matches = true;
+    for (size_t split = 0; split <= sizeof(data); split++) {
+        matches = matches && crc32(data + split, sizeof(data) - split, crc32(data, split)) == whole;
+    }
+    REQUIRE(matches);
+}
@@ -0,0 +1,71 @@
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#include "CppUtils/concurrency/ThreadPool.h"
+#include "CppUtils/container/SpscRingBuffer.h"
+#include "CppUtils/io/RingBufferHandle.h"
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Thread Pool") {
+    ThreadPool pool(4, 8);
+    REQUIRE(pool.size() == 4);
+    REQUIRE(!pool.in_pool());
+
+    std::future<int> sum = pool.submit([] (int a, int b) { return a + b; }, 2, 3);
+    REQUIRE(sum.get() == 5);
+
+    std::future<void> failing = pool.submit([] { throw std::runtime_error("failed"); });
+    REQUIRE_THROWS_AS(failing.get(), std::runtime_error);
+
+    // More tasks than the injection queue holds
+    std::vector<std::future<size_t> > results;
+    for (size_t i = 0; i < 100; i++) {
+        results.push_back(pool.submit([i] { return i * i; }));
+    }
+    size_t total = 0;
+    for (std::future<size_t>& result : results) {
+        total += result.get();
+    }
+    REQUIRE(total == 328350);
+}
+
+TEST_CASE("Thread Pool Nested Tasks") {
+    std::atomic<int> count{0};
+    std::atomic<bool> in_pool{true};
+    {
+        ThreadPool pool(3);
+        for (int i = 0; i < 10; i++) {
+            pool.post([&pool, &count, &in_pool] {
+                in_pool = in_pool && pool.in_pool();
+                for (int j = 0; j < 10; j++) {
+                    pool.post([&count] { count++; });
+                }
+            });
+        }
+        // The destructor drains every posted task
+    }
+    REQUIRE(in_pool.load());
+    REQUIRE(count.load() == 100);
+}
+
+TEST_CASE("Thread Pool I/O") {
+    ThreadPool pool(2);
+    SpscRingBuffer<uint8_t> ring(64);
+    RingBufferWriter writer(ring);
+    RingBufferReader reader(ring);
+
+    std::vector<int32_t> out(1000);
+    std::iota(out.begin(), out.end(), 0);
+    std::vector<int32_t> in(out.size());
+
+    std::future<void> read = submit_read(pool, reader, in.data(), in.size());
+    std::future<void> write = submit_write(pool, writer, out.data(), out.size());
+    write.get();
+    read.get();
+    REQUIRE(in == out);
+}
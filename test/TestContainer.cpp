@@ -0,0 +1,440 @@
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#include "CppUtils/container/ArrayView.h"
+#include "CppUtils/container/BufferPool.h"
+#include "CppUtils/container/FlatHashMap.h"
+#include "CppUtils/container/MpmcQueue.h"
+#include "CppUtils/container/SmallVector.h"
+#include "CppUtils/container/Span.h"
+#include "CppUtils/container/SpscRingBuffer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <thread>
+#include <vector>
+
+template <typename T>
+size_t total(Span<const T> xs) {
+    size_t sum = 0;
+    for (const T& x : xs) sum += x;
+    return sum;
+}
+
+TEST_CASE("Span") {
+    std::vector<int> vec = {1, 2, 3, 4, 5, 6};
+    std::array<int, 3> arr = {7, 8, 9};
+    int raw[2] = {10, 11};
+    ArrayView<int, 3> view(arr);
+
+    REQUIRE(total<int>(vec) == 21);
+    REQUIRE(total<int>(arr) == 24);
+    REQUIRE(total<int>(raw) == 21);
+    REQUIRE(total<int>(view) == 24);
+
+    Span<int> span(vec);
+    REQUIRE(span.size() == 6);
+    REQUIRE(span.size_bytes() == 6 * sizeof(int));
+
+    Span<int> middle = span.subspan(2, 3);
+    REQUIRE(middle.size() == 3);
+    REQUIRE(middle[0] == 3);
+    REQUIRE(middle.back() == 5);
+    middle[1] = 40;
+    REQUIRE(vec[3] == 40);
+
+    REQUIRE(span.subspan(4).size() == 2);
+    REQUIRE(span.first(2).back() == 2);
+    REQUIRE(span.last(2).front() == 5);
+    REQUIRE(span.subspan(6).empty());
+    REQUIRE_THROWS(span.subspan(7));
+    REQUIRE_THROWS(span.subspan(2, 5));
+    REQUIRE_THROWS(span.last(7));
+
+    ArrayView<int, 2> fixed = span.first<2>();
+    REQUIRE(fixed[1] == 2);
+
+    Span<const int> const_span = span;
+    REQUIRE(const_span.data() == vec.data());
+    REQUIRE(as_bytes(const_span).size() == 6 * sizeof(int));
+}
+
+TEST_CASE("SPSC Ring Buffer") {
+    SpscRingBuffer<int> ring(6);
+    REQUIRE(ring.capacity() == 8);
+    REQUIRE(ring.empty());
+
+    int xs[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    REQUIRE(ring.push(xs, 10) == 8);
+    REQUIRE(!ring.try_push(10));
+
+    int ys[5] = {};
+    REQUIRE(ring.pop(ys, 5) == 5);
+    REQUIRE(ys[4] == 4);
+    REQUIRE(ring.size() == 3);
+
+    // Wraps around the end of the storage
+    Span<int> region = ring.reserve_write();
+    REQUIRE(region.size() == 5);
+    region[0] = 100;
+    ring.commit_write(1);
+    REQUIRE(ring.push(xs, 4) == 4);
+    REQUIRE(ring.size() == 8);
+
+    Span<const int> readable = ring.reserve_read();
+    REQUIRE(readable.size() == 3);
+    REQUIRE(readable[0] == 5);
+    ring.commit_read(3);
+    readable = ring.reserve_read();
+    REQUIRE(readable.size() == 5);
+    REQUIRE(readable[0] == 100);
+    REQUIRE(readable[4] == 3);
+}
+
+TEST_CASE("SPSC Ring Buffer Threads") {
+    constexpr uint32_t count = 200000;
+    SpscRingBuffer<uint32_t> ring(64);
+
+    std::thread producer([&ring] {
+        uint32_t batch[7];
+        uint32_t next = 0;
+        while (next < count) {
+            uint32_t n = 0;
+            while (n < 7 && next + n < count) {
+                batch[n] = next + n;
+                n++;
+            }
+            next += static_cast<uint32_t>(ring.push(batch, n));
+        }
+        ring.close();
+    });
+
+    uint32_t expected = 0;
+    bool ordered = true;
+    while (true) {
+        bool closed = ring.closed();
+        uint32_t x;
+        if (ring.try_pop(x)) {
+            ordered = ordered && (x == expected);
+            expected++;
+        } else if (closed) {
+            break;
+        }
+    }
+    producer.join();
+
+    REQUIRE(ordered);
+    REQUIRE(expected == count);
+}
+
+TEST_CASE("MPMC Queue") {
+    MpmcQueue<std::unique_ptr<int> > queue(3);
+    REQUIRE(queue.capacity() == 4);
+
+    for (int i = 0; i < 4; i++) {
+        REQUIRE(queue.try_push(std::make_unique<int>(i)));
+    }
+    auto extra = std::make_unique<int>(4);
+    REQUIRE(!queue.try_push(std::move(extra)));
+    REQUIRE(extra != nullptr);
+
+    std::unique_ptr<int> x;
+    REQUIRE(queue.try_pop(x));
+    REQUIRE(*x == 0);
+    REQUIRE(queue.try_emplace(new int(5)));
+    REQUIRE(queue.size() == 4);
+
+    // Left over elements are destroyed without default constructing a T
+    struct Counted {
+        explicit Counted(int& live) : live_(&live) { live++; }
+        Counted(Counted&& other) : live_(other.live_) { (*live_)++; }
+        Counted& operator=(Counted&&) = default;
+        ~Counted() { (*live_)--; }
+        int* live_;
+    };
+    int live = 0;
+    {
+        MpmcQueue<Counted> counted(4);
+        REQUIRE(counted.try_emplace(live));
+        REQUIRE(counted.try_emplace(live));
+        REQUIRE(live == 2);
+    }
+    REQUIRE(live == 0);
+}
+
+TEST_CASE("MPMC Queue Threads") {
+    constexpr uint64_t per_producer = 50000;
+    constexpr size_t n_producers = 3;
+    constexpr size_t n_consumers = 3;
+    MpmcQueue<uint64_t> queue(64);
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < n_producers; p++) {
+        threads.emplace_back([&queue, p] {
+            for (uint64_t i = 1; i <= per_producer; i++) {
+                while (!queue.try_push(p * per_producer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> popped{0};
+    for (size_t c = 0; c < n_consumers; c++) {
+        threads.emplace_back([&] {
+            uint64_t x;
+            while (popped.load() < n_producers * per_producer) {
+                if (queue.try_pop(x)) {
+                    sum += x;
+                    popped++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    constexpr uint64_t n = n_producers * per_producer;
+    REQUIRE(popped.load() == n);
+    REQUIRE(sum.load() == n * (n + 1) / 2);
+}
+
+TEST_CASE("Buffer Pool") {
+    BufferPool pool(100, 4);
+    REQUIRE(pool.slab_count() == 0);
+
+    std::set<uint8_t*> seen;
+    {
+        std::vector<PooledBuffer> buffers;
+        for (size_t i = 0; i < 5; i++) {
+            buffers.push_back(pool.acquire());
+            PooledBuffer& buffer = buffers.back();
+            REQUIRE(buffer.size() == 100);
+            REQUIRE(reinterpret_cast<uintptr_t>(buffer.data()) % layout::cache_line_size == 0);
+            seen.insert(buffer.data());
+        }
+        REQUIRE(seen.size() == 5);
+        REQUIRE(pool.slab_count() == 2);
+
+        buffers[0].resize(10);
+        REQUIRE(buffers[0].span().size() == 10);
+        REQUIRE_THROWS_AS(buffers[0].resize(101), std::length_error);
+    }
+
+    // Freed buffers are reused before growing
+    for (size_t i = 0; i < 8; i++) {
+        PooledBuffer buffer = pool.acquire();
+        REQUIRE(pool.slab_count() == 2);
+    }
+
+    BufferPool huge(4096, 16, true);
+    PooledBuffer buffer = huge.acquire();
+    buffer[4095] = 1;
+    REQUIRE(huge.buffer_count() >= 16);
+}
+
+TEST_CASE("Buffer Pool Threads") {
+    BufferPool pool(64, 8);
+    std::vector<std::thread> threads;
+    std::atomic<bool> intact{true};
+    for (uint8_t t = 0; t < 4; t++) {
+        threads.emplace_back([&pool, &intact, t] {
+            for (int i = 0; i < 10000; i++) {
+                PooledBuffer a = pool.acquire();
+                PooledBuffer b = pool.acquire();
+                std::fill(a.begin(), a.end(), t);
+                std::fill(b.begin(), b.end(), t);
+                std::this_thread::yield();
+                bool ok = std::all_of(a.begin(), a.end(), [t] (uint8_t x) { return x == t; })
+                       && std::all_of(b.begin(), b.end(), [t] (uint8_t x) { return x == t; });
+                if (!ok)
+                    intact = false;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(intact.load());
+}
+
+TEST_CASE("Monotonic Arena") {
+    MonotonicArena arena(128);
+
+    std::string_view a = arena.copy("hello");
+    Span<uint64_t> words = arena.allocate<uint64_t>(4);
+    REQUIRE(reinterpret_cast<uintptr_t>(words.data()) % alignof(uint64_t) == 0);
+    words[3] = 7;
+    REQUIRE(a == "hello");
+    REQUIRE(arena.capacity() == 128);
+
+    // Larger than a chunk
+    Span<uint8_t> big = arena.allocate<uint8_t>(1000);
+    big[999] = 1;
+    REQUIRE(arena.capacity() == 128 + 1000);
+
+    arena.reset();
+    arena.allocate<uint8_t>(100);
+    arena.allocate<uint8_t>(500);
+    REQUIRE(arena.capacity() == 128 + 1000);
+
+    arena.release();
+    REQUIRE(arena.capacity() == 0);
+}
+
+TEST_CASE("Small Vector") {
+    SmallVector<int, 4> xs = {1, 2, 3};
+    REQUIRE(xs.is_inline());
+    REQUIRE(total<int>(xs) == 6);
+
+    xs.push_back(4);
+    REQUIRE(xs.is_inline());
+    xs.push_back(xs[0]);
+    REQUIRE(!xs.is_inline());
+    REQUIRE(xs.size() == 5);
+    REQUIRE(xs.back() == 1);
+
+    const int more[3] = {6, 7, 8};
+    xs.append(Span<const int>(more));
+    REQUIRE(xs.size() == 8);
+    REQUIRE(xs.span().first<2>()[1] == 2);
+
+    xs.erase(xs.begin() + 1, xs.begin() + 7);
+    REQUIRE(xs == SmallVector<int, 4>({1, 8}));
+    xs.shrink_to_fit();
+    REQUIRE(xs.is_inline());
+
+    xs.resize(6, 9);
+    const int* heap = xs.data();
+    SmallVector<int, 4> moved(std::move(xs));
+    REQUIRE(moved.data() == heap);
+    REQUIRE(xs.empty());
+    REQUIRE(xs.is_inline());
+
+    REQUIRE_THROWS_AS(moved.at(6), std::out_of_range);
+}
+
+TEST_CASE("Small Vector Non-Trivial") {
+    SmallVector<std::string, 2> inline_strings;
+    inline_strings.emplace_back(40, 'a');
+    inline_strings.emplace_back("b");
+
+    SmallVector<std::string, 2> moved = std::move(inline_strings);
+    REQUIRE(moved.size() == 2);
+    REQUIRE(moved[0] == std::string(40, 'a'));
+
+    moved.emplace_back("c");
+    SmallVector<std::string, 2> copied = moved;
+    REQUIRE(copied == moved);
+    copied.pop_back();
+    copied.resize(1);
+    REQUIRE(copied.size() == 1);
+
+    moved = copied;
+    REQUIRE(moved.size() == 1);
+
+    static_assert(std::is_nothrow_move_constructible_v<SmallVector<int, 4>>);
+    static_assert(std::is_nothrow_move_assignable_v<SmallVector<std::string, 2>>);
+
+    // A vector of SmallVectors moves them on reallocation, keeping heap storage
+    std::vector<SmallVector<int, 2>> vectors(1);
+    vectors[0] = {1, 2, 3};
+    const int* heap = vectors[0].data();
+    vectors.resize(vectors.capacity() + 1);
+    REQUIRE(vectors[0].data() == heap);
+}
+
+TEST_CASE("Small Vector Throwing Move") {
+    struct Throwing {
+        int value;
+        explicit Throwing(int value) : value(value) {}
+        Throwing(Throwing&& other) : value(other.value) {
+            if (value == 2)
+                throw std::runtime_error("move failed");
+        }
+    };
+
+    static_assert(!std::is_nothrow_move_constructible_v<SmallVector<Throwing, 2>>);
+
+    SmallVector<Throwing, 4> xs;
+    xs.emplace_back(1);
+    xs.emplace_back(2);
+    REQUIRE_THROWS_AS(xs.reserve(8), std::runtime_error);
+    REQUIRE(xs.is_inline());
+    REQUIRE(xs.size() == 2);
+    REQUIRE(xs[1].value == 2);
+}
+
+TEST_CASE("Flat Hash Map") {
+    FlatHashMap<int, std::string> fds;
+    REQUIRE(fds.find(3) == fds.end());
+
+    fds[3] = "socket";
+    REQUIRE(fds.try_emplace(4, "pipe").second);
+    REQUIRE(!fds.try_emplace(4, "other").second);
+    fds.insert_or_assign(3, "listener");
+    REQUIRE(fds.size() == 2);
+    REQUIRE(fds.at(3) == "listener");
+    REQUIRE_THROWS_AS(fds.at(5), std::out_of_range);
+
+    // Grows past the first group, against a reference map
+    std::unordered_map<int, std::string> reference;
+    for (int i = 0; i < 1000; i++) {
+        fds.insert_or_assign(i, std::to_string(i));
+        reference[i] = std::to_string(i);
+        if (i % 3 == 0) {
+            fds.erase(i / 2);
+            reference.erase(i / 2);
+        }
+    }
+    REQUIRE(fds.size() == reference.size());
+    size_t visited = 0;
+    for (const auto& [fd, name] : fds) {
+        REQUIRE(reference.at(fd) == name);
+        visited++;
+    }
+    REQUIRE(visited == reference.size());
+
+    FlatHashMap<int, std::string> copy = fds;
+    fds.clear();
+    REQUIRE(fds.empty());
+    REQUIRE(copy.size() == reference.size());
+    REQUIRE(copy.at(999) == "999");
+}
+
+TEST_CASE("Flat Hash Map Fixed Capacity") {
+    using Address = std::pair<uint8_t, uint8_t>;
+    FlatHashMap<Address, int> devices(20, true);
+    const size_t slots = devices.bucket_count();
+    const size_t max_load = devices.max_load();
+    REQUIRE(max_load >= 20);
+
+    for (size_t i = 0; i < max_load; i++) {
+        devices[{static_cast<uint8_t>(i % 4), static_cast<uint8_t>(0x40 + i)}] = static_cast<int>(i);
+    }
+    REQUIRE_THROWS_AS(devices[Address(9, 9)], std::length_error);
+
+    // Churn leaves tombstones, which are cleared in place
+    for (int round = 0; round < 50; round++) {
+        for (size_t i = 0; i < max_load; i += 2) {
+            devices.erase({static_cast<uint8_t>(i % 4), static_cast<uint8_t>(0x40 + i)});
+        }
+        for (size_t i = 0; i < max_load; i += 2) {
+            devices[{static_cast<uint8_t>(i % 4), static_cast<uint8_t>(0x40 + i)}] = round;
+        }
+    }
+    REQUIRE(devices.bucket_count() == slots);
+    REQUIRE(devices.size() == max_load);
+    REQUIRE(devices.at({1, 0x41}) == 1);
+    REQUIRE(devices.at({2, 0x42}) == 49);
+}
@@ -3,9 +3,12 @@
 #include <catch2/catch.hpp>
 
 #include "CppUtils/c_util/Enum.h"
+#include "CppUtils/c_util/EnumContainers.h"
 
 #include <iostream>
+#include <stdexcept>
 #include <string_view>
+#include <type_traits>
 
 
 #include "CppUtils/preproc/VariadicMacros.h"
@@ -31,6 +34,17 @@ constexpr static auto ResultsTable = EnumTable<ResultsIndexer, ResultsFieldsInde
         std::make_pair(Results::Ugly,           std::tuple("Ugly", 12893))
 );
 
+// More values than the old 63 argument limit of the variadic maps
+INDEXED_ENUM(Opcode,
+    Op00, Op01, Op02, Op03, Op04, Op05, Op06, Op07, Op08, Op09,
+    Op10, Op11, Op12, Op13, Op14, Op15, Op16, Op17, Op18, Op19,
+    Op20, Op21, Op22, Op23, Op24, Op25, Op26, Op27, Op28, Op29,
+    Op30, Op31, Op32, Op33, Op34, Op35, Op36, Op37, Op38, Op39,
+    Op40, Op41, Op42, Op43, Op44, Op45, Op46, Op47, Op48, Op49,
+    Op50, Op51, Op52, Op53, Op54, Op55, Op56, Op57, Op58, Op59,
+    Op60, Op61, Op62, Op63, Op64, Op65, Op66, Op67, Op68, Op69
+);
+
 template <Results r>
 struct check_result {
     bool operator()(const std::string& s) const { return s == ResultsTable.get<r, ResultsFields::Name>(); }
@@ -72,3 +86,93 @@ TEST_CASE("Enum Table") {
 
     ResultsIndexer::dispatch<handle_result>(Results::New, "New");
 }
+
+TEST_CASE("Enum Containers") {
+    static_assert(ResultsIndexer::contiguous);
+
+    EnumArray<ResultsIndexer, int> counters;
+    counters[Results::Bad] += 3;
+    counters.get<Results::New>() = 7;
+    REQUIRE(counters[Results::Good] == 0);
+    REQUIRE(counters[Results::Bad] == 3);
+    REQUIRE(counters[Results::New] == 7);
+    REQUIRE(counters.find(static_cast<Results>(42)) == nullptr);
+    REQUIRE(counters.at(Results::Bad) == 3);
+    REQUIRE_THROWS_AS(counters.at(static_cast<Results>(42)), std::out_of_range);
+
+    EnumBitSet<ResultsIndexer> flags(Results::Good, Results::Ugly);
+    REQUIRE(flags.test(Results::Good));
+    REQUIRE(!flags.test(Results::Bad));
+    REQUIRE(flags.count() == 2);
+    flags.set(Results::New).reset(Results::Good);
+    REQUIRE(flags.count() == 2);
+    REQUIRE((~flags).count() == 3);
+    REQUIRE(!flags.all());
+    REQUIRE((flags | ~flags).all());
+    REQUIRE(flags[Results::New]);
+    REQUIRE_THROWS_AS(flags.test(static_cast<Results>(42)), std::out_of_range);
+    REQUIRE_THROWS_AS(flags.set(static_cast<Results>(-1)), std::out_of_range);
+    REQUIRE_THROWS_AS(flags.flip(static_cast<Results>(5)), std::out_of_range);
+    REQUIRE(flags.count() == 2);
+
+    EnumMap<ResultsIndexer, std::string> names;
+    REQUIRE(names.empty());
+    names.emplace(Results::Ugly, "Ugly");
+    REQUIRE(names.insert(Results::Bad, "Bad").second);
+    REQUIRE(!names.insert(Results::Bad, "Worse").second);
+    REQUIRE(names.size() == 2);
+    REQUIRE(names.contains(Results::Ugly));
+    REQUIRE(!names.contains(Results::Good));
+    REQUIRE(*names.find(Results::Bad) == "Bad");
+
+    EnumMap<ResultsIndexer, std::string> copy = names;
+    REQUIRE(names.erase(Results::Ugly));
+    REQUIRE(!names.erase(Results::Ugly));
+    REQUIRE(names.size() == 1);
+    REQUIRE(copy.size() == 2);
+    REQUIRE(copy.at(Results::Ugly) == "Ugly");
+    REQUIRE_THROWS_AS(names.at(Results::Ugly), std::out_of_range);
+    REQUIRE(!names.contains(static_cast<Results>(42)));
+    REQUIRE(!names.erase(static_cast<Results>(42)));
+    REQUIRE_THROWS_AS(names[static_cast<Results>(42)], std::out_of_range);
+    static_assert(std::is_nothrow_move_constructible_v<EnumMap<ResultsIndexer, std::string> >);
+
+    std::string visited;
+    copy.for_each([&] (Results, const std::string& s) { visited += s; });
+    REQUIRE(visited == "BadUgly");
+}
+
+TEST_CASE("Large Indexed Enum") {
+    static_assert(OpcodeIndexer::size == 70);
+    static_assert(OpcodeIndexer::get<Opcode::Op00>() == 0);
+    static_assert(OpcodeIndexer::get<Opcode::Op63>() == 63);
+    static_assert(OpcodeIndexer::get<Opcode::Op69>() == 69);
+    REQUIRE(OpcodeIndexer::values[64] == Opcode::Op64);
+    REQUIRE(OpcodeIndexer::get(Opcode::Op42) == 42);
+}
+
+enum class Sparse { A = 40, B = -3, C = 7, D = 1000 };
+using SparseIndexer = EnumIndexer<Sparse, Sparse::A, Sparse::B, Sparse::C, Sparse::D>;
+
+template <Sparse s>
+struct sparse_value {
+    int operator()(int offset) const { return static_cast<int>(s) + offset; }
+};
+
+TEST_CASE("Non-contiguous Enum Indexer") {
+    static_assert(!SparseIndexer::contiguous);
+    static_assert(SparseIndexer::get<Sparse::D>() == 3);
+    REQUIRE(SparseIndexer::get(Sparse::A) == 0);
+    REQUIRE(SparseIndexer::get(Sparse::B) == 1);
+    REQUIRE(SparseIndexer::get(Sparse::C) == 2);
+    REQUIRE(!SparseIndexer::get(static_cast<Sparse>(8)));
+
+    REQUIRE(SparseIndexer::dispatch<sparse_value>(Sparse::C, 1) == 8);
+    REQUIRE(!SparseIndexer::dispatch<sparse_value>(static_cast<Sparse>(8), 1));
+
+    EnumArray<SparseIndexer, int> values;
+    values.at(Sparse::D) = 4;
+    REQUIRE(values[Sparse::D] == 4);
+    REQUIRE_THROWS_AS(values.at(static_cast<Sparse>(8)), std::out_of_range);
+    REQUIRE_THROWS_AS(EnumBitSet<SparseIndexer>().set(static_cast<Sparse>(8)), std::out_of_range);
+}
@@ -3,10 +3,37 @@
 #include <catch2/catch.hpp>
 
 #include "CppUtils/io/BinaryIO.h"
+#include "CppUtils/io/CompressedHandle.h"
+#include "CppUtils/io/LzCodec.h"
+#include "CppUtils/io/RecordLog.h"
 #include "CppUtils/io/FileHandle.h"
+#include "CppUtils/io/I2cBusScheduler.h"
+#include "CppUtils/io/I2cHandle.h"
+#include "CppUtils/io/I2cRegisterCache.h"
+#include "CppUtils/io/PipeHandle.h"
+#include "CppUtils/io/PooledRead.h"
 #include "CppUtils/io/DeviceHandle.h"
+#include "CppUtils/io/DirectIOHandle.h"
+#include "CppUtils/io/RingBufferHandle.h"
+#include "CppUtils/io/Serialization.h"
+#include "CppUtils/io/SharedMemoryChannel.h"
 
+#include "CppUtils/c_util/HandlerRegistry.h"
+#include "CppUtils/concurrency/ThreadPool.h"
+
+#include <linux/i2c-dev.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <map>
 #include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <thread>
 
 template <typename T>
 void run_test() {
@@ -43,3 +70,976 @@ TEST_CASE("Device Handle") {
 TEST_CASE("File Handle") {
     run_test<FileHandle>();
 }
+
+TEST_CASE("Span Buffers") {
+    std::vector<uint8_t> arena(64);
+    for (size_t i = 0; i < arena.size(); i++) {
+        arena[i] = static_cast<uint8_t>(i);
+    }
+    Span<uint8_t> slices(arena);
+
+    DeviceWriter writer("temp.txt", OpenMode::Truncate);
+    REQUIRE(writer.good());
+    writer.write_buffer(slices.subspan(8, 16));
+    writer.write(slices.last(4));
+    writer.close();
+
+    std::vector<uint8_t> input(32, 0);
+    Span<uint8_t> in(input);
+
+    DeviceReader reader("temp.txt", OpenMode::Read);
+    REQUIRE(reader.good());
+    reader.read_buffer(in.first(16));
+    REQUIRE(reader.var_read_buffer(in.subspan(16)) == 4);
+    reader.close();
+
+    for (size_t i = 0; i < 16; i++) {
+        REQUIRE(input[i] == 8 + i);
+    }
+    for (size_t i = 0; i < 4; i++) {
+        REQUIRE(input[16 + i] == 60 + i);
+    }
+}
+
+TEST_CASE("Pooled Buffers") {
+    DeviceWriter writer("temp.txt", OpenMode::Truncate);
+    REQUIRE(writer.good());
+    writer.write("header", 6);
+    writer.write("payload", 7);
+    writer.close();
+
+    BufferPool pool(256);
+    MonotonicArena arena;
+
+    DeviceReader reader("temp.txt", OpenMode::Read);
+    REQUIRE(reader.good());
+    REQUIRE(read_string(reader, arena, 6) == "header");
+    PooledBuffer rest = var_read_buffer(reader, pool);
+    reader.close();
+
+    REQUIRE(rest.size() == 7);
+    REQUIRE(rest.capacity() == 256);
+    REQUIRE(rest.str() == "payload");
+}
+
+enum class Channel : uint8_t { A, B };
+
+struct Reading {
+    uint32_t id;
+    int16_t axes[2];
+    float value;
+};
+CPPUTILS_SERIALIZABLE(Reading, id, axes, value)
+
+struct Frame {
+    Channel channel;
+    Reading reading;
+    bool valid;
+    std::array<uint16_t, 2> flags;
+};
+CPPUTILS_SERIALIZABLE(Frame, channel, reading, valid, flags)
+
+TEST_CASE("Serialization") {
+    static_assert(wire_size<Reading>() == 12);
+    static_assert(wire_size<Frame>() == 18);
+    static_assert(has_wire_layout<Reading, native_endianness>());
+    static_assert(!has_wire_layout<Reading, Endianness::Big>() || native_endianness == Endianness::Big);
+    static_assert(!has_wire_layout<Frame>());
+    static_assert(!is_serializable<long double>() || sizeof(long double) == sizeof(double));
+
+    const Frame frame = {Channel::B, {0x01020304, {-2, 7}, 1.5f}, true, {{0xabcd, 1}}};
+    uint8_t buffer[wire_size<Frame>()];
+    REQUIRE(encode<Endianness::Big>(frame, buffer) == buffer + sizeof(buffer));
+    REQUIRE(buffer[0] == 1);
+    REQUIRE(buffer[1] == 0x01);
+    REQUIRE(buffer[4] == 0x04);
+    REQUIRE(buffer[5] == 0xff);
+    REQUIRE(buffer[6] == 0xfe);
+    REQUIRE(buffer[13] == 1);
+    REQUIRE(buffer[14] == 0xab);
+
+    Frame decoded = {};
+    decode<Endianness::Big>(decoded, buffer);
+    REQUIRE(decoded.channel == Channel::B);
+    REQUIRE(decoded.reading.id == 0x01020304);
+    REQUIRE(decoded.reading.axes[0] == -2);
+    REQUIRE(decoded.reading.value == 1.5f);
+    REQUIRE(decoded.valid);
+    REQUIRE(decoded.flags[0] == 0xabcd);
+
+    std::vector<Frame> frames(1000, frame);
+    std::vector<Reading> readings(1000, frame.reading);
+    frames[999].reading.id = 999;
+    readings[999].id = 999;
+
+    DeviceWriter writer("temp.txt", OpenMode::Truncate);
+    REQUIRE(writer.good());
+    write_serialized<Endianness::Big>(writer, Span<const Frame>(frames));
+    write_serialized(writer, Span<const Reading>(readings));
+    write_serialized(writer, frame);
+    writer.close();
+
+    std::vector<Frame> frames_in(1000);
+    std::vector<Reading> readings_in(1000);
+    Frame last = {};
+    DeviceReader reader("temp.txt", OpenMode::Read);
+    REQUIRE(reader.good());
+    read_serialized<Endianness::Big>(reader, Span<Frame>(frames_in));
+    read_serialized(reader, Span<Reading>(readings_in));
+    read_serialized(reader, last);
+    reader.close();
+
+    REQUIRE(frames_in[999].reading.id == 999);
+    REQUIRE(frames_in[500].flags[0] == 0xabcd);
+    REQUIRE(readings_in[999].id == 999);
+    REQUIRE(readings_in[0].axes[1] == 7);
+    REQUIRE(last.reading.value == 1.5f);
+}
+
+INDEXED_ENUM(Command,
+    Reset,
+    SetRate,
+    Echo
+);
+
+struct CommandState {
+    int resets = 0;
+    uint8_t channel = 0;
+    float rate = 0.0;
+};
+
+template <Command c>
+struct on_command;
+
+template <>
+struct on_command<Command::Reset> {
+    using Arguments = std::tuple<>;
+    int operator()(CommandState& state) const { return ++state.resets; }
+};
+
+template <>
+struct on_command<Command::SetRate> {
+    using Arguments = std::tuple<uint8_t, float>;
+    int operator()(CommandState& state, uint8_t channel, float rate) const {
+        state.channel = channel;
+        state.rate = rate;
+        return channel;
+    }
+};
+
+template <>
+struct on_command<Command::Echo> {
+    using Arguments = std::tuple<int32_t>;
+    int operator()(CommandState&, int32_t x) const { return x; }
+};
+
+TEST_CASE("Handler Registry") {
+    using Registry = HandlerRegistry<CommandIndexer, on_command, uint16_t>;
+
+    SpscRingBuffer<uint8_t> ring(1024);
+    RingBufferWriter writer(ring);
+    RingBufferReader reader(ring);
+    Registry::write_message<Command::SetRate>(writer, 3, 2.5f);
+    Registry::write_message<Command::Reset>(writer);
+    Registry::write_message<Command::Echo>(writer, -17);
+    REQUIRE(ring.size() == (2 + 1 + 4) + 2 + (2 + 4));
+
+    CommandState state;
+    REQUIRE(Registry::dispatch(reader, state) == 3);
+    REQUIRE(state.channel == 3);
+    REQUIRE(state.rate == 2.5f);
+    REQUIRE(Registry::dispatch(reader, state) == 1);
+    REQUIRE(state.resets == 1);
+    REQUIRE(Registry::dispatch(reader, state) == -17);
+    REQUIRE(ring.empty());
+
+    writer.write<uint16_t>(99);
+    REQUIRE_THROWS(Registry::dispatch(reader, state));
+}
+
+TEST_CASE("LZ Codec") {
+    std::mt19937 rng(7);
+    std::vector<uint8_t> noise(5000);
+    for (uint8_t& x : noise) x = static_cast<uint8_t>(rng());
+
+    std::string text;
+    for (int i = 0; i < 200; i++) text += "sensor=" + std::to_string(i % 7) + ";value=42;";
+    const std::vector<uint8_t> telemetry(text.begin(), text.end());
+
+    const std::vector<uint8_t>* inputs[] = {&noise, &telemetry};
+    for (const std::vector<uint8_t>* input : inputs) {
+        for (size_t size : {size_t{0}, size_t{1}, size_t{12}, size_t{13}, size_t{100}, input->size()}) {
+            std::vector<uint8_t> compressed(lz_compress_bound(size));
+            const size_t n = lz_compress(input->data(), size, compressed.data());
+            REQUIRE(n <= compressed.size());
+
+            std::vector<uint8_t> output(size);
+            REQUIRE(lz_decompress(compressed.data(), n, output.data(), output.size()) == size);
+            REQUIRE(std::equal(output.begin(), output.end(), input->begin()));
+        }
+    }
+
+    std::vector<uint8_t> compressed(lz_compress_bound(telemetry.size()));
+    const size_t n = lz_compress(telemetry.data(), telemetry.size(), compressed.data());
+    REQUIRE(n < telemetry.size() / 4);
+
+    std::vector<uint8_t> output(telemetry.size());
+    REQUIRE_THROWS_AS(lz_decompress(compressed.data(), n, output.data(), 100), std::runtime_error);
+    REQUIRE_THROWS_AS(lz_decompress(compressed.data(), n - 3, output.data(), output.size()), std::runtime_error);
+}
+
+TEST_CASE("Compressed Handle") {
+    ThreadPool pool(2);
+    for (ThreadPool* compress_pool : {static_cast<ThreadPool*>(nullptr), &pool}) {
+        {
+            FileWriter file("temp.txt", OpenMode::Truncate);
+            REQUIRE(file.good());
+            CompressedWriter writer(file, 1000, compress_pool);
+            for (int32_t i = 0; i < 20000; i++) {
+                writer.write<int32_t>(i / 16);
+            }
+            writer.write_string("end");
+        }
+
+        FileReader file("temp.txt", OpenMode::Read);
+        REQUIRE(file.good());
+        CompressedReader reader(file);
+        bool matches = true;
+        for (int32_t i = 0; i < 20000; i++) {
+            int32_t x;
+            reader.read(x);
+            matches = matches && x == i / 16;
+        }
+        REQUIRE(matches);
+
+        char tail[8];
+        REQUIRE(reader.var_read(tail, 8) == 3);
+        REQUIRE(std::string(tail, 3) == "end");
+        REQUIRE(reader.var_read(tail, 8) == 0);
+    }
+
+    // A failing sink throws from close(), but not from the destructor
+    SpscRingBuffer<uint8_t> ring(64);
+    RingBufferWriter sink(ring);
+    {
+        CompressedWriter writer(sink, 1000);
+        writer.write<int32_t>(1);
+        writer.release();
+        REQUIRE(!writer.good());
+    }
+    REQUIRE(ring.empty());
+    ring.close();
+    {
+        CompressedWriter writer(sink, 1000);
+        writer.write<int32_t>(1);
+        REQUIRE_THROWS(writer.close());
+        REQUIRE(!writer.good());
+    }
+    REQUIRE_NOTHROW([&sink] {
+        CompressedWriter writer(sink, 1000);
+        writer.write<int32_t>(1);
+    }());
+}
+
+TEST_CASE("Record Log") {
+    std::remove("records.log");
+    std::remove("records.log.idx");
+
+    auto payload = [] (uint64_t i) {
+        std::string text = "record " + std::to_string(i);
+        return std::vector<uint8_t>(text.begin(), text.end());
+    };
+
+    {
+        RecordLogWriter writer("records.log", 64, 4096);
+        for (uint64_t i = 0; i < 5000; i++) {
+            REQUIRE(writer.append(1000 + i / 2, payload(i)) == i);
+        }
+    }
+
+    RecordLogReader reader("records.log");
+    LogRecord record;
+    REQUIRE(reader.next(record));
+    REQUIRE(record.number == 0);
+    REQUIRE(record.payload == payload(0));
+
+    REQUIRE(reader.seek_record(4001));
+    REQUIRE(reader.next(record));
+    REQUIRE(record.number == 4001);
+    REQUIRE(record.payload == payload(4001));
+
+    // First of the two records at this timestamp
+    REQUIRE(reader.seek_timestamp(1000 + 1500));
+    REQUIRE(reader.next(record));
+    REQUIRE(record.number == 3000);
+
+    REQUIRE(!reader.seek_record(6000));
+    REQUIRE(reader.position() == 5000);
+    REQUIRE(!reader.next(record));
+
+    // A torn write at the end is dropped when the log is reopened
+    {
+        DeviceWriter torn("records.log", OpenMode::Append);
+        torn.write("\x10\0\0\0garbage", 11);
+    }
+    RecordLogWriter writer("records.log", 64, 4096);
+    REQUIRE(writer.size() == 5000);
+
+    // Tailing
+    std::thread producer([&writer] {
+        std::vector<uint8_t> data = {1, 2, 3};
+        writer.append(9000, data);
+        writer.commit();
+    });
+    REQUIRE(reader.wait_next(record, std::chrono::milliseconds(5000)));
+    producer.join();
+    REQUIRE(record.number == 5000);
+    REQUIRE(record.timestamp == 9000);
+    REQUIRE(record.payload.size() == 3);
+
+    writer.close();
+    reader.close();
+    std::remove("records.log");
+    std::remove("records.log.idx");
+}
+
+TEST_CASE("Record Log Failed Commit") {
+    // Writes to /dev/full fail with ENOSPC
+    std::remove("full.log");
+    std::remove("full.log.idx");
+    REQUIRE(symlink("/dev/full", "full.log") == 0);
+
+    const uint8_t payload[] = {1, 2, 3};
+    {
+        RecordLogWriter writer("full.log");
+        writer.append(1, Span<const uint8_t>(payload, 3));
+        REQUIRE_THROWS(writer.commit());
+        writer.append(2, Span<const uint8_t>(payload, 3));
+        REQUIRE_THROWS(writer.close());
+        REQUIRE(!writer.good());
+    }
+    REQUIRE_NOTHROW([&payload] {
+        RecordLogWriter writer("full.log");
+        writer.append(1, Span<const uint8_t>(payload, 3));
+    }());
+
+    std::remove("full.log");
+    std::remove("full.log.idx");
+}
+
+TEST_CASE("Open Options") {
+    OpenOptions options;
+    options.dsync = true;
+    options.noatime = true;
+    DeviceWriter writer("temp.txt", OpenMode::Truncate, options);
+    REQUIRE(writer.good());
+    writer.write<int32_t>(17);
+    writer.close();
+
+    DeviceReader reader("temp.txt", OpenMode::Read, options);
+    REQUIRE(reader.good());
+    int32_t x;
+    reader.read(x);
+    REQUIRE(x == 17);
+
+    // Without O_CREAT a missing path isn't created
+    std::remove("missing.bin");
+    OpenOptions existing;
+    existing.no_create = true;
+    DeviceReaderWriter missing("missing.bin", OpenMode::ReadWrite, existing);
+    REQUIRE(!missing.good());
+    REQUIRE(::access("missing.bin", F_OK) != 0);
+}
+
+TEST_CASE("Direct I/O") {
+    // O_DIRECT may be unsupported here (tmpfs), the writer then falls back
+    std::vector<uint8_t> data(3 * 4096 + 123);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    {
+        DirectWriter writer("temp.txt", 512, 4096);
+        REQUIRE(writer.good());
+        writer.write(data.data(), 100);
+        writer.flush();
+        writer.write(data.data() + 100, data.size() - 100);
+    }
+
+    std::vector<uint8_t> input(data.size() + 1);
+    DeviceReader reader("temp.txt", OpenMode::Read);
+    REQUIRE(reader.var_read_buffer(input) == data.size());
+    input.pop_back();
+    REQUIRE(input == data);
+
+    // Writes to /dev/full fail: close() throws, the destructor doesn't
+    {
+        DirectWriter writer("/dev/full", 512, 4096);
+        writer.write(data.data(), 100);
+        REQUIRE_THROWS(writer.close());
+        REQUIRE(!writer.good());
+    }
+    REQUIRE_NOTHROW([&data] {
+        DirectWriter writer("/dev/full", 512, 4096);
+        writer.write(data.data(), 100);
+    }());
+}
+
+TEST_CASE("Random Access") {
+    std::remove("temp.txt");
+    {
+        DeviceRandomWriter writer("temp.txt", OpenMode::ReadWrite);
+        REQUIRE(writer.good());
+        // Out of order, positional writes
+        for (uint32_t block = 4; block-- > 0;) {
+            std::vector<uint32_t> values(1024);
+            for (uint32_t i = 0; i < values.size(); i++) {
+                values[i] = block * 1024 + i;
+            }
+            writer.write_at(block * 4096, values.data(), values.size());
+        }
+        REQUIRE(writer.size() == 4 * 4096);
+    }
+
+    DeviceRandomReader reader("temp.txt", OpenMode::Read);
+    REQUIRE(reader.good());
+    std::vector<std::thread> threads;
+    std::atomic<bool> matches{true};
+    for (uint32_t t = 0; t < 4; t++) {
+        threads.emplace_back([&reader, &matches, t] {
+            std::vector<uint32_t> values(512);
+            reader.read_at(t * 4096 + 2048, values.data(), values.size());
+            for (uint32_t i = 0; i < values.size(); i++) {
+                if (values[i] != t * 1024 + 512 + i)
+                    matches = false;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(matches.load());
+    REQUIRE(reader.tell() == 0);
+
+    uint32_t x;
+    REQUIRE(reader.var_read_at(4 * 4096 - 2, &x, 1) == 2);
+    REQUIRE_THROWS(reader.read_at(4 * 4096 - 2, x));
+
+    REQUIRE(reader.seek(-4, SeekOrigin::End) == 4 * 4096 - 4);
+}
+
+TEST_CASE("File Seek") {
+    {
+        FileWriter writer("seek.bin", OpenMode::Truncate);
+        REQUIRE(writer.good());
+        for (uint32_t i = 0; i < 4096; i++) {
+            writer.write(i);
+        }
+    }
+
+    FileReaderWriter file("seek.bin", OpenMode::ReadWrite);
+    REQUIRE(file.good());
+    REQUIRE(file.seek(8) == 8);
+    uint32_t x;
+    file.read(x);
+    REQUIRE(x == 2);
+    REQUIRE(file.tell() == 12);
+    REQUIRE(file.seek(-4, SeekOrigin::End) == 4 * 4096 - 4);
+    file.read(x);
+    REQUIRE(x == 4095);
+    file.close();
+    std::remove("seek.bin");
+}
+
+/*
+ * I2C bus with register-mapped devices, in place of the driver.
+ */
+class MockI2cBus : public I2cHandle {
+public:
+    std::map<uint8_t, std::array<uint8_t, 256> > devices;
+    std::vector<size_t> batches;
+    size_t selects = 0;
+    size_t smbus_transfers = 0;
+
+protected:
+    virtual int _ioctl(unsigned long request, void* arg) override {
+        if (request == I2C_SLAVE) {
+            selects++;
+            selected_ = static_cast<uint8_t>(reinterpret_cast<uintptr_t>(arg));
+            return 0;
+        }
+        if (request == I2C_SMBUS)
+            return smbus(*static_cast<i2c_smbus_ioctl_data*>(arg));
+        if (request != I2C_RDWR)
+            return -1;
+
+        const i2c_rdwr_ioctl_data& data = *static_cast<i2c_rdwr_ioctl_data*>(arg);
+        batches.push_back(data.nmsgs);
+        if (data.nmsgs > max_messages)
+            return -1;
+
+        std::map<uint8_t, uint8_t> pointers;
+        for (uint32_t i = 0; i < data.nmsgs; i++) {
+            const i2c_msg& message = data.msgs[i];
+            auto device = devices.find(static_cast<uint8_t>(message.addr));
+            if (device == devices.end())
+                return -1;
+            uint8_t& pointer = pointers[device->first];
+            if (message.flags & I2C_M_RD) {
+                for (uint16_t j = 0; j < message.len; j++) message.buf[j] = device->second[pointer++];
+            } else if (message.len > 0) {
+                pointer = message.buf[0];
+                for (uint16_t j = 1; j < message.len; j++) device->second[pointer++] = message.buf[j];
+            }
+        }
+        return static_cast<int>(data.nmsgs);
+    }
+
+private:
+    uint8_t selected_ = 0;
+
+    // SMBus block reads return the byte at reg as the count, then the data
+    int smbus(const i2c_smbus_ioctl_data& args) {
+        auto device = devices.find(selected_);
+        if (device == devices.end())
+            return -1;
+        smbus_transfers++;
+
+        std::array<uint8_t, 256>& regs = device->second;
+        const bool read = args.read_write == I2C_SMBUS_READ;
+        uint8_t reg = args.command;
+        i2c_smbus_data& data = *args.data;
+        switch (args.size) {
+            case I2C_SMBUS_BYTE_DATA:
+                if (read) data.byte = regs[reg]; else regs[reg] = data.byte;
+                return 0;
+            case I2C_SMBUS_WORD_DATA:
+                if (read) {
+                    data.word = static_cast<uint16_t>(regs[reg] | regs[uint8_t(reg + 1)] << 8);
+                } else {
+                    regs[reg] = static_cast<uint8_t>(data.word);
+                    regs[uint8_t(reg + 1)] = static_cast<uint8_t>(data.word >> 8);
+                }
+                return 0;
+            case I2C_SMBUS_BLOCK_DATA:
+                if (read) {
+                    data.block[0] = regs[reg];
+                    for (uint8_t i = 0; i < data.block[0]; i++) data.block[1 + i] = regs[++reg];
+                } else {
+                    regs[reg] = data.block[0];
+                    for (uint8_t i = 0; i < data.block[0]; i++) regs[++reg] = data.block[1 + i];
+                }
+                return 0;
+            case I2C_SMBUS_I2C_BLOCK_DATA:
+                for (uint8_t i = 0; i < data.block[0]; i++, reg++) {
+                    if (read) data.block[1 + i] = regs[reg]; else regs[reg] = data.block[1 + i];
+                }
+                return 0;
+        }
+        return -1;
+    }
+};
+
+TEST_CASE("I2C Transactions") {
+    MockI2cBus bus;
+    for (size_t i = 0; i < 256; i++) {
+        bus.devices[0x40][i] = static_cast<uint8_t>(i);
+        bus.devices[0x41][i] = static_cast<uint8_t>(255 - i);
+    }
+
+    uint8_t data[2];
+    bus.read_register(0x40, 0x10, data);
+    REQUIRE(data[0] == 0x10);
+    REQUIRE(data[1] == 0x11);
+    REQUIRE(bus.batches == std::vector<size_t>{2});
+
+    const uint8_t config[2] = {0xaa, 0xbb};
+    bus.write_register(0x41, 0x20, config);
+    REQUIRE(bus.devices[0x41][0x21] == 0xbb);
+
+    // Both devices in one ioctl
+    I2cTransaction transaction;
+    uint8_t a[1];
+    uint8_t b[1];
+    transaction.read_register(0x40, 0x05, a, 1);
+    transaction.read_register(0x41, 0x20, b, 1);
+    REQUIRE(transaction.size() == 4);
+    bus.batches.clear();
+    bus.transfer(transaction);
+    REQUIRE(bus.batches.size() == 1);
+    REQUIRE(a[0] == 0x05);
+    REQUIRE(b[0] == 0xaa);
+
+    // Copies point into their own register bytes
+    I2cTransaction copy = transaction;
+    transaction.clear();
+    transaction.read_register(0x40, 0x07, a, 1);
+    b[0] = 0;
+    bus.transfer(copy);
+    REQUIRE(b[0] == 0xaa);
+
+    // 30 register reads are 60 messages, split between operations
+    uint8_t regs[30];
+    uint8_t values[30 * 2];
+    for (uint8_t i = 0; i < 30; i++) regs[i] = static_cast<uint8_t>(i * 2);
+    bus.batches.clear();
+    bus.read_registers(0x40, regs, 30, values, 2);
+    REQUIRE(bus.batches == std::vector<size_t>{42, 18});
+    REQUIRE(values[2 * 29] == 58);
+    REQUIRE(values[2 * 29 + 1] == 59);
+    REQUIRE_THROWS_AS(bus.read_registers(0x40, regs, SIZE_MAX / 2 + 1, values, 2), std::runtime_error);
+
+    uint8_t missing[1];
+    REQUIRE_THROWS_AS(bus.read_register(0x50, 0, missing, 1), std::runtime_error);
+}
+
+TEST_CASE("SMBus Transfers") {
+    MockI2cBus bus;
+    bus.devices[0x40] = {};
+    bus.devices[0x41] = {};
+
+    bus.smbus_write_byte(0x40, 0x01, 0x7f);
+    REQUIRE(bus.smbus_read_byte(0x40, 0x01) == 0x7f);
+    bus.smbus_write_word(0x40, 0x02, 0x1234);
+    REQUIRE(bus.devices[0x40][0x02] == 0x34);
+    REQUIRE(bus.smbus_read_word(0x40, 0x02) == 0x1234);
+    // The device is only selected once
+    REQUIRE(bus.selects == 1);
+
+    const uint8_t block[3] = {1, 2, 3};
+    bus.smbus_write_block(0x41, 0x10, block, 3);
+    REQUIRE(bus.selects == 2);
+    uint8_t out[8] = {};
+    REQUIRE(bus.smbus_read_block(0x41, 0x10, out, sizeof(out)) == 3);
+    REQUIRE(out[2] == 3);
+
+    bus.smbus_write_i2c_block(0x41, 0x20, block, 3);
+    bus.smbus_read_i2c_block(0x41, 0x20, out, 2);
+    REQUIRE(out[1] == 2);
+
+    uint8_t big[I2cHandle::max_block_size + 1] = {};
+    REQUIRE_THROWS_AS(bus.smbus_write_block(0x41, 0, big, sizeof(big)), std::runtime_error);
+    REQUIRE_THROWS_AS(bus.smbus_read_byte(0x50, 0), std::runtime_error);
+}
+
+TEST_CASE("I2C Register Cache") {
+    MockI2cBus bus;
+    for (size_t i = 0; i < 256; i++) bus.devices[0x40][i] = static_cast<uint8_t>(i);
+
+    I2cRegisterCache cache(bus, 0x40);
+    cache.set_non_volatile(0x10, 8);
+
+    // Volatile registers always go to the bus
+    REQUIRE(cache.read(0x00) == 0x00);
+    REQUIRE(cache.read(0x00) == 0x00);
+    REQUIRE(cache.misses() == 2);
+
+    // Config block: the first read fills the cache
+    uint8_t config[8];
+    cache.read(0x10, config, 8);
+    cache.read(0x10, config, 8);
+    REQUIRE(config[7] == 0x17);
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.misses() == 3);
+
+    // Rewriting the same block is skipped, a change writes only what differs
+    bus.batches.clear();
+    cache.write(0x10, config, 8);
+    REQUIRE(bus.batches.empty());
+    REQUIRE(cache.hits() == 2);
+
+    config[2] = 0xa2;
+    config[4] = 0xa4;
+    cache.write(0x10, config, 8);
+    REQUIRE(bus.batches == std::vector<size_t>{1});
+    REQUIRE(bus.devices[0x40][0x12] == 0xa2);
+    REQUIRE(bus.devices[0x40][0x14] == 0xa4);
+    REQUIRE(cache.read(0x14) == 0xa4);
+    REQUIRE(cache.hits() == 3);
+
+    // A reset device must be read again
+    bus.devices[0x40][0x14] = 0x14;
+    cache.invalidate();
+    REQUIRE(cache.read(0x14) == 0x14);
+    REQUIRE(cache.misses() == 5);
+
+    REQUIRE_THROWS_AS(cache.read(0xff, config, 2), std::runtime_error);
+}
+
+TEST_CASE("I2C Bus Scheduler") {
+    using namespace std::chrono_literals;
+
+    auto bus = std::make_unique<MockI2cBus>();
+    MockI2cBus& mock = *bus;
+    for (size_t i = 0; i < 256; i++) {
+        mock.devices[0x40][i] = static_cast<uint8_t>(i);
+        mock.devices[0x41][i] = static_cast<uint8_t>(255 - i);
+    }
+
+    I2cBusScheduler scheduler(2ms);
+    const size_t bus_index = scheduler.add_bus(std::move(bus));
+    const auto fast = scheduler.add_device(bus_index, 0x40, 0x10, 4, 5ms);
+    const auto slow = scheduler.add_device(bus_index, 0x41, 0x00, 2, 10ms);
+    // Not on the bus: it fails every poll, which mustn't cost the others
+    const auto missing = scheduler.add_device(bus_index, 0x50, 0x00, 1, 5ms);
+    REQUIRE_THROWS_AS(scheduler.add_device(bus_index, 0x40, 0, I2cBusScheduler::max_read_size + 1, 5ms),
+                      std::runtime_error);
+
+    I2cSample sample;
+    REQUIRE(!scheduler.latest(fast, sample));
+
+    scheduler.start();
+    REQUIRE_THROWS_AS(scheduler.add_device(bus_index, 0x40, 0, 1, 5ms), std::runtime_error);
+    std::this_thread::sleep_for(100ms);
+    scheduler.stop();
+
+    REQUIRE(scheduler.latest(fast, sample));
+    REQUIRE(sample.sequence > 1);
+    REQUIRE(sample.size == 4);
+    REQUIRE(sample.data[0] == 0x10);
+    REQUIRE(sample.data[3] == 0x13);
+
+    REQUIRE(scheduler.latest(slow, sample));
+    REQUIRE(sample.data[0] == 0xff);
+    REQUIRE(sample.data[1] == 0xfe);
+
+    REQUIRE(!scheduler.latest(missing, sample));
+    REQUIRE(scheduler.error_count(missing) > 0);
+    REQUIRE(scheduler.error_count(fast) == 0);
+    REQUIRE(scheduler.error_count(slow) == 0);
+
+    // All devices start due together, so the first poll is one ioctl; it
+    // fails and each device is retried on its own
+    REQUIRE(mock.batches.size() >= 4);
+    REQUIRE(std::vector<size_t>(mock.batches.begin(), mock.batches.begin() + 4) == std::vector<size_t>{6, 2, 2, 2});
+}
+
+TEST_CASE("Pipe Handle") {
+    using namespace std::chrono_literals;
+    const std::string path = "/tmp/cpputils_test_pipe_" + std::to_string(getpid());
+    ::unlink(path.c_str());
+
+    // No reader yet
+    OutputPipeHandle orphan(path);
+    REQUIRE(!orphan.good());
+
+    PipeOptions options;
+    options.timeout = 20ms;
+    options.capacity = 4096;
+    PipeReader reader(path, options);
+    REQUIRE(reader.good());
+    REQUIRE(reader.capacity() == 4096);
+
+    // Nothing written, and no writer ever connected: a timeout, not a hang up
+    uint8_t byte;
+    REQUIRE(reader.var_read(&byte, 1) == 0);
+    REQUIRE(!reader.hung_up());
+    REQUIRE_THROWS_AS(reader.read(byte), std::runtime_error);
+
+    PipeWriter writer(path, options);
+    REQUIRE(writer.good());
+
+    // Fill the pipe, then the writer backs off instead of failing
+    std::vector<uint8_t> block(4096, 7);
+    REQUIRE(writer.write_some(block.data(), block.size()) == 4096);
+    REQUIRE(writer.write_some(block.data(), 1) == 0);
+    REQUIRE(!writer.wait_ready(0ms));
+    REQUIRE_THROWS_AS(writer.write(block.data(), 1), std::runtime_error);
+    reader.read(block.data(), block.size());
+    REQUIRE(writer.wait_ready(0ms));
+
+    // Writes larger than the pipe continue as the reader drains it
+    writer.set_timeout(-1ms);
+    std::vector<int32_t> values(50000);
+    for (size_t i = 0; i < values.size(); i++) values[i] = static_cast<int32_t>(i);
+    std::thread producer([&writer, &values] {
+        writer.write(values.data(), values.size());
+        writer.close();
+    });
+
+    reader.set_timeout(5000ms);
+    std::vector<int32_t> received(values.size());
+    reader.read(received.data(), received.size());
+    producer.join();
+    REQUIRE(received == values);
+
+    REQUIRE(reader.var_read(&byte, 1) == 0);
+    REQUIRE(reader.hung_up());
+    REQUIRE_THROWS_AS(reader.read(byte), std::runtime_error);
+
+    // Opening the write end can wait for a reader to show up
+    reader.close();
+    std::thread late_reader([&path] {
+        std::this_thread::sleep_for(20ms);
+        InputPipeHandle input(path);
+        std::this_thread::sleep_for(20ms);
+    });
+    options.open_timeout = 2000ms;
+    OutputPipeHandle output(path, options);
+    REQUIRE(output.good());
+    late_reader.join();
+
+    ::unlink(path.c_str());
+}
+
+TEST_CASE("Shared Memory Channel") {
+    using namespace std::chrono_literals;
+    const std::string name = "/cpputils_test_channel_" + std::to_string(getpid());
+    SharedMemoryChannel::unlink(name);
+
+    SharedMemoryWriter writer(name, 3000);
+    REQUIRE(writer.good());
+    REQUIRE(writer.capacity() == 4096);
+    REQUIRE_THROWS_AS(SharedMemoryChannel(name, 4096), std::runtime_error);
+
+    SharedMemoryReader reader(name);
+    REQUIRE(reader.capacity() == 4096);
+    SharedMemoryChannel::unlink(name);
+
+    uint8_t byte;
+    reader.set_timeout(10ms);
+    REQUIRE(reader.var_read(&byte, 1) == 0);
+    REQUIRE_THROWS_AS(reader.read(byte), std::runtime_error);
+
+    // Many times the ring size, wrapping around while both sides wait on each other
+    std::vector<int32_t> values(100000);
+    for (size_t i = 0; i < values.size(); i++) values[i] = static_cast<int32_t>(i * 7);
+    std::thread producer([&writer, &values] {
+        for (size_t i = 0; i < values.size(); i += 1000) {
+            writer.write(values.data() + i, 1000);
+        }
+        writer.close();
+    });
+
+    reader.set_timeout(-1ms);
+    std::vector<int32_t> received(values.size());
+    reader.read(received.data(), received.size());
+    producer.join();
+    REQUIRE(received == values);
+
+    REQUIRE(reader.var_read(&byte, 1) == 0);
+    REQUIRE_THROWS_AS(reader.read(byte), std::runtime_error);
+
+    // Anonymous channel, shared by descriptor
+    SharedMemoryWriter anonymous_writer;
+    anonymous_writer.create_anonymous(64);
+    SharedMemoryReader anonymous_reader;
+    anonymous_reader.open_fd(::dup(anonymous_writer.fd()));
+    anonymous_writer.write<uint64_t>(42);
+    uint64_t x;
+    anonymous_reader.read(x);
+    REQUIRE(x == 42);
+
+    // Remapping the handle's own descriptor keeps the channel open
+    anonymous_reader.open_fd(anonymous_reader.fd());
+    anonymous_writer.write<uint64_t>(43);
+    anonymous_reader.read(x);
+    REQUIRE(x == 43);
+
+    anonymous_writer.set_timeout(10ms);
+    std::vector<uint8_t> block(65);
+    REQUIRE_THROWS_AS(anonymous_writer.write(block.data(), block.size()), std::runtime_error);
+    anonymous_reader.close();
+    REQUIRE_THROWS_AS(anonymous_writer.write(x), std::runtime_error);
+}
+
+TEST_CASE("Shared Memory Channel Processes") {
+    const std::string name = "/cpputils_test_process_channel_" + std::to_string(getpid());
+    SharedMemoryChannel::unlink(name);
+    SharedMemoryReader reader(name, 4096);
+    REQUIRE(reader.good());
+    // Fail rather than hang if the child dies
+    reader.set_timeout(std::chrono::seconds(10));
+
+    // The child maps the channel itself and waits on the shared futexes
+    constexpr int32_t n_values = 200000;
+    const pid_t child = fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        int status = 0;
+        try {
+            SharedMemoryWriter writer(name);
+            for (int32_t i = 0; i < n_values; i++) {
+                writer.write(i * 3);
+            }
+            writer.close();
+        } catch (...) {
+            status = 1;
+        }
+        _exit(status);
+    }
+
+    bool matches = true;
+    for (int32_t i = 0; i < n_values; i++) {
+        int32_t x;
+        reader.read(x);
+        matches = matches && x == i * 3;
+    }
+    int32_t extra;
+    REQUIRE(reader.var_read(&extra, 1) == 0);
+
+    int status;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+    REQUIRE(matches);
+    SharedMemoryChannel::unlink(name);
+}
+
+TEST_CASE("Ring Buffer Handle") {
+    SpscRingBuffer<uint8_t> ring(16);
+
+    std::thread producer([&ring] {
+        RingBufferWriter writer(ring);
+        for (int32_t i = 0; i < 1000; i++) {
+            writer.write<int32_t>(i);
+            writer.write<double>(i * 0.5);
+        }
+    });
+
+    RingBufferReader reader(ring);
+    REQUIRE(reader.good());
+    bool matches = true;
+    for (int32_t i = 0; i < 1000; i++) {
+        int32_t x;
+        double y;
+        reader.read(x);
+        reader.read(y);
+        matches = matches && x == i && y == i * 0.5;
+    }
+    producer.join();
+    REQUIRE(matches);
+
+    uint8_t extra;
+    REQUIRE(reader.var_read(&extra, 1) == 0);
+    REQUIRE_THROWS(reader.read(extra));
+}
+
+TEST_CASE("Ring Buffer Timeout") {
+    SpscRingBuffer<uint8_t> ring(4);
+    RingBufferWriter writer(ring);
+    RingBufferReader reader(ring);
+    writer.set_timeout(std::chrono::milliseconds(20));
+    reader.set_timeout(std::chrono::milliseconds(20));
+
+    // An idle reader sleeps until the timeout instead of spinning
+    uint8_t x[8];
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE(reader.var_read(x, 8) == 0);
+    REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    writer.write(x, 4);
+    REQUIRE_THROWS(writer.write(x, 1));
+
+    // A sleeping reader is woken by the writer
+    reader.set_timeout(std::chrono::milliseconds(-1));
+    REQUIRE(reader.var_read(x, 8) == 4);
+    std::thread producer([&writer] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        writer.write<uint32_t>(7);
+    });
+    uint32_t y;
+    reader.read(y);
+    producer.join();
+    REQUIRE(y == 7);
+}
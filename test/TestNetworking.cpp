@@ -0,0 +1,316 @@
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#include "CppUtils/networking/Datagram.h"
+#include "CppUtils/networking/Resolver.h"
+#include "CppUtils/networking/Socket.h"
+#include "CppUtils/networking/UnixSocket.h"
+#include "CppUtils/io/DeviceHandle.h"
+#include "CppUtils/io/FileHandle.h"
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("Socket Options") {
+    SocketOptions listen_options;
+    listen_options.reuse_address = true;
+    listen_options.receive_buffer = 1 << 16;
+
+    SocketHandle server;
+    server.listen(0, listen_options);
+    REQUIRE(server.local_port() > 0);
+    REQUIRE(*server.options().reuse_address);
+
+    SocketOptions client_options;
+    client_options.no_delay = true;
+    client_options.send_buffer = 1 << 16;
+    client_options.keep_alive = true;
+    client_options.keep_alive_idle = 30;
+    client_options.keep_alive_count = 3;
+
+    Socket client;
+    client.connect("localhost", server.local_port(), client_options);
+
+    SocketOptions accept_options;
+    accept_options.quick_ack = true;
+    accept_options.cork = true;
+    Socket connection;
+    connection.accept(server, accept_options);
+
+    const SocketOptions effective = client.options();
+    REQUIRE(*effective.no_delay);
+    REQUIRE(!*effective.cork);
+    REQUIRE(*effective.send_buffer >= 1 << 16);
+    REQUIRE(*effective.keep_alive);
+    REQUIRE(*effective.keep_alive_idle == 30);
+    REQUIRE(*effective.keep_alive_count == 3);
+
+    // Inherited from the listener
+    REQUIRE(*connection.options().receive_buffer >= 1 << 16);
+    REQUIRE(*connection.options().cork);
+
+    client.write<uint32_t>(7);
+    uint32_t x;
+    connection.read(x);
+    REQUIRE(x == 7);
+
+    SocketOptions uncork;
+    uncork.cork = false;
+    connection.set_options(uncork);
+    connection.write<uint32_t>(8);
+    client.read(x);
+    REQUIRE(x == 8);
+
+    SocketOptions invalid;
+    invalid.keep_alive_idle = -1;
+    REQUIRE_THROWS_AS(client.set_options(invalid), std::runtime_error);
+}
+
+TEST_CASE("Datagram Batches") {
+    DatagramOptions options;
+    options.timestamps = true;
+    DatagramHandle server;
+    server.bind(0, options);
+
+    DatagramWriter client;
+    client.connect("localhost", server.local_port());
+
+    DatagramBatch outgoing(16, 64);
+    for (uint32_t i = 0; i < 10; i++) {
+        REQUIRE(outgoing.add(reinterpret_cast<const uint8_t*>(&i), sizeof(i)));
+    }
+    client.send(outgoing);
+    REQUIRE(outgoing.empty());
+
+    DatagramBatch incoming(32, 64);
+    REQUIRE(server.receive(incoming) == 10);
+    for (uint32_t i = 0; i < 10; i++) {
+        const Datagram datagram = incoming[i];
+        REQUIRE(datagram.data.size() == sizeof(uint32_t));
+        uint32_t x;
+        std::memcpy(&x, datagram.data.data(), sizeof(x));
+        REQUIRE(x == i);
+        REQUIRE(datagram.timestamp > 0);
+        REQUIRE(datagram.source.port() == client.local_port());
+        REQUIRE(!datagram.truncated);
+    }
+    REQUIRE(server.try_receive(incoming) == 0);
+
+    // The kernel splits one send into datagrams of the segment size
+    std::vector<uint8_t> payload(150);
+    for (size_t i = 0; i < payload.size(); i++) payload[i] = static_cast<uint8_t>(i);
+    client.send_segmented(payload, 64);
+    REQUIRE(server.receive(incoming) == 3);
+    REQUIRE(incoming[2].data.size() == 22);
+    REQUIRE(incoming[2].data[0] == 128);
+
+    client.write(payload.data(), 100);
+    REQUIRE(server.receive(incoming) == 1);
+    REQUIRE(incoming[0].truncated);
+    REQUIRE(incoming[0].data.size() == 64);
+
+    // Handle contract: one datagram per write / read
+    DatagramReader reader;
+    reader.bind(0);
+    DatagramHandle sender;
+    sender.open();
+    const uint64_t value = 99;
+    sender.send_to(reinterpret_cast<const uint8_t*>(&value), sizeof(value),
+                   DatagramHandle::address("127.0.0.1", reader.local_port()));
+    uint64_t received;
+    reader.read(received);
+    REQUIRE(received == value);
+
+    // Dual-stack sockets: IPv6 peers, and IPv4 ones with an IPv4 source
+    sender.send_to(reinterpret_cast<const uint8_t*>(&value), sizeof(value),
+                   DatagramHandle::address("::1", server.local_port()));
+    REQUIRE(server.receive(incoming) == 1);
+    REQUIRE(incoming[0].source.family() == AF_INET6);
+    REQUIRE(incoming[0].source.host() == "::1");
+
+    REQUIRE(outgoing.add(reinterpret_cast<const uint8_t*>(&value), sizeof(value),
+                         DatagramHandle::address("127.0.0.1", server.local_port())));
+    sender.send(outgoing);
+    REQUIRE(server.receive(incoming) == 1);
+    REQUIRE(incoming[0].source.family() == AF_INET);
+    REQUIRE(incoming[0].source.host() == "127.0.0.1");
+    REQUIRE(incoming[0].source.port() == sender.local_port());
+
+    // Several sockets share a port with SO_REUSEPORT
+    DatagramOptions shared;
+    shared.reuse_port = true;
+    DatagramHandle first;
+    first.bind(0, shared);
+    DatagramHandle second;
+    second.bind(first.local_port(), shared);
+    REQUIRE(second.local_port() == first.local_port());
+    DatagramHandle exclusive;
+    REQUIRE_THROWS_AS(exclusive.bind(first.local_port()), std::runtime_error);
+}
+
+TEST_CASE("Unix Sockets") {
+    // Stream pair passing a descriptor: the receiver reads the same open file
+    UnixSocket parent;
+    UnixSocket worker;
+    parent.pair(worker);
+
+    const int memfd = memfd_create("cpputils-test", 0);
+    REQUIRE(memfd >= 0);
+    const uint32_t contents = 0xabcd;
+    REQUIRE(::pwrite(memfd, &contents, sizeof(contents), 0) == sizeof(contents));
+    parent.send_fd(memfd);
+    parent.write<uint32_t>(5);
+    ::close(memfd);
+
+    DeviceReader shared;
+    shared.adopt(worker.receive_fd());
+    uint32_t x;
+    shared.read(x);
+    REQUIRE(x == contents);
+    worker.read(x);
+    REQUIRE(x == 5);
+
+    // Several descriptors along with data
+    int fds[2] = {::dup(0), ::dup(0)};
+    const uint8_t message[3] = {1, 2, 3};
+    parent.send_fds(fds, message);
+    ::close(fds[0]);
+    ::close(fds[1]);
+    int received[1];
+    size_t n_received = 0;
+    uint8_t data[3];
+    REQUIRE_THROWS_AS(worker.receive_fds(received, n_received, data), std::runtime_error);
+    REQUIRE(n_received == 0);
+
+    // Sequenced packets keep message boundaries
+    const std::string path = "@cpputils_test_" + std::to_string(getpid());
+    UnixSocketHandle server;
+    server.listen(path, UnixSocketType::SeqPacket);
+    UnixSocket client;
+    client.connect(path, UnixSocketType::SeqPacket);
+    UnixSocket connection;
+    connection.accept(server);
+    REQUIRE(connection.type() == UnixSocketType::SeqPacket);
+
+    client.write<uint16_t>(1);
+    client.write<uint16_t>(2);
+    uint8_t buffer[16];
+    REQUIRE(connection.var_read(buffer, sizeof(buffer)) == 2);
+    REQUIRE(connection.var_read(buffer, sizeof(buffer)) == 2);
+    client.write<uint64_t>(3);
+    uint32_t y;
+    REQUIRE_THROWS_AS(connection.read(y), std::runtime_error);
+
+    // Filesystem sockets are removed when the listener closes
+    const std::string file = "/tmp/cpputils_test_" + std::to_string(getpid()) + ".sock";
+    UnixSocketHandle file_server;
+    file_server.listen(file);
+    REQUIRE(::access(file.c_str(), F_OK) == 0);
+    file_server.close();
+    REQUIRE(::access(file.c_str(), F_OK) != 0);
+
+    // listen replaces a stale socket, but not a live one or a regular file
+    UnixSocketHandle live;
+    live.listen(file);
+    UnixSocketHandle second;
+    REQUIRE_THROWS_AS(second.listen(file), std::runtime_error);
+    REQUIRE(::access(file.c_str(), F_OK) == 0);
+
+    const int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, file.c_str());
+    live.close();
+    REQUIRE(bind(stale, (struct sockaddr*) &address, sizeof(address)) == 0);
+    ::close(stale);
+    second.listen(file);
+    second.close();
+
+    {
+        FileWriter regular(file, OpenMode::Truncate);
+        regular.write<uint8_t>(1);
+    }
+    REQUIRE_THROWS_AS(second.listen(file), std::runtime_error);
+    REQUIRE(::access(file.c_str(), F_OK) == 0);
+    ::unlink(file.c_str());
+}
+
+TEST_CASE("Resolver") {
+    using namespace std::chrono_literals;
+
+    Resolver resolver(1h);
+    std::vector<SocketAddress> addresses = resolver.resolve("127.0.0.1", 80);
+    REQUIRE(addresses.size() == 1);
+    REQUIRE(addresses[0].family() == AF_INET);
+    REQUIRE(addresses[0].host() == "127.0.0.1");
+    REQUIRE(addresses[0].port() == 80);
+
+    // Cached, with the port of each call
+    addresses = resolver.resolve("127.0.0.1", 81);
+    REQUIRE(addresses[0].port() == 81);
+    REQUIRE(resolver.hits() == 1);
+    REQUIRE(resolver.misses() == 1);
+
+    SocketAddress v6 = resolver.resolve("::1", 443).front();
+    REQUIRE(v6.family() == AF_INET6);
+    REQUIRE(v6.host() == "::1");
+    REQUIRE(v6.port() == 443);
+
+    Resolver expiring(0ms);
+    expiring.resolve("localhost", 80);
+    expiring.resolve("localhost", 80);
+    REQUIRE(expiring.misses() == 2);
+
+    REQUIRE_THROWS_AS(resolver.resolve("no-such-host.invalid", 80), std::runtime_error);
+    REQUIRE_THROWS_AS(resolver.resolve("no-such-host.invalid", 80), std::runtime_error);
+    REQUIRE(resolver.misses() == 4);
+
+    // Bounded lookups run in the background and fill the cache the same way
+    Resolver bounded(1h);
+    addresses = bounded.resolve("localhost", 80, Resolver::Clock::now() + 5s);
+    REQUIRE(!addresses.empty());
+    REQUIRE(addresses[0].port() == 80);
+    bounded.resolve("localhost", 80, Resolver::Clock::now() + 5s);
+    REQUIRE(bounded.hits() == 1);
+    REQUIRE_THROWS_AS(bounded.resolve("no-such-host.invalid", 80, Resolver::Clock::now() + 5s),
+                      std::runtime_error);
+}
+
+TEST_CASE("Socket Connect") {
+    using namespace std::chrono_literals;
+
+    SocketHandle server;
+    server.listen(0);
+    const int port = server.local_port();
+
+    // Dual-stack listener, reachable over both families when IPv6 is up
+    Socket client;
+    client.connect("localhost", port, 2000ms);
+    Socket connection;
+    connection.accept(server);
+    client.write<uint32_t>(11);
+    uint32_t x;
+    connection.read(x);
+    REQUIRE(x == 11);
+
+    Socket v4;
+    v4.connect("127.0.0.1", port, 2000ms);
+    SocketHandle v4_connection;
+    v4_connection.accept(server);
+
+    // Nothing listens on the port once the server is gone
+    server.close();
+    Socket refused;
+    REQUIRE_THROWS_AS(refused.connect("127.0.0.1", port, 2000ms), std::runtime_error);
+    REQUIRE(!refused.good());
+}